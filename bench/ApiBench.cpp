@@ -0,0 +1,81 @@
+/**
+ * @file ApiBench.cpp
+ * @brief API Request Benchmark
+ *
+ * Runs SpotifyClient requests against the local stub, which answers with
+ * the recorded payloads, and reports per request type:
+ * - time of the whole call (request, streamed parse, state update)
+ * - heap allocations made during the call
+ * - peak heap above what was allocated before the call
+ * - heap still held after all calls (what the calls leave behind)
+ *
+ * Needs the stub:
+ *
+ *     python3 tools/spotify-stub/spotify_stub.py --port 8443
+ */
+
+#include "Bench.hpp"
+#include "native_heap.h"
+#include "spotify/SpotifyClient.hpp"
+
+#define API_BENCH_CALLS 20
+
+/**
+ * @brief Run one request type and print its line
+ * @return false if the call failed
+ */
+static bool measure(const char* name, const std::function<bool()>& call) {
+    // The first call pays for the handshake and static filters
+    if (!call()) {
+        Serial.printf("❌ %s failed\n", name);
+        return false;
+    }
+
+    std::vector<unsigned long> times;
+    std::vector<unsigned long> allocs;
+    times.reserve(API_BENCH_CALLS);
+    allocs.reserve(API_BENCH_CALLS);
+    size_t peak = 0;
+    size_t liveBefore = native_heap_live_bytes();
+
+    for (int i = 0; i < API_BENCH_CALLS; i++) {
+        native_heap_reset_peak();
+        size_t base = native_heap_live_bytes();
+        uint64_t allocsAtStart = native_heap_alloc_count();
+        unsigned long start = micros();
+
+        call();
+
+        times.push_back(micros() - start);
+        allocs.push_back(static_cast<unsigned long>(native_heap_alloc_count() - allocsAtStart));
+        peak = max(peak, native_heap_peak_bytes() - base);
+    }
+
+    long retained = static_cast<long>(native_heap_live_bytes()) - static_cast<long>(liveBefore);
+    BenchStats time = summarize(times);
+    BenchStats alloc = summarize(allocs);
+
+    Serial.printf("%-22s %7.2f ms  %4lu allocs  peak %6.1f KB  retained %5ld B\n",
+                  name, time.median / 1000.0, alloc.median, peak / 1024.0, retained);
+    return true;
+}
+
+void runApiBench() {
+    SpotifyClient client(nullptr);
+    client.setTokens("bench", "bench", 3600000);
+
+    if (!client.updateNowPlaying()) {
+        Serial.println("   Skipped, is the stub running on " SPOTIFY_API_BASE "?");
+        return;
+    }
+
+    Serial.printf("%d calls each, medians\n", API_BENCH_CALLS);
+
+    SpotifyClient::PlaylistPage page;
+    measure("GET /me/player", [&]() { return client.updateNowPlaying(); });
+    measure("GET /me/player/queue", [&]() { return client.updateQueue(); });
+    measure("GET /me/playlists", [&]() { return client.getPlaylists(page); });
+    measure("GET /search", [&]() { return client.search("love", 10).tracks.size() > 0; });
+    measure("PUT /me/player/pause", [&]() { return client.pause(); });
+    measure("PUT /me/player/volume", [&]() { return client.setVolume(40); });
+}
@@ -0,0 +1,166 @@
+/**
+ * @file ArtBench.cpp
+ * @brief Album Art Benchmark
+ *
+ * Loads a fixed 640x640 cover through AlbumArtLoader, the way Now Playing
+ * does, served once from FakeTransport (no network) and once by the local
+ * stub's image route (TLS on localhost). Reports per source:
+ * - download and decode into the 220 px cover and 64 px thumbnail, with
+ *   the heap allocations and peak heap of the whole load
+ * - the same cover read back from the flash cache
+ * - the same cover found decoded in PSRAM
+ *
+ * The stub part needs:
+ *
+ *     python3 tools/spotify-stub/spotify_stub.py --port 8443
+ */
+
+#include "Bench.hpp"
+#include "native_heap.h"
+#include "network/FakeTransport.hpp"
+#include "network/RequestQueue.hpp"
+#include "spotify/AlbumArtLoader.hpp"
+#include "spotify/CoverCache.hpp"
+
+// Stays within the flash and PSRAM cache budgets, so every cover is a hit
+#define ART_BENCH_RUNS 8
+
+#define ART_BENCH_FIXTURE "tools/spotify-stub/fixtures/images/cover-640.jpg"
+#define ART_BENCH_IMAGE_PATH "/image/cover-640.jpg"
+
+/**
+ * @brief Run completions until the worker has nothing left to do
+ */
+static void waitIdle() {
+    auto& queue = RequestQueue::getInstance();
+    while (queue.getPending() > 0) {
+        queue.update();
+        delay(1);
+    }
+    queue.update();
+}
+
+/**
+ * @brief Load a cover and wait for it
+ * @return Time until the loaded handler ran (us), 0 if the load failed
+ */
+static unsigned long loadCover(AlbumArtLoader& loader, const SpotifyId& albumId, const char* url) {
+    bool loaded = false;
+    loader.setLoadedHandler([&loaded](const char*, const std::shared_ptr<CoverImage>& image) {
+        loaded = image && image->isValid();
+    });
+
+    auto& queue = RequestQueue::getInstance();
+    unsigned long start = micros();
+
+    loader.load(albumId, url);
+    while (!loaded && loader.isLoading()) {
+        queue.update();
+    }
+
+    unsigned long elapsed = micros() - start;
+    loader.setLoadedHandler(nullptr);
+    return loaded ? max(elapsed, 1UL) : 0;
+}
+
+/**
+ * @brief Measure one source and print its lines
+ * @return false if the source doesn't answer
+ */
+static bool measureSource(const char* name, SpotifyClient& client, const char* url) {
+    // The first download pays for the handshake
+    if (!client.downloadImage(url, ALBUM_ART_PATH, nullptr)) {
+        return false;
+    }
+
+    std::vector<SpotifyId> albumIds(ART_BENCH_RUNS);
+    for (int i = 0; i < ART_BENCH_RUNS; i++) {
+        char id[SPOTIFY_ID_LENGTH + 1];
+        snprintf(id, sizeof(id), "bench%s%02d", name, i);
+        albumIds[i] = id;
+    }
+
+    // Every cold load has to download
+    CoverCache().clear();
+
+    std::vector<unsigned long> cold;
+    std::vector<unsigned long> decode;
+    std::vector<unsigned long> allocs;
+    std::vector<unsigned long> flash;
+    std::vector<unsigned long> psram;
+    size_t peak = 0;
+
+    AlbumArtLoader loader(&client);
+    for (const SpotifyId& albumId : albumIds) {
+        native_heap_reset_peak();
+        size_t base = native_heap_live_bytes();
+        uint64_t allocsAtStart = native_heap_alloc_count();
+
+        unsigned long us = loadCover(loader, albumId, url);
+        if (us == 0) {
+            Serial.printf("❌ %s: load failed\n", name);
+            return true;
+        }
+
+        cold.push_back(us);
+        decode.push_back(loader.getStats().lastDecodeMs);
+        allocs.push_back(static_cast<unsigned long>(native_heap_alloc_count() - allocsAtStart));
+        peak = max(peak, native_heap_peak_bytes() - base);
+
+        // Let the flash write finish before the next load
+        waitIdle();
+    }
+
+    // A new loader starts with nothing in PSRAM
+    {
+        AlbumArtLoader fresh(&client);
+        for (const SpotifyId& albumId : albumIds) {
+            flash.push_back(loadCover(fresh, albumId, url));
+        }
+        waitIdle();
+    }
+
+    for (const SpotifyId& albumId : albumIds) {
+        psram.push_back(loadCover(loader, albumId, url));
+    }
+
+    BenchStats coldStats = summarize(cold);
+    BenchStats decodeStats = summarize(decode);
+    BenchStats allocStats = summarize(allocs);
+    BenchStats flashStats = summarize(flash);
+    BenchStats psramStats = summarize(psram);
+
+    Serial.printf("%-5s download+decode %7.2f ms  (decode %lu ms)  %4lu allocs  peak %6.1f KB\n",
+                  name, coldStats.median / 1000.0, decodeStats.median, allocStats.median,
+                  peak / 1024.0);
+    Serial.printf("%-5s flash hit       %7.2f ms\n", name, flashStats.median / 1000.0);
+    Serial.printf("%-5s PSRAM hit       %7.3f ms\n", name, psramStats.median / 1000.0);
+    return true;
+}
+
+void runArtBench() {
+    std::vector<uint8_t> jpeg;
+    if (!readFixture(ART_BENCH_FIXTURE, jpeg)) {
+        return;
+    }
+
+    RequestQueue::getInstance().begin();
+
+    Serial.printf("%d covers each (%u byte JPEG, %d px), medians\n", ART_BENCH_RUNS,
+                  static_cast<unsigned>(jpeg.size()), ALBUM_ART_SIZE);
+
+    FakeTransport fake;
+    fake.on("GET", ART_BENCH_IMAGE_PATH, 200, jpeg.data(), jpeg.size());
+    SpotifyClient fakeClient(nullptr, &fake);
+    measureSource("fake", fakeClient, "https://i.scdn.co" ART_BENCH_IMAGE_PATH);
+
+    // The stub serves the same file next to its API
+    String stubUrl = SPOTIFY_API_BASE;
+    stubUrl.remove(stubUrl.lastIndexOf('/'));
+    stubUrl += ART_BENCH_IMAGE_PATH;
+
+    SpotifyClient stubClient(nullptr);
+    if (!measureSource("stub", stubClient, stubUrl.c_str())) {
+        Serial.println("   Skipped, is the stub running on " SPOTIFY_API_BASE "?");
+    }
+}
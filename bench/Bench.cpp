@@ -0,0 +1,48 @@
+/**
+ * @file Bench.cpp
+ * @brief Native Benchmark Helpers Implementation
+ */
+
+#include "Bench.hpp"
+#include <algorithm>
+#include <stdio.h>
+
+BenchStats summarize(std::vector<unsigned long>& samples) {
+    BenchStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    stats.min = samples.front();
+    stats.median = samples[samples.size() / 2];
+    stats.max = samples.back();
+    return stats;
+}
+
+bool readFixture(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        Serial.printf("❌ Fixture %s not found (run from the project directory)\n", path);
+        return false;
+    }
+
+    data.clear();
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+    fclose(file);
+    return true;
+}
+
+String hostOf(const char* url) {
+    const char* start = strstr(url, "://");
+    start = start ? start + 3 : url;
+
+    size_t length = strcspn(start, ":/?");
+    String host;
+    host.concat(start, length);
+    return host;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file Bench.hpp
+ * @brief Native Benchmark Helpers
+ *
+ * Shared by the benchmarks of the native_bench environment (see main.cpp).
+ * Fixtures are read from the host file system, relative to the project
+ * directory the program is started in.
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * @brief Summary of repeated measurements
+ */
+struct BenchStats {
+    unsigned long min;
+    unsigned long median;
+    unsigned long max;
+
+    BenchStats()
+        : min(0)
+        , median(0)
+        , max(0) {
+    }
+};
+
+/**
+ * @brief Summarize samples (sorts them)
+ */
+BenchStats summarize(std::vector<unsigned long>& samples);
+
+/**
+ * @brief Read a fixture file
+ * @return false if it doesn't exist
+ */
+bool readFixture(const char* path, std::vector<uint8_t>& data);
+
+/**
+ * @brief Get the host part of a URL, e.g. for ConnectionPool::getStats()
+ */
+String hostOf(const char* url);
+
+// Benchmarks, one per file
+void runPoolBench();
+void runApiBench();
+void runTrackBench();
+void runArtBench();
+
+#endif // BENCH_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file PoolBench.cpp
+ * @brief Keep-Alive Connection Benchmark
+ *
+ * Sends the same API request through HttpsTransport to the local stub,
+ * once with a new TLS connection for every request and once over the
+ * kept-alive connection of the pool. Needs the stub:
+ *
+ *     python3 tools/spotify-stub/spotify_stub.py --port 8443
+ */
+
+#include "Bench.hpp"
+#include "network/ConnectionPool.hpp"
+#include "network/HttpsTransport.hpp"
+#include "spotify/SpotifyClient.hpp"
+
+#define POOL_BENCH_REQUESTS 20
+
+static const char* POOL_BENCH_URL = SPOTIFY_API_BASE "/me/player/devices";
+
+/**
+ * @brief Send the request repeatedly
+ * @param reconnect Close the connection before every request
+ * @return false if a request failed
+ */
+static bool sendRequests(bool reconnect, std::vector<unsigned long>& samples) {
+    auto& pool = ConnectionPool::getInstance();
+    auto& transport = HttpsTransport::getInstance();
+
+    HttpRequest request("GET", POOL_BENCH_URL);
+    request.authorization = "Bearer bench";
+
+    samples.clear();
+    for (int i = 0; i < POOL_BENCH_REQUESTS; i++) {
+        if (reconnect) {
+            pool.closeAll();
+        }
+
+        unsigned long start = micros();
+        int code = transport.send(request, nullptr);
+        samples.push_back(micros() - start);
+
+        if (code != 200) {
+            Serial.printf("❌ %s: %d\n", POOL_BENCH_URL, code);
+            return false;
+        }
+    }
+    return true;
+}
+
+void runPoolBench() {
+    auto& pool = ConnectionPool::getInstance();
+    String host = hostOf(POOL_BENCH_URL);
+    std::vector<unsigned long> samples;
+
+    pool.closeAll();
+    if (!sendRequests(false, samples)) {
+        Serial.println("   Skipped, is the stub running on " SPOTIFY_API_BASE "?");
+        return;
+    }
+
+    const char* names[] = {"new connection", "kept alive"};
+    for (int reconnect = 1; reconnect >= 0; reconnect--) {
+        ConnectionPool::HostStats before = pool.getStats(host);
+        pool.closeAll();
+        sendRequests(reconnect, samples);
+        ConnectionPool::HostStats after = pool.getStats(host);
+
+        uint32_t handshakes = after.handshakes - before.handshakes;
+        unsigned long handshakeUs = after.handshakeUsTotal - before.handshakeUsTotal;
+        BenchStats stats = summarize(samples);
+
+        Serial.printf("%-15s %2d requests, %2u handshakes (avg %5.1f ms), "
+                      "per request: median %6.2f ms, min %6.2f ms, max %6.2f ms\n",
+                      names[1 - reconnect], POOL_BENCH_REQUESTS, (unsigned)handshakes,
+                      handshakes ? handshakeUs / 1000.0 / handshakes : 0.0,
+                      stats.median / 1000.0, stats.min / 1000.0, stats.max / 1000.0);
+    }
+}
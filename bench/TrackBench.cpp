@@ -0,0 +1,98 @@
+/**
+ * @file TrackBench.cpp
+ * @brief Track Info Copy Benchmark
+ *
+ * getCurrentTrack() returns a TrackInfo by value and the now playing
+ * screen takes a copy on every loop. Compares copying it with copying the
+ * same fields held in Arduino Strings, as TrackInfo did before FixedString:
+ * - time per copy
+ * - heap allocations per copy
+ *
+ * Doesn't need the stub.
+ */
+
+#include "Bench.hpp"
+#include "native_heap.h"
+#include "spotify/SpotifyClient.hpp"
+
+#define TRACK_BENCH_COPIES 100000
+
+/**
+ * @brief TrackInfo with String fields, for comparison
+ */
+struct StringTrackInfo {
+    String id;
+    String uri;
+    String title;
+    String artist;
+    String album;
+    String albumId;
+    String coverUrl;
+    String coverUrlSmall;
+    String coverUrlLarge;
+    bool isPlaying;
+    int progressMs;
+    int durationMs;
+    int volumePercent;
+    bool saved;
+    bool explicitContent;
+};
+
+/**
+ * @brief Copy a track repeatedly and print its line
+ */
+template <typename T>
+static void measure(const char* name, const T& track) {
+    uint64_t allocsAtStart = native_heap_alloc_count();
+    unsigned long start = micros();
+
+    for (int i = 0; i < TRACK_BENCH_COPIES; i++) {
+        T copy = track;
+        // Keeps the copy from being optimized away
+        asm volatile("" : : "r"(&copy) : "memory");
+    }
+
+    unsigned long elapsed = micros() - start;
+    uint64_t allocs = native_heap_alloc_count() - allocsAtStart;
+
+    Serial.printf("%-12s %5zu B  %6.3f us/copy  %5.2f allocs/copy\n", name, sizeof(T),
+                  (double)elapsed / TRACK_BENCH_COPIES, (double)allocs / TRACK_BENCH_COPIES);
+}
+
+void runTrackBench() {
+    const char* id = "4uLU6hMCjMI75M1A2tKUQC";
+    const char* albumId = "6N9PS4QXF1D0OWPk0Sxtb4";
+    const char* cover = "https://i.scdn.co/image/ab67616d0000b2734ce8b4e42588bf18182a1ad2";
+
+    SpotifyClient::TrackInfo fixed;
+    fixed.id.assign(id);
+    fixed.uri.assign("spotify:track:4uLU6hMCjMI75M1A2tKUQC");
+    fixed.title.assign("Never Gonna Give You Up");
+    fixed.artist.assign("Rick Astley");
+    fixed.album.assign("Whenever You Need Somebody");
+    fixed.albumId.assign(albumId);
+    fixed.coverUrl.assign(cover);
+    fixed.coverUrlSmall.assign(cover);
+    fixed.coverUrlLarge.assign(cover);
+
+    StringTrackInfo strings;
+    strings.id = id;
+    strings.uri = fixed.uri.c_str();
+    strings.title = fixed.title.c_str();
+    strings.artist = fixed.artist.c_str();
+    strings.album = fixed.album.c_str();
+    strings.albumId = albumId;
+    strings.coverUrl = cover;
+    strings.coverUrlSmall = cover;
+    strings.coverUrlLarge = cover;
+    strings.isPlaying = true;
+    strings.progressMs = 0;
+    strings.durationMs = 213573;
+    strings.volumePercent = 50;
+    strings.saved = false;
+    strings.explicitContent = false;
+
+    Serial.printf("%d copies each\n", TRACK_BENCH_COPIES);
+    measure("String", strings);
+    measure("FixedString", fixed);
+}
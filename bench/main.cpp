@@ -0,0 +1,65 @@
+/**
+ * @file main.cpp
+ * @brief Native Benchmarks - Entry Point
+ *
+ * Built by the native_bench environment in place of src/main.cpp. Runs
+ * every benchmark, or only those listed in BENCH (comma separated):
+ *
+ *     pio run -e native_bench
+ *     BENCH=pool .pio/build/native_bench/program
+ *
+ * Benchmarks that need the local Spotify stub (tools/spotify-stub) say
+ * so and are skipped when it isn't running.
+ */
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "Bench.hpp"
+
+static const struct {
+    const char* name;
+    void (*run)();
+} BENCHES[] = {
+    {"pool", runPoolBench},
+    {"api", runApiBench},
+    {"track", runTrackBench},
+    {"art", runArtBench},
+};
+
+static bool isSelected(const char* name) {
+    const char* selected = getenv("BENCH");
+    if (!selected || !*selected) {
+        return true;
+    }
+
+    size_t length = strlen(name);
+    for (const char* p = selected; *p;) {
+        size_t tokenLength = strcspn(p, ",");
+        if (tokenLength == length && strncmp(p, name, length) == 0) {
+            return true;
+        }
+        p += tokenLength;
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return false;
+}
+
+void setup() {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    LittleFS.begin(true);
+
+    for (const auto& bench : BENCHES) {
+        if (isSelected(bench.name)) {
+            Serial.printf("\n=== %s ===\n", bench.name);
+            bench.run();
+        }
+    }
+
+    Serial.flush();
+    exit(0);
+}
+
+void loop() {
+}
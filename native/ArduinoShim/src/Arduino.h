@@ -0,0 +1,76 @@
+/**
+ * @file Arduino.h
+ * @brief Arduino Core Shim for the Native (Linux host) Build
+ *
+ * Provides the subset of the Arduino/ESP32 core API used by the
+ * firmware so the src/ tree compiles and runs on a Linux host.
+ * Only built for `[env:native]` (see library.json).
+ */
+
+#ifndef ARDUINO_SHIM_H
+#define ARDUINO_SHIM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "IPAddress.h"
+#include "esp_heap_caps.h"
+#include "Esp.h"
+
+// Digital I/O
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#ifndef LED_BUILTIN
+#define LED_BUILTIN 2
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::min;
+using std::max;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Timing (monotonic, relative to process start)
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Random numbers
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// GPIO (no-ops on the host)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// Sketch entry points, called by the shim's main()
+void setup();
+void loop();
+
+#endif // ARDUINO_SHIM_H
@@ -0,0 +1,40 @@
+/**
+ * @file Esp.cpp
+ * @brief ESP System Shim Implementation
+ */
+
+#include "Esp.h"
+#include "native_heap.h"
+#include "HardwareSerial.h"
+
+#include <cstdlib>
+
+EspClass ESP;
+
+uint32_t EspClass::getHeapSize() {
+    return NATIVE_HEAP_SIZE;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    size_t live = native_heap_live_bytes();
+    return live >= NATIVE_HEAP_SIZE ? 0 : NATIVE_HEAP_SIZE - static_cast<uint32_t>(live);
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    size_t peak = native_heap_peak_bytes();
+    return peak >= NATIVE_HEAP_SIZE ? 0 : NATIVE_HEAP_SIZE - static_cast<uint32_t>(peak);
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return getFreeHeap();
+}
+
+uint64_t EspClass::getEfuseMac() {
+    return 0x0000DEADBEEF0000ULL;
+}
+
+void EspClass::restart() {
+    Serial.println("🔄 ESP.restart() called on native build, exiting");
+    Serial.flush();
+    exit(1);
+}
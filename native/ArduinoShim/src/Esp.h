@@ -0,0 +1,43 @@
+/**
+ * @file Esp.h
+ * @brief ESP System Shim
+ *
+ * Heap figures are derived from the host heap accounting against a
+ * nominal ESP32 internal heap size, so "free heap" trends match the board.
+ */
+
+#ifndef ESP_SHIM_H
+#define ESP_SHIM_H
+
+#include <cstdint>
+#include <cstddef>
+
+#ifndef NATIVE_HEAP_SIZE
+#define NATIVE_HEAP_SIZE (320U * 1024U)
+#endif
+
+#ifndef NATIVE_PSRAM_SIZE
+#define NATIVE_PSRAM_SIZE (8U * 1024U * 1024U)
+#endif
+
+class EspClass {
+public:
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+
+    uint32_t getPsramSize() { return NATIVE_PSRAM_SIZE; }
+    uint32_t getFreePsram() { return NATIVE_PSRAM_SIZE; }
+
+    const char* getChipModel() { return "native"; }
+    const char* getSdkVersion() { return "native"; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint64_t getEfuseMac();
+
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+#endif // ESP_SHIM_H
@@ -0,0 +1,328 @@
+/**
+ * @file FS.cpp
+ * @brief Arduino Filesystem Shim Implementation
+ */
+
+#include "FS.h"
+#include "LittleFS.h"
+
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs {
+
+/**
+ * @brief Backing state for File: either a stdio stream or a directory
+ */
+class FileImpl {
+public:
+    FileImpl(const String& hostPath, const String& fsPath, FILE* fp)
+        : hostPath(hostPath), fsPath(fsPath), fp(fp), dir(nullptr) {
+        nameStart = fsPath.lastIndexOf('/') + 1;
+    }
+
+    FileImpl(const String& hostPath, const String& fsPath, DIR* dir)
+        : hostPath(hostPath), fsPath(fsPath), fp(nullptr), dir(dir) {
+        nameStart = fsPath.lastIndexOf('/') + 1;
+    }
+
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (fp) {
+            fclose(fp);
+            fp = nullptr;
+        }
+        if (dir) {
+            closedir(dir);
+            dir = nullptr;
+        }
+    }
+
+    String hostPath;
+    String fsPath;
+    FILE* fp;
+    DIR* dir;
+    int nameStart;
+};
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) {
+        return 0;
+    }
+    return fwrite(buf, 1, size, impl->fp);
+}
+
+int File::available() {
+    if (!impl || !impl->fp) {
+        return 0;
+    }
+    return static_cast<int>(size() - position());
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) {
+        return 0;
+    }
+    return fread(buf, 1, size, impl->fp);
+}
+
+int File::peek() {
+    if (!impl || !impl->fp) {
+        return -1;
+    }
+    int c = fgetc(impl->fp);
+    if (c != EOF) {
+        ungetc(c, impl->fp);
+    }
+    return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+    if (impl && impl->fp) {
+        fflush(impl->fp);
+    }
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!impl || !impl->fp) {
+        return false;
+    }
+    int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(impl->fp, pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!impl || !impl->fp) {
+        return 0;
+    }
+    long pos = ftell(impl->fp);
+    return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+size_t File::size() const {
+    if (!impl) {
+        return 0;
+    }
+    if (impl->fp) {
+        fflush(impl->fp);
+    }
+    struct stat st;
+    return stat(impl->hostPath.c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+void File::close() {
+    if (impl) {
+        impl->close();
+        impl.reset();
+    }
+}
+
+File::operator bool() const {
+    return impl && (impl->fp || impl->dir);
+}
+
+const char* File::path() const {
+    return impl ? impl->fsPath.c_str() : nullptr;
+}
+
+const char* File::name() const {
+    return impl ? impl->fsPath.c_str() + impl->nameStart : nullptr;
+}
+
+time_t File::getLastWrite() {
+    struct stat st;
+    if (!impl || stat(impl->hostPath.c_str(), &st) != 0) {
+        return 0;
+    }
+    return st.st_mtime;
+}
+
+bool File::isDirectory() const {
+    return impl && impl->dir;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!impl || !impl->dir) {
+        return File();
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(impl->dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        String childFs = impl->fsPath;
+        if (!childFs.endsWith("/")) {
+            childFs += "/";
+        }
+        childFs += entry->d_name;
+        String childHost = impl->hostPath + "/" + entry->d_name;
+
+        struct stat st;
+        if (stat(childHost.c_str(), &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            DIR* dir = opendir(childHost.c_str());
+            return dir ? File(std::make_shared<FileImpl>(childHost, childFs, dir)) : File();
+        }
+        FILE* fp = fopen(childHost.c_str(), strcmp(mode, FILE_READ) == 0 ? "rb" : mode);
+        return fp ? File(std::make_shared<FileImpl>(childHost, childFs, fp)) : File();
+    }
+
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (impl && impl->dir) {
+        rewinddir(impl->dir);
+    }
+}
+
+FS::FS(const char* defaultRoot)
+    : root(defaultRoot)
+    , mounted(false) {
+}
+
+String FS::hostPath(const char* path) const {
+    String result = root;
+    if (path && path[0] != '/') {
+        result += "/";
+    }
+    result += path ? path : "";
+    if (result.endsWith("/") && result.length() > root.length() + 1) {
+        result.remove(result.length() - 1);
+    }
+    return result;
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+    if (!mounted || !path) {
+        return File();
+    }
+
+    String host = hostPath(path);
+    struct stat st;
+    bool exists = stat(host.c_str(), &st) == 0;
+
+    if (exists && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(host.c_str());
+        return dir ? File(std::make_shared<FileImpl>(host, String(path), dir)) : File();
+    }
+
+    bool reading = strcmp(mode, FILE_READ) == 0;
+    if (reading && !exists) {
+        return File();
+    }
+
+    if (!reading && create) {
+        // Create parent directories like LittleFS does for open(path, "w", true)
+        String parent = host.substring(0, host.lastIndexOf('/'));
+        for (unsigned int i = root.length() + 1; i <= parent.length(); i++) {
+            if (i == parent.length() || parent[i] == '/') {
+                ::mkdir(parent.substring(0, i).c_str(), 0755);
+            }
+        }
+    }
+
+    String stdioMode = String(mode) + "b";
+    FILE* fp = fopen(host.c_str(), stdioMode.c_str());
+    return fp ? File(std::make_shared<FileImpl>(host, String(path), fp)) : File();
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return mounted && stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    return mounted && unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    return mounted && ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    return mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+bool FS::rmdir(const char* path) {
+    return mounted && ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+LittleFSFS::LittleFSFS()
+    : FS(NATIVE_LITTLEFS_ROOT) {
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                       const char* partitionLabel) {
+    (void)formatOnFail;
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+
+    const char* envRoot = getenv("LITTLEFS_ROOT");
+    if (envRoot && envRoot[0]) {
+        root = envRoot;
+    }
+
+    // mkdir -p root
+    for (unsigned int i = 1; i <= root.length(); i++) {
+        if (i == root.length() || root[i] == '/') {
+            ::mkdir(root.substring(0, i).c_str(), 0755);
+        }
+    }
+
+    struct stat st;
+    mounted = stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    return mounted;
+}
+
+bool LittleFSFS::format() {
+    if (!mounted) {
+        return false;
+    }
+    String cmd = "rm -rf '" + root + "'/*";
+    return system(cmd.c_str()) == 0;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t total = 0;
+    File dir = open("/");
+    std::vector<File> stack;
+    stack.push_back(dir);
+
+    while (!stack.empty()) {
+        File current = stack.back();
+        stack.pop_back();
+        File entry = current.openNextFile();
+        while (entry) {
+            if (entry.isDirectory()) {
+                stack.push_back(entry);
+            } else {
+                total += entry.size();
+            }
+            entry = current.openNextFile();
+        }
+    }
+
+    return total;
+}
+
+} // namespace fs
+
+fs::LittleFSFS LittleFS;
@@ -0,0 +1,105 @@
+/**
+ * @file FS.h
+ * @brief Arduino Filesystem Shim (host directory backed)
+ */
+
+#ifndef FS_SHIM_H
+#define FS_SHIM_H
+
+#include <cstdio>
+#include <memory>
+#include "Arduino.h"
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+namespace fs {
+
+class FileImpl;
+typedef std::shared_ptr<FileImpl> FileImplPtr;
+
+/**
+ * @brief Open file or directory handle
+ */
+class File : public Stream {
+public:
+    File(FileImplPtr p = FileImplPtr()) : impl(p) {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    size_t read(uint8_t* buf, size_t size);
+    size_t readBytes(char* buffer, size_t length) override {
+        return read(reinterpret_cast<uint8_t*>(buffer), length);
+    }
+    int peek() override;
+    void flush() override;
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    explicit operator bool() const;
+
+    const char* path() const;
+    const char* name() const;
+    time_t getLastWrite();
+
+    bool isDirectory() const;
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    FileImplPtr impl;
+};
+
+/**
+ * @brief Filesystem rooted at a directory on the host
+ */
+class FS {
+public:
+    explicit FS(const char* defaultRoot);
+
+    File open(const char* path, const char* mode = FILE_READ, const bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, const bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo);
+    bool rename(const String& pathFrom, const String& pathTo) {
+        return rename(pathFrom.c_str(), pathTo.c_str());
+    }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path);
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+protected:
+    /**
+     * @brief Map a filesystem path onto the host directory
+     */
+    String hostPath(const char* path) const;
+
+    String root;
+    bool mounted;
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif // FS_SHIM_H
@@ -0,0 +1,546 @@
+/**
+ * @file HTTPClient.cpp
+ * @brief HTTP/1.1 Client Shim Implementation
+ */
+
+#include "HTTPClient.h"
+
+#include <strings.h>
+
+#define HTTP_TCP_BUFFER_SIZE 1460
+
+namespace {
+
+/**
+ * @brief Write-only stream collecting into a String (StreamString stand-in)
+ */
+class StringSink : public Stream {
+public:
+    explicit StringSink(String& target) : target(target) {}
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    size_t write(uint8_t c) override {
+        target += static_cast<char>(c);
+        return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        target.concat(reinterpret_cast<const char*>(buffer), size);
+        return size;
+    }
+
+private:
+    String& target;
+};
+
+} // namespace
+
+HTTPClient::HTTPClient()
+    : _client(nullptr)
+    , _port(0)
+    , _secure(false)
+    , _tcpTimeout(HTTPCLIENT_DEFAULT_TCP_TIMEOUT)
+    , _connectTimeout(-1)
+    , _reuse(true)
+    , _canReuse(false)
+    , _useHTTP10(false)
+    , _userAgent("ESP32HTTPClient")
+    , _returnCode(0)
+    , _size(-1)
+    , _transferEncoding(HTTPC_TE_IDENTITY) {
+}
+
+HTTPClient::~HTTPClient() {
+    if (_client) {
+        _client->stop();
+    }
+}
+
+void HTTPClient::clear() {
+    _returnCode = 0;
+    _size = -1;
+    _headers = "";
+    _location = "";
+    _transferEncoding = HTTPC_TE_IDENTITY;
+    for (auto& header : _currentHeaders) {
+        header.value = "";
+    }
+}
+
+bool HTTPClient::begin(WiFiClient& client, String url) {
+    if (_client && _client != &client) {
+        disconnect(false);
+    }
+    _client = &client;
+    return beginInternal(url);
+}
+
+bool HTTPClient::begin(WiFiClient& client, String host, uint16_t port, String uri, bool https) {
+    if (_client && _client != &client) {
+        disconnect(false);
+    }
+    _client = &client;
+    clear();
+    _host = host;
+    _port = port;
+    _uri = uri;
+    _secure = https;
+    _protocol = https ? "https" : "http";
+    return true;
+}
+
+bool HTTPClient::beginInternal(String url) {
+    clear();
+
+    int index = url.indexOf(':');
+    if (index < 0) {
+        return false;
+    }
+
+    String protocol = url.substring(0, index);
+    url.remove(0, index + 3);  // remove "://"
+
+    uint16_t port;
+    if (protocol == "http") {
+        port = 80;
+    } else if (protocol == "https") {
+        port = 443;
+    } else {
+        return false;
+    }
+
+    index = url.indexOf('/');
+    String host = index < 0 ? url : url.substring(0, index);
+    _uri = index < 0 ? String("/") : url.substring(index);
+
+    index = host.indexOf(':');
+    if (index >= 0) {
+        port = static_cast<uint16_t>(host.substring(index + 1).toInt());
+        host = host.substring(0, index);
+    }
+
+    _protocol = protocol;
+    _secure = protocol == "https";
+    _host = host;
+    _port = port;
+    return true;
+}
+
+void HTTPClient::end() {
+    disconnect(false);
+    clear();
+}
+
+void HTTPClient::disconnect(bool preserveClient) {
+    if (_client && connected()) {
+        while (_client->available() > 0) {
+            _client->read();
+        }
+        if (!(_reuse && _canReuse)) {
+            _client->stop();
+        }
+    }
+    if (!preserveClient && !(_reuse && _canReuse)) {
+        _client = nullptr;
+    }
+}
+
+bool HTTPClient::connected() {
+    return _client && (_client->available() > 0 || _client->connected());
+}
+
+void HTTPClient::useHTTP10(bool usehttp10) {
+    _useHTTP10 = usehttp10;
+    _reuse = !usehttp10;
+}
+
+bool HTTPClient::connect() {
+    if (!_client) {
+        return false;
+    }
+
+    if (connected()) {
+        // Reusing a keep-alive connection: drop anything left over
+        while (_client->available() > 0) {
+            _client->read();
+        }
+        return true;
+    }
+
+    if (!_client->connect(_host.c_str(), _port, _connectTimeout > 0 ? _connectTimeout : 5000)) {
+        return false;
+    }
+
+    _client->setTimeout(_tcpTimeout);
+    return connected();
+}
+
+int HTTPClient::GET() {
+    return sendRequest("GET");
+}
+
+int HTTPClient::POST(uint8_t* payload, size_t size) {
+    return sendRequest("POST", payload, size);
+}
+
+int HTTPClient::POST(String payload) {
+    return POST(reinterpret_cast<uint8_t*>(const_cast<char*>(payload.c_str())), payload.length());
+}
+
+int HTTPClient::PUT(uint8_t* payload, size_t size) {
+    return sendRequest("PUT", payload, size);
+}
+
+int HTTPClient::PUT(String payload) {
+    return PUT(reinterpret_cast<uint8_t*>(const_cast<char*>(payload.c_str())), payload.length());
+}
+
+int HTTPClient::PATCH(uint8_t* payload, size_t size) {
+    return sendRequest("PATCH", payload, size);
+}
+
+int HTTPClient::PATCH(String payload) {
+    return PATCH(reinterpret_cast<uint8_t*>(const_cast<char*>(payload.c_str())), payload.length());
+}
+
+int HTTPClient::sendRequest(const char* type, String payload) {
+    return sendRequest(type, reinterpret_cast<uint8_t*>(const_cast<char*>(payload.c_str())),
+                       payload.length());
+}
+
+int HTTPClient::sendRequest(const char* type, uint8_t* payload, size_t size) {
+    if (!connect()) {
+        return returnError(HTTPC_ERROR_CONNECTION_REFUSED);
+    }
+
+    if (payload && size > 0) {
+        addHeader("Content-Length", String(static_cast<unsigned int>(size)));
+    }
+
+    if (!sendHeader(type)) {
+        return returnError(HTTPC_ERROR_SEND_HEADER_FAILED);
+    }
+
+    if (payload && size > 0) {
+        if (_client->write(payload, size) != size) {
+            return returnError(HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+        }
+    }
+
+    return returnError(handleHeaderResponse());
+}
+
+void HTTPClient::addHeader(const String& name, const String& value, bool first, bool replace) {
+    // Headers managed by sendHeader()
+    if (name.equalsIgnoreCase("Connection") || name.equalsIgnoreCase("User-Agent") ||
+        name.equalsIgnoreCase("Host")) {
+        return;
+    }
+
+    String headerLine = name + ": " + value + "\r\n";
+
+    if (replace) {
+        int start = 0;
+        String lowerHeaders = _headers;
+        lowerHeaders.toLowerCase();
+        String lowerName = name;
+        lowerName.toLowerCase();
+        lowerName += ":";
+
+        while ((start = lowerHeaders.indexOf(lowerName, start)) >= 0) {
+            if (start == 0 || lowerHeaders[start - 1] == '\n') {
+                int end = lowerHeaders.indexOf('\n', start);
+                _headers.remove(start, end - start + 1);
+                break;
+            }
+            start++;
+        }
+    }
+
+    if (first) {
+        _headers = headerLine + _headers;
+    } else {
+        _headers += headerLine;
+    }
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _currentHeaders.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        _currentHeaders.push_back({String(headerKeys[i]), String()});
+    }
+}
+
+String HTTPClient::header(const char* name) {
+    for (const auto& header : _currentHeaders) {
+        if (header.key.equalsIgnoreCase(name)) {
+            return header.value;
+        }
+    }
+    return String();
+}
+
+String HTTPClient::header(size_t i) {
+    return i < _currentHeaders.size() ? _currentHeaders[i].value : String();
+}
+
+String HTTPClient::headerName(size_t i) {
+    return i < _currentHeaders.size() ? _currentHeaders[i].key : String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    for (const auto& header : _currentHeaders) {
+        if (header.key.equalsIgnoreCase(name) && !header.value.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HTTPClient::sendHeader(const char* type) {
+    if (!connected()) {
+        return false;
+    }
+
+    String header = String(type) + " " + _uri + (_useHTTP10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+
+    header += "Host: " + _host;
+    if ((_secure && _port != 443) || (!_secure && _port != 80)) {
+        header += ":" + String(static_cast<unsigned int>(_port));
+    }
+    header += "\r\nUser-Agent: " + _userAgent + "\r\nConnection: ";
+    header += _reuse ? "keep-alive\r\n" : "close\r\n";
+
+    if (!_useHTTP10) {
+        header += "Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0\r\n";
+    }
+
+    header += _headers + "\r\n";
+
+    return _client->write(reinterpret_cast<const uint8_t*>(header.c_str()), header.length()) ==
+           header.length();
+}
+
+int HTTPClient::readLine(String& line) {
+    line = "";
+    unsigned long start = millis();
+
+    while (connected()) {
+        int c = _client->read();
+        if (c < 0) {
+            if (millis() - start > _tcpTimeout) {
+                return HTTPC_ERROR_READ_TIMEOUT;
+            }
+            delay(1);
+            continue;
+        }
+        if (c == '\n') {
+            if (line.endsWith("\r")) {
+                line.remove(line.length() - 1);
+            }
+            return 0;
+        }
+        line += static_cast<char>(c);
+    }
+
+    return HTTPC_ERROR_CONNECTION_LOST;
+}
+
+int HTTPClient::handleHeaderResponse() {
+    if (!connected()) {
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+
+    _returnCode = 0;
+    _size = -1;
+    _canReuse = _reuse;
+    _transferEncoding = HTTPC_TE_IDENTITY;
+
+    String line;
+    bool firstLine = true;
+
+    for (;;) {
+        int rc = readLine(line);
+        if (rc < 0) {
+            return rc;
+        }
+
+        if (firstLine) {
+            firstLine = false;
+            if (!line.startsWith("HTTP/1.")) {
+                return HTTPC_ERROR_NO_HTTP_SERVER;
+            }
+            if (line.startsWith("HTTP/1.0")) {
+                _canReuse = false;
+            }
+            _returnCode = line.substring(9, line.indexOf(' ', 9)).toInt();
+            continue;
+        }
+
+        if (line.isEmpty()) {
+            break;
+        }
+
+        int colon = line.indexOf(':');
+        if (colon < 0) {
+            continue;
+        }
+
+        String name = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+
+        if (name.equalsIgnoreCase("Content-Length")) {
+            _size = value.toInt();
+        } else if (name.equalsIgnoreCase("Connection")) {
+            if (value.indexOf("close") >= 0 && value.indexOf("keep-alive") < 0) {
+                _canReuse = false;
+            }
+        } else if (name.equalsIgnoreCase("Transfer-Encoding")) {
+            if (value.equalsIgnoreCase("chunked")) {
+                _transferEncoding = HTTPC_TE_CHUNKED;
+            }
+        } else if (name.equalsIgnoreCase("Location")) {
+            _location = value;
+        }
+
+        for (auto& header : _currentHeaders) {
+            if (header.key.equalsIgnoreCase(name)) {
+                if (!header.value.isEmpty()) {
+                    header.value += ",";
+                }
+                header.value += value;
+            }
+        }
+    }
+
+    // Without a length or chunking the body runs until close
+    if (_size < 0 && _transferEncoding == HTTPC_TE_IDENTITY &&
+        _returnCode != HTTP_CODE_NO_CONTENT && _returnCode != HTTP_CODE_NOT_MODIFIED) {
+        _canReuse = false;
+    }
+
+    return _returnCode > 0 ? _returnCode : HTTPC_ERROR_NO_HTTP_SERVER;
+}
+
+int HTTPClient::writeToStreamDataBlock(Stream* stream, int size) {
+    uint8_t buff[HTTP_TCP_BUFFER_SIZE];
+    int written = 0;
+    unsigned long lastData = millis();
+
+    while (connected() && (size < 0 || written < size)) {
+        size_t want = sizeof(buff);
+        if (size >= 0) {
+            want = std::min<size_t>(want, size - written);
+        }
+
+        int n = _client->read(buff, want);
+        if (n <= 0) {
+            if (millis() - lastData > _tcpTimeout) {
+                return HTTPC_ERROR_READ_TIMEOUT;
+            }
+            delay(1);
+            continue;
+        }
+
+        if (stream->write(buff, n) != static_cast<size_t>(n)) {
+            return HTTPC_ERROR_STREAM_WRITE;
+        }
+        written += n;
+        lastData = millis();
+    }
+
+    if (size >= 0 && written < size) {
+        return HTTPC_ERROR_CONNECTION_LOST;
+    }
+    return written;
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+    if (!stream) {
+        return returnError(HTTPC_ERROR_NO_STREAM);
+    }
+
+    if (!connected()) {
+        return returnError(HTTPC_ERROR_NOT_CONNECTED);
+    }
+
+    if (_transferEncoding == HTTPC_TE_IDENTITY) {
+        int ret = writeToStreamDataBlock(stream, _size);
+        return returnError(ret);
+    }
+
+    int total = 0;
+    String line;
+    for (;;) {
+        int rc = readLine(line);
+        if (rc < 0) {
+            return returnError(rc);
+        }
+
+        int chunkSize = static_cast<int>(strtol(line.c_str(), nullptr, 16));
+        if (chunkSize == 0) {
+            // Trailer section ends with an empty line
+            while (readLine(line) == 0 && !line.isEmpty()) {
+            }
+            break;
+        }
+
+        int ret = writeToStreamDataBlock(stream, chunkSize);
+        if (ret < 0) {
+            return returnError(ret);
+        }
+        total += ret;
+
+        if (readLine(line) < 0) {
+            return returnError(HTTPC_ERROR_READ_TIMEOUT);
+        }
+    }
+
+    return total;
+}
+
+String HTTPClient::getString() {
+    String body;
+    if (_size > 0) {
+        body.reserve(_size);
+    }
+
+    if (_returnCode == HTTP_CODE_NO_CONTENT || _size == 0) {
+        return body;
+    }
+
+    StringSink stream(body);
+    writeToStream(&stream);
+    return body;
+}
+
+int HTTPClient::returnError(int error) {
+    if (error < 0) {
+        if (_client && connected()) {
+            _client->stop();
+        }
+        _canReuse = false;
+    }
+    return error;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED:  return "connection refused";
+        case HTTPC_ERROR_SEND_HEADER_FAILED:  return "send header failed";
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+        case HTTPC_ERROR_NOT_CONNECTED:       return "not connected";
+        case HTTPC_ERROR_CONNECTION_LOST:     return "connection lost";
+        case HTTPC_ERROR_NO_STREAM:           return "no stream";
+        case HTTPC_ERROR_NO_HTTP_SERVER:      return "no HTTP server";
+        case HTTPC_ERROR_TOO_LESS_RAM:        return "too less ram";
+        case HTTPC_ERROR_ENCODING:            return "Transfer-Encoding not supported";
+        case HTTPC_ERROR_STREAM_WRITE:        return "Stream write error";
+        case HTTPC_ERROR_READ_TIMEOUT:        return "read Timeout";
+        default:                              return String();
+    }
+}
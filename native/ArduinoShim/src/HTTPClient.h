@@ -0,0 +1,147 @@
+/**
+ * @file HTTPClient.h
+ * @brief HTTP/1.1 Client Shim (ESP32 HTTPClient API)
+ *
+ * Follows the ESP32 core semantics the firmware relies on:
+ * - connections are reused across begin()/end() while the server
+ *   allows keep-alive (setReuse(true) is the default), even if the
+ *   next begin() names a different host - callers must use one
+ *   WiFiClient per host
+ * - getStreamPtr() returns the raw connection; chunked bodies are only
+ *   decoded by getString() and writeToStream()
+ */
+
+#ifndef HTTP_CLIENT_SHIM_H
+#define HTTP_CLIENT_SHIM_H
+
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT (5000)
+
+// HTTP client errors
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+typedef enum {
+    HTTP_CODE_CONTINUE = 100,
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_CREATED = 201,
+    HTTP_CODE_ACCEPTED = 202,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_MOVED_PERMANENTLY = 301,
+    HTTP_CODE_FOUND = 302,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_FORBIDDEN = 403,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_TOO_MANY_REQUESTS = 429,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_BAD_GATEWAY = 502,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503
+} t_http_codes;
+
+typedef enum {
+    HTTPC_TE_IDENTITY,
+    HTTPC_TE_CHUNKED
+} transferEncoding_t;
+
+class HTTPClient {
+public:
+    HTTPClient();
+    ~HTTPClient();
+
+    bool begin(WiFiClient& client, String url);
+    bool begin(WiFiClient& client, String host, uint16_t port, String uri = "/", bool https = false);
+    void end();
+
+    bool connected();
+
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setUserAgent(const String& userAgent) { _userAgent = userAgent; }
+    void setTimeout(uint16_t timeout) { _tcpTimeout = timeout; }
+    void setConnectTimeout(int32_t connectTimeout) { _connectTimeout = connectTimeout; }
+    void useHTTP10(bool usehttp10 = true);
+
+    int GET();
+    int POST(uint8_t* payload, size_t size);
+    int POST(String payload);
+    int PUT(uint8_t* payload, size_t size);
+    int PUT(String payload);
+    int PATCH(uint8_t* payload, size_t size);
+    int PATCH(String payload);
+    int sendRequest(const char* type, String payload);
+    int sendRequest(const char* type, uint8_t* payload = nullptr, size_t size = 0);
+
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
+
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    String header(size_t i);
+    String headerName(size_t i);
+    int headers() { return static_cast<int>(_currentHeaders.size()); }
+    bool hasHeader(const char* name);
+
+    int getSize() { return _size; }
+    const String& getLocation() { return _location; }
+
+    WiFiClient& getStream() { return *_client; }
+    WiFiClient* getStreamPtr() { return connected() ? _client : nullptr; }
+    int writeToStream(Stream* stream);
+    String getString();
+
+    static String errorToString(int error);
+
+private:
+    struct RequestArgument {
+        String key;
+        String value;
+    };
+
+    bool beginInternal(String url);
+    bool connect();
+    bool sendHeader(const char* type);
+    int handleHeaderResponse();
+    void disconnect(bool preserveClient = false);
+    void clear();
+    int returnError(int error);
+    int readLine(String& line);
+    int writeToStreamDataBlock(Stream* stream, int len);
+
+    WiFiClient* _client;
+
+    String _host;
+    uint16_t _port;
+    String _uri;
+    String _protocol;
+    bool _secure;
+
+    uint16_t _tcpTimeout;
+    int32_t _connectTimeout;
+    bool _reuse;
+    bool _canReuse;
+    bool _useHTTP10;
+
+    String _headers;
+    String _userAgent;
+
+    std::vector<RequestArgument> _currentHeaders;
+
+    int _returnCode;
+    int _size;
+    String _location;
+    transferEncoding_t _transferEncoding;
+};
+
+#endif // HTTP_CLIENT_SHIM_H
@@ -0,0 +1,55 @@
+/**
+ * @file HardwareSerial.cpp
+ * @brief Serial Port Shim Implementation
+ */
+
+#include "HardwareSerial.h"
+
+#include <cstdio>
+#include <poll.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+
+int HardwareSerial::available() {
+    if (peeked >= 0) {
+        return 1;
+    }
+
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN) ? 1 : 0;
+}
+
+int HardwareSerial::read() {
+    if (peeked >= 0) {
+        int c = peeked;
+        peeked = -1;
+        return c;
+    }
+
+    if (!available()) {
+        return -1;
+    }
+
+    unsigned char c;
+    return ::read(STDIN_FILENO, &c, 1) == 1 ? c : -1;
+}
+
+int HardwareSerial::peek() {
+    if (peeked < 0) {
+        peeked = read();
+    }
+    return peeked;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file HardwareSerial.h
+ * @brief Serial Port Shim (stdout/stdin)
+ */
+
+#ifndef HARDWARE_SERIAL_SHIM_H
+#define HARDWARE_SERIAL_SHIM_H
+
+#include "Stream.h"
+
+/**
+ * @brief Serial port backed by the process' stdout and stdin
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    explicit operator bool() const { return true; }
+
+private:
+    int peeked = -1;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HARDWARE_SERIAL_SHIM_H
@@ -0,0 +1,15 @@
+/**
+ * @file IPAddress.cpp
+ * @brief IPv4 Address Shim Implementation
+ */
+
+#include "IPAddress.h"
+
+#include <cstdio>
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u",
+             address[0], address[1], address[2], address[3]);
+    return String(buf);
+}
@@ -0,0 +1,29 @@
+/**
+ * @file IPAddress.h
+ * @brief IPv4 Address Shim
+ */
+
+#ifndef IP_ADDRESS_SHIM_H
+#define IP_ADDRESS_SHIM_H
+
+#include <cstdint>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() : address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return address[index]; }
+    bool operator==(const IPAddress& rhs) const {
+        return address[0] == rhs.address[0] && address[1] == rhs.address[1] &&
+               address[2] == rhs.address[2] && address[3] == rhs.address[3];
+    }
+
+    String toString() const;
+
+private:
+    uint8_t address[4];
+};
+
+#endif // IP_ADDRESS_SHIM_H
@@ -0,0 +1,41 @@
+/**
+ * @file LittleFS.h
+ * @brief LittleFS Shim
+ *
+ * Files live under $LITTLEFS_ROOT (default .pio/native_fs) so config,
+ * tokens and caches persist across host runs like flash does.
+ */
+
+#ifndef LITTLEFS_SHIM_H
+#define LITTLEFS_SHIM_H
+
+#include "FS.h"
+
+#ifndef NATIVE_LITTLEFS_ROOT
+#define NATIVE_LITTLEFS_ROOT ".pio/native_fs"
+#endif
+
+#ifndef NATIVE_LITTLEFS_SIZE
+#define NATIVE_LITTLEFS_SIZE (1536U * 1024U)
+#endif
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+    LittleFSFS();
+
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() { mounted = false; }
+    bool format();
+
+    size_t totalBytes() { return NATIVE_LITTLEFS_SIZE; }
+    size_t usedBytes();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // LITTLEFS_SHIM_H
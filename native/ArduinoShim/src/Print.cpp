@@ -0,0 +1,69 @@
+/**
+ * @file Print.cpp
+ * @brief Arduino Print Shim Implementation
+ */
+
+#include "Print.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++)) {
+            n++;
+        } else {
+            break;
+        }
+    }
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    if (!str) {
+        return 0;
+    }
+    return write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuf[256];
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(stackBuf, sizeof(stackBuf), format, args);
+    va_end(args);
+
+    if (len < 0) {
+        return 0;
+    }
+    if (static_cast<size_t>(len) < sizeof(stackBuf)) {
+        return write(reinterpret_cast<const uint8_t*>(stackBuf), len);
+    }
+
+    std::vector<char> heapBuf(len + 1);
+    va_start(args, format);
+    vsnprintf(heapBuf.data(), heapBuf.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t*>(heapBuf.data()), len);
+}
+
+size_t Print::print(const String& s) {
+    return write(reinterpret_cast<const uint8_t*>(s.c_str()), s.length());
+}
+
+size_t Print::print(const char* s) { return write(s); }
+size_t Print::print(char c) { return write(static_cast<uint8_t>(c)); }
+size_t Print::print(unsigned char n, int base) { return print(String(n, base)); }
+size_t Print::print(int n, int base) { return print(String(n, base)); }
+size_t Print::print(unsigned int n, int base) { return print(String(n, base)); }
+size_t Print::print(long n, int base) { return print(String(n, base)); }
+size_t Print::print(unsigned long n, int base) { return print(String(n, base)); }
+size_t Print::print(double n, int digits) { return print(String(n, digits)); }
+
+size_t Print::println() {
+    return write("\r\n");
+}
@@ -0,0 +1,65 @@
+/**
+ * @file Stream.cpp
+ * @brief Arduino Stream Shim Implementation
+ */
+
+#include "Stream.h"
+#include "Arduino.h"
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        delay(1);
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        *buffer++ = static_cast<char>(c);
+        count++;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0 || c == terminator) {
+            break;
+        }
+        *buffer++ = static_cast<char>(c);
+        count++;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String ret;
+    int c = timedRead();
+    while (c >= 0) {
+        ret += static_cast<char>(c);
+        c = timedRead();
+    }
+    return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int c = timedRead();
+    while (c >= 0 && c != terminator) {
+        ret += static_cast<char>(c);
+        c = timedRead();
+    }
+    return ret;
+}
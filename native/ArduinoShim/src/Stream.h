@@ -0,0 +1,46 @@
+/**
+ * @file Stream.h
+ * @brief Arduino Stream Shim
+ */
+
+#ifndef STREAM_SHIM_H
+#define STREAM_SHIM_H
+
+#include "Print.h"
+
+/**
+ * @brief Readable byte stream with a blocking timeout
+ */
+class Stream : public Print {
+public:
+    Stream() : timeout(1000) {}
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeoutMs) { timeout = timeoutMs; }
+    unsigned long getTimeout() const { return timeout; }
+
+    /**
+     * @brief Read up to length bytes, waiting at most the timeout per byte
+     */
+    virtual size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes(reinterpret_cast<char*>(buffer), length);
+    }
+
+    size_t readBytesUntil(char terminator, char* buffer, size_t length);
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    /**
+     * @brief Read one byte, waiting up to the timeout (-1 on timeout)
+     */
+    int timedRead();
+
+    unsigned long timeout;
+};
+
+#endif // STREAM_SHIM_H
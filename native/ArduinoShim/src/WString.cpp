@@ -0,0 +1,342 @@
+/**
+ * @file WString.cpp
+ * @brief Arduino String Shim Implementation
+ */
+
+#include "WString.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace {
+
+std::string formatInteger(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+
+    char buf[72];
+    int pos = sizeof(buf) - 1;
+    buf[pos] = '\0';
+
+    do {
+        int digit = static_cast<int>(value % base);
+        buf[--pos] = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value > 0 && pos > 1);
+
+    if (negative) {
+        buf[--pos] = '-';
+    }
+
+    return std::string(&buf[pos]);
+}
+
+std::string formatSigned(long long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+        return formatInteger(0ULL - static_cast<unsigned long long>(value), true, base);
+    }
+    return formatInteger(static_cast<unsigned long long>(value), false, base);
+}
+
+std::string formatFloat(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimalPlaces), value);
+    return std::string(buf);
+}
+
+} // namespace
+
+String::String(const char* cstr) : buffer(cstr ? cstr : "") {}
+
+String::String(const char* cstr, size_t length) {
+    if (cstr) {
+        buffer.assign(cstr, length);
+    }
+}
+
+String::String(char c) : buffer(1, c) {}
+
+String::String(unsigned char value, unsigned char base)
+    : buffer(formatInteger(value, false, base)) {}
+
+String::String(int value, unsigned char base) : buffer(formatSigned(value, base)) {}
+
+String::String(unsigned int value, unsigned char base)
+    : buffer(formatInteger(value, false, base)) {}
+
+String::String(long value, unsigned char base) : buffer(formatSigned(value, base)) {}
+
+String::String(unsigned long value, unsigned char base)
+    : buffer(formatInteger(value, false, base)) {}
+
+String::String(long long value, unsigned char base) : buffer(formatSigned(value, base)) {}
+
+String::String(unsigned long long value, unsigned char base)
+    : buffer(formatInteger(value, false, base)) {}
+
+String::String(float value, unsigned int decimalPlaces)
+    : buffer(formatFloat(value, decimalPlaces)) {}
+
+String::String(double value, unsigned int decimalPlaces)
+    : buffer(formatFloat(value, decimalPlaces)) {}
+
+String& String::operator=(const char* cstr) {
+    buffer = cstr ? cstr : "";
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    buffer.reserve(size);
+    return true;
+}
+
+bool String::concat(const String& str) {
+    buffer += str.buffer;
+    return true;
+}
+
+bool String::concat(const char* cstr) {
+    if (!cstr) {
+        return false;
+    }
+    buffer += cstr;
+    return true;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) {
+        return false;
+    }
+    buffer.append(cstr, length);
+    return true;
+}
+
+bool String::concat(char c) {
+    buffer += c;
+    return true;
+}
+
+bool String::concat(unsigned char num) { return concat(String(num)); }
+bool String::concat(int num) { return concat(String(num)); }
+bool String::concat(unsigned int num) { return concat(String(num)); }
+bool String::concat(long num) { return concat(String(num)); }
+bool String::concat(unsigned long num) { return concat(String(num)); }
+bool String::concat(long long num) { return concat(String(num)); }
+bool String::concat(unsigned long long num) { return concat(String(num)); }
+bool String::concat(float num) { return concat(String(num)); }
+bool String::concat(double num) { return concat(String(num)); }
+
+int String::compareTo(const String& s) const {
+    return buffer.compare(s.buffer);
+}
+
+bool String::equals(const char* cstr) const {
+    return buffer == (cstr ? cstr : "");
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    return buffer.size() == s.buffer.size() &&
+           strcasecmp(buffer.c_str(), s.buffer.c_str()) == 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > buffer.size() || prefix.buffer.size() > buffer.size() - offset) {
+        return false;
+    }
+    return buffer.compare(offset, prefix.buffer.size(), prefix.buffer) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.buffer.size() > buffer.size()) {
+        return false;
+    }
+    return buffer.compare(buffer.size() - suffix.buffer.size(),
+                          suffix.buffer.size(), suffix.buffer) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < buffer.size() ? buffer[index] : '\0';
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < buffer.size()) {
+        buffer[index] = c;
+    }
+}
+
+char String::operator[](unsigned int index) const {
+    return charAt(index);
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= buffer.size()) {
+        dummy = '\0';
+        return dummy;
+    }
+    return buffer[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const {
+    if (!buf || bufsize == 0) {
+        return;
+    }
+    if (index >= buffer.size()) {
+        buf[0] = '\0';
+        return;
+    }
+    size_t n = std::min<size_t>(bufsize - 1, buffer.size() - index);
+    memcpy(buf, buffer.data() + index, n);
+    buf[n] = '\0';
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    size_t pos = buffer.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(char ch) const {
+    size_t pos = buffer.rfind(ch);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+    size_t pos = buffer.rfind(ch, fromIndex);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(const String& str) const {
+    size_t pos = buffer.rfind(str.buffer);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = buffer.rfind(str.buffer, fromIndex);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        std::swap(beginIndex, endIndex);
+    }
+    if (beginIndex >= buffer.size()) {
+        return String();
+    }
+    endIndex = std::min<unsigned int>(endIndex, length());
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(char find, char replace) {
+    std::replace(buffer.begin(), buffer.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace) {
+    if (find.buffer.empty()) {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = buffer.find(find.buffer, pos)) != std::string::npos) {
+        buffer.replace(pos, find.buffer.size(), replace.buffer);
+        pos += replace.buffer.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    remove(index, static_cast<unsigned int>(-1));
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= buffer.size()) {
+        return;
+    }
+    buffer.erase(index, count);
+}
+
+void String::toLowerCase() {
+    for (char& c : buffer) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : buffer) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::trim() {
+    size_t first = buffer.find_first_not_of(" \t\r\n\f\v");
+    if (first == std::string::npos) {
+        buffer.clear();
+        return;
+    }
+    size_t last = buffer.find_last_not_of(" \t\r\n\f\v");
+    buffer = buffer.substr(first, last - first + 1);
+}
+
+long String::toInt() const {
+    return strtol(buffer.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(buffer.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+    return strtod(buffer.c_str(), nullptr);
+}
+
+String operator+(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const String& lhs, char rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(char lhs, const String& rhs) {
+    String result(lhs);
+    result.concat(rhs);
+    return result;
+}
+
+String operator+(const String& lhs, int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, float rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, double rhs) { return lhs + String(rhs); }
@@ -0,0 +1,197 @@
+/**
+ * @file WebServer.cpp
+ * @brief Minimal HTTP Server Shim Implementation
+ */
+
+#include "WebServer.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define WEB_SERVER_REQUEST_TIMEOUT_MS 2000
+
+WebServer::WebServer(int port)
+    : port(port)
+    , listenFd(-1)
+    , clientFd(-1) {
+}
+
+WebServer::~WebServer() {
+    stop();
+}
+
+void WebServer::begin() {
+    stop();
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        return;
+    }
+
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (bind(listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, 4) < 0) {
+        Serial.printf("⚠️  WebServer: cannot listen on port %d\n", port);
+        close(listenFd);
+        listenFd = -1;
+    }
+}
+
+void WebServer::stop() {
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+    }
+}
+
+void WebServer::on(const String& uri, THandlerFunction handler) {
+    routes.push_back({uri, handler});
+}
+
+void WebServer::handleClient() {
+    if (listenFd < 0) {
+        return;
+    }
+
+    clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (clientFd < 0) {
+        return;
+    }
+
+    // Read until the end of the request header
+    String request;
+    char buf[512];
+    unsigned long start = millis();
+    while (request.indexOf("\r\n\r\n") < 0 && millis() - start < WEB_SERVER_REQUEST_TIMEOUT_MS) {
+        struct pollfd pfd = {clientFd, POLLIN, 0};
+        if (poll(&pfd, 1, 50) <= 0) {
+            continue;
+        }
+        ssize_t n = recv(clientFd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            break;
+        }
+        request.concat(buf, static_cast<unsigned int>(n));
+    }
+
+    int lineEnd = request.indexOf("\r\n");
+    int methodEnd = request.indexOf(' ');
+    int pathEnd = methodEnd >= 0 ? request.indexOf(' ', methodEnd + 1) : -1;
+
+    if (lineEnd > 0 && methodEnd > 0 && pathEnd > methodEnd) {
+        String target = request.substring(methodEnd + 1, pathEnd);
+        int queryStart = target.indexOf('?');
+
+        currentUri = queryStart >= 0 ? target.substring(0, queryStart) : target;
+        currentArgs.clear();
+        if (queryStart >= 0) {
+            parseArguments(target.substring(queryStart + 1));
+        }
+        responseHeaders = "";
+
+        THandlerFunction handler = notFoundHandler;
+        for (const auto& route : routes) {
+            if (route.uri == currentUri) {
+                handler = route.handler;
+                break;
+            }
+        }
+
+        if (handler) {
+            handler();
+        } else {
+            send(404, "text/plain", "Not found");
+        }
+    }
+
+    if (clientFd >= 0) {
+        close(clientFd);
+        clientFd = -1;
+    }
+}
+
+String WebServer::arg(const String& name) const {
+    for (const auto& argument : currentArgs) {
+        if (argument.key == name) {
+            return argument.value;
+        }
+    }
+    return String();
+}
+
+bool WebServer::hasArg(const String& name) const {
+    for (const auto& argument : currentArgs) {
+        if (argument.key == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    String line = name + ": " + value + "\r\n";
+    responseHeaders = first ? line + responseHeaders : responseHeaders + line;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    if (clientFd < 0) {
+        return;
+    }
+
+    String response = "HTTP/1.1 " + String(code) + " OK\r\n";
+    if (contentType) {
+        response += "Content-Type: " + String(contentType) + "\r\n";
+    }
+    response += "Content-Length: " + String(content.length()) + "\r\n";
+    response += "Connection: close\r\n";
+    response += responseHeaders + "\r\n";
+    response += content;
+
+    ::send(clientFd, response.c_str(), response.length(), MSG_NOSIGNAL);
+}
+
+String WebServer::urlDecode(const String& text) {
+    String decoded;
+    for (unsigned int i = 0; i < text.length(); i++) {
+        char c = text[i];
+        if (c == '+') {
+            decoded += ' ';
+        } else if (c == '%' && i + 2 < text.length()) {
+            char hex[3] = {text[i + 1], text[i + 2], '\0'};
+            decoded += static_cast<char>(strtol(hex, nullptr, 16));
+            i += 2;
+        } else {
+            decoded += c;
+        }
+    }
+    return decoded;
+}
+
+void WebServer::parseArguments(const String& query) {
+    int start = 0;
+    while (start < static_cast<int>(query.length())) {
+        int end = query.indexOf('&', start);
+        if (end < 0) {
+            end = query.length();
+        }
+
+        String pair = query.substring(start, end);
+        int eq = pair.indexOf('=');
+        if (eq >= 0) {
+            currentArgs.push_back({urlDecode(pair.substring(0, eq)), urlDecode(pair.substring(eq + 1))});
+        } else if (!pair.isEmpty()) {
+            currentArgs.push_back({urlDecode(pair), String()});
+        }
+
+        start = end + 1;
+    }
+}
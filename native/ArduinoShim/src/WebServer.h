@@ -0,0 +1,67 @@
+/**
+ * @file WebServer.h
+ * @brief Minimal HTTP Server Shim (ESP32 WebServer API)
+ *
+ * Serves one connection per handleClient() call, GET query arguments
+ * only. Enough for the OAuth captive portal in AuthManager.
+ */
+
+#ifndef WEB_SERVER_SHIM_H
+#define WEB_SERVER_SHIM_H
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80);
+    ~WebServer();
+
+    void begin();
+    void stop();
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction handler);
+    void onNotFound(THandlerFunction handler) { notFoundHandler = handler; }
+
+    String uri() const { return currentUri; }
+    String arg(const String& name) const;
+    bool hasArg(const String& name) const;
+    int args() const { return static_cast<int>(currentArgs.size()); }
+
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void send(int code, const char* contentType = nullptr, const String& content = String(""));
+    void send(int code, const String& contentType, const String& content) {
+        send(code, contentType.c_str(), content);
+    }
+
+private:
+    struct Route {
+        String uri;
+        THandlerFunction handler;
+    };
+
+    struct Argument {
+        String key;
+        String value;
+    };
+
+    static String urlDecode(const String& text);
+    void parseArguments(const String& query);
+
+    int port;
+    int listenFd;
+    int clientFd;
+
+    std::vector<Route> routes;
+    THandlerFunction notFoundHandler;
+
+    String currentUri;
+    std::vector<Argument> currentArgs;
+    String responseHeaders;
+};
+
+#endif // WEB_SERVER_SHIM_H
@@ -0,0 +1,82 @@
+/**
+ * @file WiFi.cpp
+ * @brief WiFi Shim Implementation
+ */
+
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+WiFiClass::WiFiClass()
+    : currentStatus(WL_DISCONNECTED)
+    , currentMode(WIFI_MODE_NULL)
+    , apIP(192, 168, 4, 1) {
+}
+
+wl_status_t WiFiClass::begin(const char* ssidName, const char* passphrase) {
+    (void)passphrase;
+    ssid = ssidName ? ssidName : "";
+
+    dispatch(ARDUINO_EVENT_WIFI_STA_START);
+    currentStatus = WL_CONNECTED;
+    dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+
+    return currentStatus;
+}
+
+bool WiFiClass::reconnect() {
+    begin(ssid.c_str());
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifioff) {
+    (void)wifioff;
+    if (currentStatus == WL_CONNECTED) {
+        currentStatus = WL_DISCONNECTED;
+
+        arduino_event_info_t info = {};
+        info.wifi_sta_disconnected.reason = WIFI_REASON_UNSPECIFIED;
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+    }
+    return true;
+}
+
+bool WiFiClass::softAP(const char* apSsid, const char* passphrase) {
+    (void)passphrase;
+    ssid = apSsid ? apSsid : "";
+    dispatch(ARDUINO_EVENT_WIFI_AP_START);
+    return true;
+}
+
+bool WiFiClass::softAPConfig(IPAddress localIp, IPAddress gateway, IPAddress subnet) {
+    (void)gateway;
+    (void)subnet;
+    apIP = localIp;
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff) {
+    (void)wifioff;
+    dispatch(ARDUINO_EVENT_WIFI_AP_STOP);
+    return true;
+}
+
+int WiFiClass::onEvent(WiFiEventCb cbEvent, arduino_event_id_t event) {
+    return onEvent(WiFiEventFuncCb([cbEvent](arduino_event_id_t e, arduino_event_info_t) {
+        cbEvent(e);
+    }), event);
+}
+
+int WiFiClass::onEvent(WiFiEventFuncCb cbEvent, arduino_event_id_t event) {
+    handlers.push_back({cbEvent, event});
+    return static_cast<int>(handlers.size());
+}
+
+void WiFiClass::dispatch(arduino_event_id_t event, const arduino_event_info_t& info) {
+    for (const auto& handler : handlers) {
+        if (handler.event == ARDUINO_EVENT_MAX || handler.event == event) {
+            handler.callback(event, info);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file WiFi.h
+ * @brief WiFi Shim
+ *
+ * The host network is always "connected". begin() dispatches the same
+ * event sequence the ESP32 raises on a successful association.
+ */
+
+#ifndef WIFI_SHIM_H
+#define WIFI_SHIM_H
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA
+} wifi_mode_t;
+
+typedef wifi_mode_t WiFiMode_t;
+#define WIFI_OFF   WIFI_MODE_NULL
+#define WIFI_STA   WIFI_MODE_STA
+#define WIFI_AP    WIFI_MODE_AP
+#define WIFI_AP_STA WIFI_MODE_APSTA
+
+typedef enum {
+    WIFI_REASON_UNSPECIFIED = 1,
+    WIFI_REASON_AUTH_EXPIRE = 2,
+    WIFI_REASON_BEACON_TIMEOUT = 200,
+    WIFI_REASON_NO_AP_FOUND = 201
+} wifi_err_reason_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_SCAN_DONE,
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_STOP,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_WIFI_AP_START,
+    ARDUINO_EVENT_WIFI_AP_STOP,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef struct {
+    uint8_t ssid[33];
+    uint8_t ssid_len;
+    uint8_t bssid[6];
+    uint8_t reason;
+} wifi_event_sta_disconnected_t;
+
+typedef union {
+    wifi_event_sta_disconnected_t wifi_sta_disconnected;
+} arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+class WiFiClass {
+public:
+    WiFiClass();
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool reconnect();
+    bool disconnect(bool wifioff = false);
+    wl_status_t status() const { return currentStatus; }
+    bool isConnected() const { return currentStatus == WL_CONNECTED; }
+
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() const { return currentMode; }
+    bool setAutoReconnect(bool autoReconnect) { (void)autoReconnect; return true; }
+    bool setHostname(const char* hostname) { (void)hostname; return true; }
+
+    IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+    String SSID() const { return ssid; }
+    int8_t RSSI() const { return currentStatus == WL_CONNECTED ? -50 : 0; }
+    String macAddress() const { return "02:00:5E:10:00:00"; }
+
+    bool softAP(const char* ssid, const char* passphrase = nullptr);
+    bool softAPConfig(IPAddress localIp, IPAddress gateway, IPAddress subnet);
+    bool softAPdisconnect(bool wifioff = false);
+    IPAddress softAPIP() const { return apIP; }
+
+    int onEvent(WiFiEventCb cbEvent, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    int onEvent(WiFiEventFuncCb cbEvent, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+private:
+    struct EventHandler {
+        WiFiEventFuncCb callback;
+        arduino_event_id_t event;
+    };
+
+    void dispatch(arduino_event_id_t event, const arduino_event_info_t& info = {});
+
+    std::vector<EventHandler> handlers;
+    wl_status_t currentStatus;
+    wifi_mode_t currentMode;
+    String ssid;
+    IPAddress apIP;
+};
+
+extern WiFiClass WiFi;
+
+#endif // WIFI_SHIM_H
@@ -0,0 +1,240 @@
+/**
+ * @file WiFiClient.cpp
+ * @brief TCP Client Shim Implementation
+ */
+
+#include "WiFiClient.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define WIFI_CLIENT_DEFAULT_CONNECT_TIMEOUT_MS 5000
+#define WIFI_CLIENT_RX_CHUNK 4096
+
+WiFiClient::WiFiClient()
+    : sockfd(-1)
+    , rxPos(0)
+    , peerClosed(false) {
+}
+
+WiFiClient::~WiFiClient() {
+    stop();
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port, WIFI_CLIENT_DEFAULT_CONNECT_TIMEOUT_MS);
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs) {
+    return connect(ip.toString().c_str(), port, timeoutMs);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, WIFI_CLIENT_DEFAULT_CONNECT_TIMEOUT_MS);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+    stop();
+
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    char portStr[8];
+    snprintf(portStr, sizeof(portStr), "%u", port);
+
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host, portStr, &hints, &result) != 0) {
+        return 0;
+    }
+
+    for (struct addrinfo* ai = result; ai; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        int rc = ::connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc < 0 && errno == EINPROGRESS) {
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            if (poll(&pfd, 1, timeoutMs) == 1) {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                rc = err == 0 ? 0 : -1;
+            }
+        }
+
+        if (rc == 0) {
+            sockfd = fd;
+            break;
+        }
+        close(fd);
+    }
+
+    freeaddrinfo(result);
+
+    if (sockfd < 0) {
+        return 0;
+    }
+
+    rxBuffer.clear();
+    rxPos = 0;
+    peerClosed = false;
+
+    if (!onConnected(host, timeoutMs)) {
+        stop();
+        return 0;
+    }
+
+    return 1;
+}
+
+bool WiFiClient::onConnected(const char* host, int32_t timeoutMs) {
+    (void)host;
+    (void)timeoutMs;
+    return true;
+}
+
+int WiFiClient::setNoDelay(bool noDelay) {
+    if (sockfd < 0) {
+        return -1;
+    }
+    int flag = noDelay ? 1 : 0;
+    return setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+bool WiFiClient::waitFd(bool forWrite, int timeoutMs) {
+    struct pollfd pfd = {sockfd, static_cast<short>(forWrite ? POLLOUT : POLLIN), 0};
+    return poll(&pfd, 1, timeoutMs) == 1;
+}
+
+int WiFiClient::sendRaw(const uint8_t* buf, size_t size) {
+    ssize_t n = send(sockfd, buf, size, MSG_NOSIGNAL);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    return static_cast<int>(n);
+}
+
+int WiFiClient::recvRaw(uint8_t* buf, size_t size) {
+    ssize_t n = recv(sockfd, buf, size, 0);
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? -1 : -2;
+    }
+    return static_cast<int>(n);
+}
+
+size_t WiFiClient::write(uint8_t data) {
+    return write(&data, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+    if (sockfd < 0) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    unsigned long start = millis();
+    while (sent < size) {
+        int n = sendRaw(buf + sent, size - sent);
+        if (n < 0) {
+            stop();
+            break;
+        }
+        if (n == 0) {
+            if (millis() - start > timeout) {
+                break;
+            }
+            waitFd(true, 10);
+            continue;
+        }
+        sent += n;
+    }
+    return sent;
+}
+
+void WiFiClient::fillBuffer() {
+    if (sockfd < 0 || peerClosed) {
+        return;
+    }
+
+    if (rxPos >= rxBuffer.size()) {
+        rxBuffer.clear();
+        rxPos = 0;
+    }
+
+    uint8_t chunk[WIFI_CLIENT_RX_CHUNK];
+    for (;;) {
+        int n = recvRaw(chunk, sizeof(chunk));
+        if (n > 0) {
+            rxBuffer.insert(rxBuffer.end(), chunk, chunk + n);
+            if (n < static_cast<int>(sizeof(chunk))) {
+                break;
+            }
+        } else {
+            if (n == 0 || n == -2) {
+                peerClosed = true;
+            }
+            break;
+        }
+    }
+}
+
+int WiFiClient::available() {
+    if (rxPos >= rxBuffer.size()) {
+        fillBuffer();
+    }
+    return static_cast<int>(rxBuffer.size() - rxPos);
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+    if (!available()) {
+        return -1;
+    }
+    size_t n = std::min(size, rxBuffer.size() - rxPos);
+    memcpy(buf, rxBuffer.data() + rxPos, n);
+    rxPos += n;
+    return static_cast<int>(n);
+}
+
+int WiFiClient::peek() {
+    if (!available()) {
+        return -1;
+    }
+    return rxBuffer[rxPos];
+}
+
+void WiFiClient::stop() {
+    if (sockfd >= 0) {
+        onStop();
+        close(sockfd);
+        sockfd = -1;
+    }
+    rxBuffer.clear();
+    rxPos = 0;
+    peerClosed = false;
+}
+
+uint8_t WiFiClient::connected() {
+    if (sockfd < 0) {
+        return 0;
+    }
+    if (rxPos < rxBuffer.size()) {
+        return 1;
+    }
+    fillBuffer();
+    return (rxPos < rxBuffer.size() || !peerClosed) ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file WiFiClient.h
+ * @brief TCP Client Shim (POSIX sockets)
+ *
+ * Non-blocking reads like the ESP32 WiFiClient: read()/available()
+ * never wait, Stream::readBytes() waits up to the stream timeout.
+ */
+
+#ifndef WIFI_CLIENT_SHIM_H
+#define WIFI_CLIENT_SHIM_H
+
+#include <vector>
+#include "Arduino.h"
+
+class WiFiClient : public Stream {
+public:
+    WiFiClient();
+    ~WiFiClient() override;
+
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    int connect(IPAddress ip, uint16_t port);
+    int connect(IPAddress ip, uint16_t port, int32_t timeoutMs);
+    int connect(const char* host, uint16_t port);
+    int connect(const char* host, uint16_t port, int32_t timeoutMs);
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    using Print::write;
+
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size);
+    int peek() override;
+    void flush() override {}
+
+    void stop();
+    uint8_t connected();
+    explicit operator bool() { return connected(); }
+
+    int fd() const { return sockfd; }
+    int setNoDelay(bool noDelay);
+
+protected:
+    /**
+     * @brief Hook for TLS: run after the TCP connection is established
+     */
+    virtual bool onConnected(const char* host, int32_t timeoutMs);
+
+    /**
+     * @brief Hook for TLS: release session state before the socket closes
+     */
+    virtual void onStop() {}
+
+    /**
+     * @brief Send raw bytes, returns bytes sent or -1 on error
+     */
+    virtual int sendRaw(const uint8_t* buf, size_t size);
+
+    /**
+     * @brief Receive without blocking: >0 bytes, 0 peer closed, -1 nothing yet, -2 error
+     */
+    virtual int recvRaw(uint8_t* buf, size_t size);
+
+    /**
+     * @brief Wait until the socket is readable or writable
+     */
+    bool waitFd(bool forWrite, int timeoutMs);
+
+    int sockfd;
+
+private:
+    /**
+     * @brief Pull whatever is pending on the socket into rxBuffer
+     */
+    void fillBuffer();
+
+    std::vector<uint8_t> rxBuffer;
+    size_t rxPos;
+    bool peerClosed;
+};
+
+#endif // WIFI_CLIENT_SHIM_H
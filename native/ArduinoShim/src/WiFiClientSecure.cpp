@@ -0,0 +1,158 @@
+/**
+ * @file WiFiClientSecure.cpp
+ * @brief TLS Client Shim Implementation
+ */
+
+#include "WiFiClientSecure.h"
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+WiFiClientSecure::WiFiClientSecure()
+    : ctx(nullptr)
+    , ssl(nullptr)
+    , insecure(false)
+    , handshakeTimeoutMs(120000)
+    , lastSslError(0) {
+}
+
+WiFiClientSecure::~WiFiClientSecure() {
+    stop();
+    if (ctx) {
+        SSL_CTX_free(ctx);
+    }
+}
+
+void WiFiClientSecure::setInsecure() {
+    insecure = true;
+    if (ctx) {
+        SSL_CTX_free(ctx);
+        ctx = nullptr;
+    }
+}
+
+void WiFiClientSecure::setCACert(const char* rootCA) {
+    caCert = rootCA ? rootCA : "";
+    insecure = false;
+    if (ctx) {
+        SSL_CTX_free(ctx);
+        ctx = nullptr;
+    }
+}
+
+bool WiFiClientSecure::onConnected(const char* host, int32_t timeoutMs) {
+    if (!ctx) {
+        ctx = SSL_CTX_new(TLS_client_method());
+        if (!ctx) {
+            return false;
+        }
+
+        if (insecure) {
+            SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+        } else {
+            SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+            if (!caCert.isEmpty()) {
+                // Bundles of several certificates work like on the ESP32
+                BIO* bio = BIO_new_mem_buf(caCert.c_str(), static_cast<int>(caCert.length()));
+                while (X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr)) {
+                    X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx), cert);
+                    X509_free(cert);
+                }
+                ERR_clear_error();
+                BIO_free(bio);
+            } else {
+                SSL_CTX_set_default_verify_paths(ctx);
+            }
+        }
+    }
+
+    ssl = SSL_new(ctx);
+    if (!ssl) {
+        return false;
+    }
+
+    SSL_set_fd(ssl, sockfd);
+    SSL_set_tlsext_host_name(ssl, host);
+    if (!insecure) {
+        // mbedTLS checks the name against the certificate too
+        SSL_set1_host(ssl, host);
+    }
+
+    unsigned long limit = timeoutMs > 0 ? static_cast<unsigned long>(timeoutMs) : handshakeTimeoutMs;
+    unsigned long start = millis();
+
+    for (;;) {
+        int rc = SSL_connect(ssl);
+        if (rc == 1) {
+            return true;
+        }
+
+        int err = SSL_get_error(ssl, rc);
+        if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) {
+            lastSslError = ERR_get_error();
+            return false;
+        }
+        if (millis() - start > limit) {
+            return false;
+        }
+        waitFd(err == SSL_ERROR_WANT_WRITE, 10);
+    }
+}
+
+void WiFiClientSecure::onStop() {
+    if (ssl) {
+        SSL_shutdown(ssl);
+        SSL_free(ssl);
+        ssl = nullptr;
+    }
+}
+
+int WiFiClientSecure::sendRaw(const uint8_t* buf, size_t size) {
+    if (!ssl) {
+        return -1;
+    }
+
+    int n = SSL_write(ssl, buf, static_cast<int>(size));
+    if (n > 0) {
+        return n;
+    }
+
+    int err = SSL_get_error(ssl, n);
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+        return 0;
+    }
+    lastSslError = ERR_get_error();
+    return -1;
+}
+
+int WiFiClientSecure::recvRaw(uint8_t* buf, size_t size) {
+    if (!ssl) {
+        return -2;
+    }
+
+    int n = SSL_read(ssl, buf, static_cast<int>(size));
+    if (n > 0) {
+        return n;
+    }
+
+    int err = SSL_get_error(ssl, n);
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+        return -1;
+    }
+    if (err == SSL_ERROR_ZERO_RETURN) {
+        return 0;
+    }
+    lastSslError = ERR_get_error();
+    return -2;
+}
+
+int WiFiClientSecure::lastError(char* buf, const size_t size) {
+    if (!lastSslError) {
+        return 0;
+    }
+    ERR_error_string_n(lastSslError, buf, size);
+    return -static_cast<int>(lastSslError);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file WiFiClientSecure.h
+ * @brief TLS Client Shim (OpenSSL)
+ */
+
+#ifndef WIFI_CLIENT_SECURE_SHIM_H
+#define WIFI_CLIENT_SECURE_SHIM_H
+
+#include "WiFiClient.h"
+
+typedef struct ssl_st SSL;
+typedef struct ssl_ctx_st SSL_CTX;
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    WiFiClientSecure();
+    ~WiFiClientSecure() override;
+
+    /**
+     * @brief Skip certificate verification
+     */
+    void setInsecure();
+
+    /**
+     * @brief Verify the server against PEM root certificates
+     *
+     * nullptr verifies against the system certificates.
+     */
+    void setCACert(const char* rootCA);
+
+    /**
+     * @brief Handshake timeout in seconds (ESP32 API)
+     */
+    void setHandshakeTimeout(unsigned long seconds) { handshakeTimeoutMs = seconds * 1000; }
+
+    int lastError(char* buf, const size_t size);
+
+protected:
+    bool onConnected(const char* host, int32_t timeoutMs) override;
+    void onStop() override;
+    int sendRaw(const uint8_t* buf, size_t size) override;
+    int recvRaw(uint8_t* buf, size_t size) override;
+
+private:
+    SSL_CTX* ctx;
+    SSL* ssl;
+    String caCert;
+    bool insecure;
+    unsigned long handshakeTimeoutMs;
+    unsigned long lastSslError;
+};
+
+#endif // WIFI_CLIENT_SECURE_SHIM_H
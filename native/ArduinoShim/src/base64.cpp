@@ -0,0 +1,64 @@
+/**
+ * @file base64.cpp
+ * @brief Base64 Shim Implementation
+ */
+
+#include "base64.h"
+
+namespace {
+
+const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int decodeChar(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+' || c == '-') return 62;
+    if (c == '/' || c == '_') return 63;
+    return -1;
+}
+
+} // namespace
+
+String base64::encode(const uint8_t* data, size_t length) {
+    String out;
+    out.reserve(((length + 2) / 3) * 4);
+
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t n = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < length) n |= static_cast<uint32_t>(data[i + 1]) << 8;
+        if (i + 2 < length) n |= data[i + 2];
+
+        out += alphabet[(n >> 18) & 0x3F];
+        out += alphabet[(n >> 12) & 0x3F];
+        out += i + 1 < length ? alphabet[(n >> 6) & 0x3F] : '=';
+        out += i + 2 < length ? alphabet[n & 0x3F] : '=';
+    }
+
+    return out;
+}
+
+String base64::encode(const String& text) {
+    return encode(reinterpret_cast<const uint8_t*>(text.c_str()), text.length());
+}
+
+String base64::decode(const String& text) {
+    String out;
+    uint32_t accumulator = 0;
+    int bits = 0;
+
+    for (unsigned int i = 0; i < text.length(); i++) {
+        int value = decodeChar(text[i]);
+        if (value < 0) {
+            continue;
+        }
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out += static_cast<char>((accumulator >> bits) & 0xFF);
+        }
+    }
+
+    return out;
+}
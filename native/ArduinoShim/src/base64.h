@@ -0,0 +1,20 @@
+/**
+ * @file base64.h
+ * @brief Base64 Shim (ESP32 core API)
+ */
+
+#ifndef BASE64_SHIM_H
+#define BASE64_SHIM_H
+
+#include <cstddef>
+#include <cstdint>
+#include "WString.h"
+
+class base64 {
+public:
+    static String encode(const uint8_t* data, size_t length);
+    static String encode(const String& text);
+    static String decode(const String& text);
+};
+
+#endif // BASE64_SHIM_H
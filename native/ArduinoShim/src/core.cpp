@@ -0,0 +1,90 @@
+/**
+ * @file core.cpp
+ * @brief Arduino Core Shim: timing, random numbers, GPIO stubs
+ */
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point startTime = Clock::now();
+
+std::mt19937& rng() {
+    static std::mt19937 engine(std::random_device{}());
+    return engine;
+}
+
+} // namespace
+
+unsigned long millis() {
+    return static_cast<unsigned long>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count());
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime).count());
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long random(long max) {
+    return random(0, max);
+}
+
+long random(long min, long max) {
+    if (min >= max) {
+        return min;
+    }
+    std::uniform_int_distribution<long> dist(min, max - 1);
+    return dist(rng());
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        rng().seed(static_cast<std::mt19937::result_type>(seed));
+    }
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) {
+        return outMin;
+    }
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    (void)pin;
+    (void)val;
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    return LOW;
+}
+
+int analogRead(uint8_t pin) {
+    (void)pin;
+    return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief ESP-IDF Capability Heap Shim
+ *
+ * All capabilities map onto the host heap. PSRAM requests succeed so the
+ * host build follows the same code path as a board with PSRAM.
+ */
+
+#ifndef ESP_HEAP_CAPS_SHIM_H
+#define ESP_HEAP_CAPS_SHIM_H
+
+#include <cstddef>
+#include <cstdlib>
+
+#define MALLOC_CAP_EXEC      (1 << 0)
+#define MALLOC_CAP_32BIT     (1 << 1)
+#define MALLOC_CAP_8BIT      (1 << 2)
+#define MALLOC_CAP_DMA       (1 << 3)
+#define MALLOC_CAP_SPIRAM    (1 << 10)
+#define MALLOC_CAP_INTERNAL  (1 << 11)
+#define MALLOC_CAP_DEFAULT   (1 << 12)
+
+inline void* heap_caps_malloc(size_t size, unsigned int caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+inline void* heap_caps_calloc(size_t n, size_t size, unsigned int caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+inline void* heap_caps_realloc(void* ptr, size_t size, unsigned int caps) {
+    (void)caps;
+    return realloc(ptr, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+inline void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+#endif // ESP_HEAP_CAPS_SHIM_H
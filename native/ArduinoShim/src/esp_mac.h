@@ -0,0 +1,24 @@
+/**
+ * @file esp_mac.h
+ * @brief ESP-IDF MAC Address Shim
+ */
+
+#ifndef ESP_MAC_SHIM_H
+#define ESP_MAC_SHIM_H
+
+#include <cstdint>
+#include "esp_system.h"
+
+typedef enum {
+    ESP_MAC_WIFI_STA,
+    ESP_MAC_WIFI_SOFTAP,
+    ESP_MAC_BT,
+    ESP_MAC_ETH
+} esp_mac_type_t;
+
+/**
+ * @brief Fixed, locally administered MAC so the device ID is stable on the host
+ */
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type);
+
+#endif // ESP_MAC_SHIM_H
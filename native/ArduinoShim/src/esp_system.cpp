@@ -0,0 +1,28 @@
+/**
+ * @file esp_system.cpp
+ * @brief ESP-IDF System Shim Implementation
+ */
+
+#include "esp_system.h"
+#include "esp_mac.h"
+#include "Esp.h"
+
+#include <random>
+
+uint32_t esp_random() {
+    static std::random_device device;
+    return device();
+}
+
+uint32_t esp_get_free_heap_size() {
+    return ESP.getFreeHeap();
+}
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type) {
+    static const uint8_t base[6] = {0x02, 0x00, 0x5E, 0x10, 0x00, 0x00};
+    for (int i = 0; i < 6; i++) {
+        mac[i] = base[i];
+    }
+    mac[5] += static_cast<uint8_t>(type);
+    return ESP_OK;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file esp_system.h
+ * @brief ESP-IDF System Shim
+ */
+
+#ifndef ESP_SYSTEM_SHIM_H
+#define ESP_SYSTEM_SHIM_H
+
+#include <cstdint>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+uint32_t esp_random();
+uint32_t esp_get_free_heap_size();
+
+#endif // ESP_SYSTEM_SHIM_H
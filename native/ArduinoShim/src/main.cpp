@@ -0,0 +1,39 @@
+/**
+ * @file main.cpp
+ * @brief Native Entry Point
+ *
+ * Mirrors the Arduino core: call setup() once, then loop() forever.
+ */
+
+#include "Arduino.h"
+
+#include <csignal>
+
+namespace {
+
+volatile std::sig_atomic_t running = 1;
+
+void onSignal(int) {
+    running = 0;
+}
+
+} // namespace
+
+int main() {
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Line-buffer Serial so logs show up promptly when piped
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    setup();
+
+    while (running) {
+        loop();
+    }
+
+    Serial.println("\n👋 Native build stopped");
+    Serial.flush();
+    return 0;
+}
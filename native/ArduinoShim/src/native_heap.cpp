@@ -0,0 +1,123 @@
+/**
+ * @file native_heap.cpp
+ * @brief Host Heap Accounting Implementation
+ *
+ * Wraps glibc's allocator. malloc_usable_size() gives the block size on
+ * free, so no per-block header is needed.
+ */
+
+#include "native_heap.h"
+
+#include <atomic>
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+std::atomic<uint64_t> allocCount{0};
+std::atomic<uint64_t> freeCount{0};
+std::atomic<size_t> liveBytes{0};
+std::atomic<size_t> peakBytes{0};
+
+void trackAlloc(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    size_t live = liveBytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed) +
+                  malloc_usable_size(ptr);
+    size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void trackFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+} // namespace
+
+extern "C" {
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    trackAlloc(ptr);
+    return ptr;
+}
+
+void* calloc(size_t n, size_t size) {
+    void* ptr = __libc_calloc(n, size);
+    trackAlloc(ptr);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    trackFree(ptr);
+    void* result = __libc_realloc(ptr, size);
+    if (!result && ptr && size > 0) {
+        // Original block is still valid
+        trackAlloc(ptr);
+        return nullptr;
+    }
+    trackAlloc(result);
+    return result;
+}
+
+void* memalign(size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    trackAlloc(ptr);
+    return ptr;
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return 12;  // ENOMEM
+    }
+    trackAlloc(ptr);
+    *out = ptr;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+void free(void* ptr) {
+    trackFree(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+uint64_t native_heap_alloc_count() {
+    return allocCount.load(std::memory_order_relaxed);
+}
+
+uint64_t native_heap_free_count() {
+    return freeCount.load(std::memory_order_relaxed);
+}
+
+size_t native_heap_live_bytes() {
+    return liveBytes.load(std::memory_order_relaxed);
+}
+
+size_t native_heap_peak_bytes() {
+    return peakBytes.load(std::memory_order_relaxed);
+}
+
+void native_heap_reset_peak() {
+    peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
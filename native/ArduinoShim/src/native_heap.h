@@ -0,0 +1,42 @@
+/**
+ * @file native_heap.h
+ * @brief Host Heap Accounting
+ *
+ * The shim interposes malloc/free so every heap allocation made by the
+ * process (String, std::vector, ArduinoJson, LVGL, ...) is counted.
+ * Used by EspClass to emulate ESP.getFreeHeap() and by profiling code
+ * to count allocations on a code path.
+ */
+
+#ifndef NATIVE_HEAP_H
+#define NATIVE_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Total number of successful allocations since start
+ */
+uint64_t native_heap_alloc_count();
+
+/**
+ * @brief Total number of frees since start
+ */
+uint64_t native_heap_free_count();
+
+/**
+ * @brief Bytes currently allocated
+ */
+size_t native_heap_live_bytes();
+
+/**
+ * @brief Highest value of native_heap_live_bytes() since start or last reset
+ */
+size_t native_heap_peak_bytes();
+
+/**
+ * @brief Reset the peak to the current live byte count
+ */
+void native_heap_reset_peak();
+
+#endif // NATIVE_HEAP_H
@@ -0,0 +1,23 @@
+/**
+ * @file sha.cpp
+ * @brief ESP32 SHA Engine Shim Implementation
+ */
+
+#include "sha/sha_parallel_engine.h"
+
+#include <openssl/evp.h>
+
+void esp_sha(esp_sha_type type, const unsigned char* input, size_t ilen, unsigned char* output) {
+    const EVP_MD* md = nullptr;
+
+    switch (type) {
+        case SHA1:     md = EVP_sha1(); break;
+        case SHA2_224: md = EVP_sha224(); break;
+        case SHA2_256: md = EVP_sha256(); break;
+        case SHA2_384: md = EVP_sha384(); break;
+        case SHA2_512: md = EVP_sha512(); break;
+        default: return;
+    }
+
+    EVP_Digest(input, ilen, output, nullptr, md, nullptr);
+}
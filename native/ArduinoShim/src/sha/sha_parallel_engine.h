@@ -0,0 +1,22 @@
+/**
+ * @file sha_parallel_engine.h
+ * @brief ESP32 SHA Engine Shim (OpenSSL-backed)
+ */
+
+#ifndef SHA_PARALLEL_ENGINE_SHIM_H
+#define SHA_PARALLEL_ENGINE_SHIM_H
+
+#include <cstddef>
+
+typedef enum {
+    SHA1 = 0,
+    SHA2_224,
+    SHA2_256,
+    SHA2_384,
+    SHA2_512,
+    SHA_TYPE_MAX
+} esp_sha_type;
+
+void esp_sha(esp_sha_type type, const unsigned char* input, size_t ilen, unsigned char* output);
+
+#endif // SHA_PARALLEL_ENGINE_SHIM_H
@@ -8,9 +8,13 @@
 // Include subsystem headers
 #include "../config/Config.hpp"
 #include "../network/WiFiManager.hpp"
+#include "../network/ConnectionPool.hpp"
+#include "../network/RequestQueue.hpp"
 #include "../display/DisplayManager.hpp"
 #include "../spotify/SpotifyClient.hpp"
 #include "../spotify/AuthManager.hpp"
+#include "../spotify/SearchEngine.hpp"
+#include "../spotify/AlbumArtLoader.hpp"
 #include "../ui/WindowManager.hpp"
 #include "../ui/screens/NowPlaying.hpp"
 
@@ -24,17 +28,21 @@ App::App()
     , displayManager(nullptr)
     , authManager(nullptr)
     , spotifyClient(nullptr)
-    , windowManager(nullptr) {
+    , searchEngine(nullptr)
+    , albumArtLoader(nullptr)
+    , windowManager(nullptr)
+    , pollInFlight(false) {
 }
 
 App::~App() {
     // Cleanup subsystems in reverse order
+    // (DisplayManager and ConfigManager are singletons and not owned here)
     delete windowManager;
+    delete albumArtLoader;
+    delete searchEngine;
     delete spotifyClient;
     delete authManager;
-    delete displayManager;
     delete wifiManager;
-    delete configManager;
 }
 
 bool App::init() {
@@ -86,7 +94,12 @@ bool App::init() {
     registerEventHandlers();
 
     initialized = true;
-    setState(AppState::READY);
+
+    // With stored tokens go straight to now playing, otherwise wait for auth
+    if (state != AppState::AUTH_REQUIRED) {
+        setState(AppState::READY);
+        setState(AppState::NOW_PLAYING);
+    }
 
     Serial.println("\n========================================");
     Serial.println("  🎵 Spotify Controller Ready!");
@@ -103,29 +116,66 @@ void App::loop() {
     // Execute scheduled tasks
     executeScheduledTasks();
 
-    // Update window manager (LVGL tasks)
+    // Run completion callbacks of finished background requests
+    RequestQueue::getInstance().update();
+
+    // Update window manager (screen state)
     if (windowManager) {
         windowManager->update();
     }
 
+    // Run LVGL timers and rendering
+    if (displayManager) {
+        displayManager->update();
+    }
+
     // Poll WiFi status
     if (wifiManager) {
         wifiManager->update();
     }
 
-    // Poll Spotify status (periodically)
-    if (spotifyClient && state == AppState::NOW_PLAYING) {
-        static unsigned long lastPoll = 0;
-        if (millis() - lastPoll >= SPOTIFY_POLL_INTERVAL_MS) {
-            spotifyClient->updateNowPlaying();
-            lastPoll = millis();
+    // Close idle HTTPS connections
+    ConnectionPool::getInstance().update();
+
+    // Serve the OAuth callback while authenticating
+    if (authManager) {
+        authManager->update();
+
+        // Hand the tokens from the OAuth callback to the client
+        if (state == AppState::AUTH_REQUIRED && spotifyClient && authManager->isAuthenticated()) {
+            spotifyClient->setTokens(authManager->getAccessToken(),
+                                     authManager->getRefreshToken(),
+                                     authManager->getMsUntilExpiry());
+            eventBus.publish(Event(EventType::SPOTIFY_AUTHENTICATED));
         }
     }
+
+    // Refresh the access token before it expires
+    if (spotifyClient) {
+        spotifyClient->update();
+    }
+
+    // Send searches once typing pauses
+    if (searchEngine) {
+        searchEngine->update();
+    }
+
+    // Poll Spotify status when the scheduler says it's time, after any
+    // command in flight (a poll sent next to it may see the old state)
+    if (spotifyClient && state == AppState::NOW_PLAYING && !pollInFlight &&
+        !RequestQueue::getInstance().hasUserRequests() &&
+        spotifyClient->isPollDue(isScreenIdle())) {
+        SpotifyClient* spotify = spotifyClient;
+        pollInFlight = RequestQueue::getInstance().submit(
+            [spotify]() { return spotify->updateNowPlaying(); },
+            [this](bool) { pollInFlight = false; },
+            RequestPriority::BACKGROUND);
+    }
 }
 
 void App::setState(AppState newState) {
     if (state != newState) {
-        Serial.printf("🔄 State change: %d -> %d\n", state, newState);
+        Serial.printf("🔄 State change: %d -> %d\n", static_cast<int>(state), static_cast<int>(newState));
         state = newState;
 
         // Publish state change event
@@ -149,7 +199,7 @@ void App::refreshUI() {
 // Initialization methods
 
 bool App::initConfig() {
-    configManager = new ConfigManager();
+    configManager = &ConfigManager::getInstance();
     return configManager->init();
 }
 
@@ -201,6 +251,14 @@ bool App::initSpotify() {
 
     // Create Spotify client
     spotifyClient = new SpotifyClient(authManager);
+    spotifyClient->setEventBus(&eventBus);
+    searchEngine = new SearchEngine(spotifyClient);
+    albumArtLoader = new AlbumArtLoader(spotifyClient);
+
+    // API requests run on their own task
+    if (!RequestQueue::getInstance().begin()) {
+        return false;
+    }
 
     // Check if we have stored tokens
     if (configManager->hasStoredTokens()) {
@@ -220,8 +278,11 @@ bool App::initSpotify() {
     eventBus.subscribe(EventType::SPOTIFY_AUTH_ERROR,
         [this](const Event& e) { this->onSpotifyAuthError(); });
 
+    eventBus.subscribe(EventType::TOKEN_REFRESHED,
+        [this](const Event& e) { this->onTokenRefreshed(); });
+
     eventBus.subscribe(EventType::PLAYBACK_CHANGED,
-        [this](const Event& e) { this->onPlaybackChanged(); });
+        [this](const Event& e) { this->onPlaybackChanged(static_cast<uint32_t>(e.intValue)); });
 
     eventBus.subscribe(EventType::TRACK_CHANGED,
         [this](const Event& e) { this->onTrackChanged(); });
@@ -230,7 +291,7 @@ bool App::initSpotify() {
 }
 
 bool App::initUI() {
-    windowManager = new ui::WindowManager(displayManager);
+    windowManager = new WindowManager(displayManager);
     windowManager->init();
 
     // Show initial screen based on state
@@ -253,10 +314,18 @@ void App::onWiFiConnected() {
     if (state == AppState::AUTH_REQUIRED && authManager) {
         authManager->startAuthServer();
     }
+
+    // Hosts that failed while offline are worth trying right away
+    if (spotifyClient) {
+        spotifyClient->resetCircuits();
+    }
 }
 
 void App::onWiFiDisconnected() {
     Serial.println("📶 WiFi disconnected, attempting to reconnect...");
+
+    // Sockets don't survive a reconnect
+    ConnectionPool::getInstance().closeAll();
 }
 
 void App::onSpotifyAuthenticated() {
@@ -287,7 +356,21 @@ void App::onSpotifyAuthError() {
     }
 }
 
-void App::onPlaybackChanged() {
+void App::onTokenRefreshed() {
+    // Keep the stored tokens current, Spotify may rotate the refresh token
+    if (spotifyClient && configManager) {
+        configManager->saveTokens(
+            spotifyClient->getAccessToken(),
+            spotifyClient->getRefreshToken()
+        );
+    }
+}
+
+void App::onPlaybackChanged(uint32_t changes) {
+    if (changes & SpotifyClient::CHANGED_QUEUE) {
+        prefetchUpcomingCovers();
+    }
+
     // Refresh UI
     refreshUI();
 }
@@ -297,6 +380,32 @@ void App::onTrackChanged() {
     refreshUI();
 }
 
+void App::prefetchUpcomingCovers() {
+    if (!spotifyClient || !albumArtLoader) {
+        return;
+    }
+
+    // Queued behind everything else, the next track change finds them in PSRAM
+    SpotifyClient::TrackInfo track;
+    for (size_t i = 0; i < SPOTIFY_QUEUE_PREFETCH; i++) {
+        if (!spotifyClient->getUpcomingTrack(i, track)) {
+            break;
+        }
+        if (!track.coverUrl.isEmpty()) {
+            albumArtLoader->prefetch(track.albumId, track.coverUrl.c_str());
+        }
+    }
+}
+
+bool App::isScreenIdle() const {
+    if (!configManager) {
+        return false;
+    }
+
+    unsigned long timeoutMs = configManager->getScreensaverTimeout() * 60000UL;
+    return lv_display_get_inactive_time(NULL) >= timeoutMs;
+}
+
 void App::registerEventHandlers() {
     // Already registered in init methods
 }
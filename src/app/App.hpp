@@ -20,12 +20,14 @@
 // Forward declarations
 class DisplayManager;
 class SpotifyClient;
+class SearchEngine;
+class AlbumArtLoader;
 class WiFiManager;
 class AuthManager;
 class ConfigManager;
+class WindowManager;
 
 namespace ui {
-    class WindowManager;
     class NowPlayingScreen;
 }
 
@@ -84,6 +86,16 @@ public:
      */
     SpotifyClient* getSpotifyClient() { return spotifyClient; }
 
+    /**
+     * @brief Get the type-ahead search engine
+     */
+    SearchEngine* getSearchEngine() { return searchEngine; }
+
+    /**
+     * @brief Get the album art downloader
+     */
+    AlbumArtLoader* getAlbumArtLoader() { return albumArtLoader; }
+
     /**
      * @brief Get the WiFi manager
      */
@@ -131,13 +143,25 @@ private:
      */
     void onSpotifyAuthenticated();
     void onSpotifyAuthError();
+    void onTokenRefreshed();
 
     /**
      * @brief Handle playback state changes
+     * @param changes SpotifyClient::StateChange bits
      */
-    void onPlaybackChanged();
+    void onPlaybackChanged(uint32_t changes);
     void onTrackChanged();
 
+    /**
+     * @brief Get the covers of the upcoming tracks ready
+     */
+    void prefetchUpcomingCovers();
+
+    /**
+     * @brief Check if nobody has touched the screen for the screensaver timeout
+     */
+    bool isScreenIdle() const;
+
     /**
      * @brief Register event handlers
      */
@@ -160,7 +184,9 @@ private:
     DisplayManager* displayManager;
     AuthManager* authManager;
     SpotifyClient* spotifyClient;
-    ui::WindowManager* windowManager;
+    SearchEngine* searchEngine;
+    AlbumArtLoader* albumArtLoader;
+    WindowManager* windowManager;
 
     // Task scheduling
     struct ScheduledTask {
@@ -168,6 +194,9 @@ private:
         unsigned long executeTime;
     };
     std::vector<ScheduledTask> scheduledTasks;
+
+    // A now playing poll is queued or running
+    bool pollInFlight;
 };
 
 #endif // APP_HPP
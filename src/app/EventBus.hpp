@@ -9,6 +9,7 @@
 #ifndef EVENT_BUS_HPP
 #define EVENT_BUS_HPP
 
+#include <Arduino.h>
 #include "State.hpp"
 #include <vector>
 #include <functional>
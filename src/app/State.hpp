@@ -6,6 +6,12 @@
 #ifndef STATE_HPP
 #define STATE_HPP
 
+#include <Arduino.h>
+#include "../utils/FixedString.hpp"
+
+// Longest Event::stringValue (longer text is cut off)
+#define EVENT_STRING_LENGTH 63
+
 /**
  * @brief Application States
  */
@@ -36,6 +42,8 @@ enum class EventType {
     SPOTIFY_AUTHENTICATED,
     SPOTIFY_AUTH_ERROR,
     TOKEN_REFRESHED,
+    SPOTIFY_UNREACHABLE,    // API requests fail (also on every rejected command)
+    SPOTIFY_REACHABLE,
 
     // Playback events
     PLAYBACK_CHANGED,
@@ -61,13 +69,16 @@ struct Event {
     EventType type;
     int intValue;
     float floatValue;
-    String stringValue;
+    FixedString<EVENT_STRING_LENGTH> stringValue;
     void* userData;
 
     // Constructors
     explicit Event(EventType t, int i = 0)
         : type(t), intValue(i), floatValue(0.0f), userData(nullptr) {}
 
+    Event(EventType t, const char* s)
+        : type(t), intValue(0), floatValue(0.0f), stringValue(s), userData(nullptr) {}
+
     Event(EventType t, const String& s)
         : type(t), intValue(0), floatValue(0.0f), stringValue(s), userData(nullptr) {}
 
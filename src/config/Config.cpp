@@ -135,7 +135,7 @@ void ConfigManager::generateDeviceId() {
     uint8_t mac[6];
     esp_read_mac(mac, ESP_MAC_WIFI_STA);
 
-    char deviceId[13];
+    char deviceId[16];
     sprintf(deviceId, "ESP%02X%02X%02X%02X%02X%02X",
             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
     config.device.deviceId = String(deviceId);
@@ -146,14 +146,14 @@ void ConfigManager::generateDeviceId() {
 bool ConfigManager::parseFromJson(const JsonDocument& doc) {
     // WiFi
     if (doc.containsKey("wifi")) {
-        JsonObject wifi = doc["wifi"];
+        JsonObjectConst wifi = doc["wifi"];
         config.wifi.ssid = wifi["ssid"] | DEFAULT_WIFI_SSID;
         config.wifi.password = wifi["password"] | DEFAULT_WIFI_PASSWORD;
     }
 
     // Spotify
     if (doc.containsKey("spotify")) {
-        JsonObject spotify = doc["spotify"];
+        JsonObjectConst spotify = doc["spotify"];
         config.spotify.clientId = spotify["client_id"] | DEFAULT_SPOTIFY_CLIENT_ID;
         config.spotify.clientSecret = spotify["client_secret"] | DEFAULT_SPOTIFY_CLIENT_SECRET;
         config.spotify.accessToken = spotify["access_token"] | "";
@@ -162,12 +162,12 @@ bool ConfigManager::parseFromJson(const JsonDocument& doc) {
 
     // Display
     if (doc.containsKey("display")) {
-        JsonObject display = doc["display"];
+        JsonObjectConst display = doc["display"];
         config.display.orientation = display["orientation"] | DEFAULT_DISPLAY_ORIENTATION;
         config.display.brightness = display["brightness"] | DEFAULT_BRIGHTNESS;
 
         if (display.containsKey("screensaver")) {
-            JsonObject screensaver = display["screensaver"];
+            JsonObjectConst screensaver = display["screensaver"];
             config.display.screensaver.enabled = screensaver["enabled"] | true;
             config.display.screensaver.timeoutMinutes = screensaver["timeout_minutes"] | DEFAULT_SCREENSAVER_TIMEOUT;
         }
@@ -175,13 +175,13 @@ bool ConfigManager::parseFromJson(const JsonDocument& doc) {
 
     // Volume
     if (doc.containsKey("volume")) {
-        JsonObject volume = doc["volume"];
+        JsonObjectConst volume = doc["volume"];
         config.volume.limit = volume["limit"] | DEFAULT_VOLUME_LIMIT;
     }
 
     // Device
     if (doc.containsKey("device")) {
-        JsonObject device = doc["device"];
+        JsonObjectConst device = doc["device"];
         config.device.deviceId = device["device_id"] | "";
     }
 
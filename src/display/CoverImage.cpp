@@ -0,0 +1,92 @@
+/**
+ * @file CoverImage.cpp
+ * @brief Decoded Album Art Implementation
+ */
+
+#include "CoverImage.hpp"
+
+CoverImage::CoverImage()
+    : pixels(nullptr)
+    , valid(false) {
+    memset(&descriptor, 0, sizeof(descriptor));
+}
+
+CoverImage::~CoverImage() {
+    release();
+}
+
+bool CoverImage::allocate(int width, int height) {
+    valid = false;
+
+    if (pixels && getWidth() == width && getHeight() == height) {
+        return true;
+    }
+
+    release();
+
+    // 97 KB for a 220x220 cover, too much for internal RAM
+    size_t size = sizeof(uint16_t) * width * height;
+    pixels = (uint16_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!pixels) {
+        Serial.printf("❌ No memory for a %dx%d cover\n", width, height);
+        return false;
+    }
+
+    descriptor.header.magic = LV_IMAGE_HEADER_MAGIC;
+    descriptor.header.cf = LV_COLOR_FORMAT_RGB565;
+    descriptor.header.w = width;
+    descriptor.header.h = height;
+    descriptor.header.stride = width * sizeof(uint16_t);
+    descriptor.data_size = size;
+    descriptor.data = reinterpret_cast<const uint8_t*>(pixels);
+    return true;
+}
+
+bool CoverImage::scaleFrom(const CoverImage& source, int width, int height) {
+    if (!source.isValid() || width > source.getWidth() || height > source.getHeight() ||
+        !allocate(width, height)) {
+        return false;
+    }
+
+    int sourceWidth = source.getWidth();
+    int sourceHeight = source.getHeight();
+    const uint16_t* in = source.getPixels();
+
+    for (int y = 0; y < height; y++) {
+        int top = y * sourceHeight / height;
+        int bottom = (y + 1) * sourceHeight / height;
+
+        for (int x = 0; x < width; x++) {
+            int left = x * sourceWidth / width;
+            int right = (x + 1) * sourceWidth / width;
+
+            uint32_t red = 0, green = 0, blue = 0;
+            for (int sy = top; sy < bottom; sy++) {
+                const uint16_t* row = in + sy * sourceWidth;
+                for (int sx = left; sx < right; sx++) {
+                    red += row[sx] >> 11;
+                    green += (row[sx] >> 5) & 0x3F;
+                    blue += row[sx] & 0x1F;
+                }
+            }
+
+            uint32_t count = (bottom - top) * (right - left);
+            pixels[y * width + x] = static_cast<uint16_t>(
+                (((red + count / 2) / count) << 11) |
+                (((green + count / 2) / count) << 5) |
+                ((blue + count / 2) / count));
+        }
+    }
+
+    valid = true;
+    return true;
+}
+
+// Private methods
+
+void CoverImage::release() {
+    heap_caps_free(pixels);
+    pixels = nullptr;
+    valid = false;
+    memset(&descriptor, 0, sizeof(descriptor));
+}
@@ -0,0 +1,84 @@
+/**
+ * @file CoverImage.hpp
+ * @brief Decoded Album Art
+ *
+ * An RGB565 bitmap in PSRAM together with the LVGL image descriptor
+ * that points at it, so it can be passed to lv_image_set_src() as is.
+ */
+
+#ifndef COVER_IMAGE_HPP
+#define COVER_IMAGE_HPP
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * @brief Cover Image Class
+ *
+ * The pixels stay allocated until the image is destroyed or allocated
+ * at a different size, an image shown by a widget must outlive it.
+ */
+class CoverImage {
+public:
+    CoverImage();
+    ~CoverImage();
+
+    // Owns the pixels
+    CoverImage(const CoverImage&) = delete;
+    CoverImage& operator=(const CoverImage&) = delete;
+
+    /**
+     * @brief Make room for width x height pixels
+     *
+     * Keeps the buffer if the size didn't change. The image is invalid
+     * until setValid() is called.
+     * @return false if out of memory
+     */
+    bool allocate(int width, int height);
+
+    /**
+     * @brief Fill the image with a smaller copy of another (thumbnails)
+     *
+     * Each pixel is the average of the source pixels it covers.
+     * @return false if out of memory or source isn't valid
+     */
+    bool scaleFrom(const CoverImage& source, int width, int height);
+
+    /**
+     * @brief Mark the pixels as filled in (or not)
+     */
+    void setValid(bool valid) { this->valid = valid && pixels; }
+
+    /**
+     * @brief Check if the pixels hold a decoded cover
+     */
+    bool isValid() const { return valid; }
+
+    /**
+     * @brief Get the pixels, width * height RGB565 values row after row
+     */
+    uint16_t* getPixels() { return pixels; }
+    const uint16_t* getPixels() const { return pixels; }
+
+    int getWidth() const { return descriptor.header.w; }
+    int getHeight() const { return descriptor.header.h; }
+
+    /**
+     * @brief Get the size of the pixels in bytes
+     */
+    size_t getBytes() const { return descriptor.data_size; }
+
+    /**
+     * @brief Get the image source for lv_image_set_src()
+     */
+    const lv_image_dsc_t* getDescriptor() const { return &descriptor; }
+
+private:
+    void release();
+
+    uint16_t* pixels;
+    bool valid;
+    lv_image_dsc_t descriptor;
+};
+
+#endif // COVER_IMAGE_HPP
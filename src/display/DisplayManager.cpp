@@ -6,6 +6,10 @@
 #include "DisplayManager.hpp"
 #include "../config/Config.hpp"
 
+#ifdef NATIVE_BUILD
+// Host build has no panel or touch controller
+#include "drivers/HeadlessDisplay.hpp"
+#else
 // Include display drivers
 #include "drivers/ILI9341Display.hpp"
 #include "drivers/ILI9488Display.hpp"
@@ -15,6 +19,7 @@
 // Include touch drivers
 #include "drivers/FT6236Touch.hpp"
 #include "drivers/XPT2046Touch.hpp"
+#endif
 
 // Logging
 #define LOG_TAG "DisplayMgr"
@@ -79,6 +84,9 @@ bool DisplayManager::init() {
 }
 
 bool DisplayManager::createDisplayDriver() {
+#ifdef NATIVE_BUILD
+    displayImpl = new HeadlessDisplay(DEFAULT_DISPLAY_WIDTH, DEFAULT_DISPLAY_HEIGHT);
+#else
     // Auto-detect or use specified type
     switch (DISPLAY_TYPE) {
         case DISPLAY_TYPE_ILI9341:
@@ -121,6 +129,7 @@ bool DisplayManager::createDisplayDriver() {
             }
             break;
     }
+#endif
 
     // Initialize the display
     if (!displayImpl->init()) {
@@ -144,6 +153,9 @@ bool DisplayManager::createDisplayDriver() {
 }
 
 bool DisplayManager::createTouchDriver() {
+#ifdef NATIVE_BUILD
+    return false;
+#else
     // Try FT6236 first (capacitive, common on newer displays)
     touchImpl = new FT6236Touch();
     if (touchImpl->init()) {
@@ -162,6 +174,7 @@ bool DisplayManager::createTouchDriver() {
 
     touchImpl = nullptr;
     return false;
+#endif
 }
 
 bool DisplayManager::initLVGL() {
@@ -188,8 +201,8 @@ bool DisplayManager::initLVGL() {
         return false;
     }
 
+    lv_display_set_user_data(display, this);
     lv_display_set_flush_cb(display, flushCallback);
-    lv_display_set_flush_ready_cb(display, flushReadyCallback);
     lv_display_set_buffers(display, buf1, nullptr, bufferSize, LV_DISPLAY_RENDER_MODE_PARTIAL);
 
     // Create input device driver
@@ -197,6 +210,7 @@ bool DisplayManager::initLVGL() {
         indev = lv_indev_create();
         if (indev) {
             lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+            lv_indev_set_user_data(indev, this);
             lv_indev_set_read_cb(indev, touchCallback);
         }
     }
@@ -0,0 +1,28 @@
+/**
+ * @file HeadlessDisplay.cpp
+ * @brief Headless Display Driver Implementation
+ */
+
+#include "HeadlessDisplay.hpp"
+
+HeadlessDisplay::HeadlessDisplay(int16_t width, int16_t height)
+    : initialized(false)
+    , powerOn(true)
+    , currentBrightness(100)
+    , width(width)
+    , height(height) {
+}
+
+bool HeadlessDisplay::init() {
+    initialized = true;
+    Serial.printf("  ✅ Headless display initialized (%dx%d)\n", width, height);
+    return true;
+}
+
+void HeadlessDisplay::setOrientation(bool portrait) {
+    int16_t shortSide = min(width, height);
+    int16_t longSide = max(width, height);
+
+    width = portrait ? shortSide : longSide;
+    height = portrait ? longSide : shortSide;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file HeadlessDisplay.hpp
+ * @brief Headless Display Driver (native build)
+ *
+ * Framebuffer-less display used by `[env:native]`. LVGL renders into
+ * its draw buffer as usual; flushed pixels are discarded.
+ */
+
+#ifndef HEADLESS_DISPLAY_HPP
+#define HEADLESS_DISPLAY_HPP
+
+#include "../Display.hpp"
+
+/**
+ * @brief Headless Display Implementation
+ */
+class HeadlessDisplay : public DisplayInterface {
+public:
+    HeadlessDisplay(int16_t width = 320, int16_t height = 480);
+    ~HeadlessDisplay() override = default;
+
+    bool init() override;
+
+    int16_t getWidth() const override { return width; }
+    int16_t getHeight() const override { return height; }
+
+    void setOrientation(bool portrait) override;
+
+    void setBrightness(uint8_t brightness) override { currentBrightness = brightness; }
+    uint8_t getBrightness() const override { return currentBrightness; }
+
+    void setPower(bool on) override { powerOn = on; }
+
+    void clear() override {}
+
+    bool isInitialized() const override { return initialized; }
+
+    const char* getName() const override { return "Headless (native)"; }
+
+private:
+    bool initialized;
+    bool powerOn;
+    uint8_t currentBrightness;
+
+    int16_t width;
+    int16_t height;
+};
+
+#endif // HEADLESS_DISPLAY_HPP
@@ -61,10 +61,15 @@ void SpotifyTheme::apply() {
     lv_style_set_radius(&styleButtonPressed, RADIUS_MD);
     lv_style_set_bg_color(&styleButtonPressed, COLOR_SPOTIFY_SURFACE);
     lv_style_set_bg_opa(&styleButtonPressed, LV_OPA_COVER);
-    lv_style_set_transform_scale_x(&styleButtonPressed, 950);
-    lv_style_set_transform_scale_y(&styleButtonPressed, 950);
-    lv_style_set_transition_time(&styleButtonPressed, 150);
-    lv_style_set_transition_prop(&styleButtonPressed, LV_STYLE_TRANSFORM_SCALE_X);
+    lv_style_set_transform_scale_x(&styleButtonPressed, 243);  // 256 = 100%
+    lv_style_set_transform_scale_y(&styleButtonPressed, 243);
+
+    static const lv_style_prop_t pressProps[] = {
+        LV_STYLE_TRANSFORM_SCALE_X, LV_STYLE_TRANSFORM_SCALE_Y, LV_STYLE_PROP_INV
+    };
+    static lv_style_transition_dsc_t pressTransition;
+    lv_style_transition_dsc_init(&pressTransition, pressProps, lv_anim_path_ease_out, 150, 0, nullptr);
+    lv_style_set_transition(&styleButtonPressed, &pressTransition);
 
     // Style primary button (Play, etc.)
     lv_style_set_radius(&styleButtonPrimary, RADIUS_MD);
@@ -124,7 +129,7 @@ void SpotifyTheme::apply() {
     lv_style_set_pad_all(&styleListBg, 0);
 
     // Style list item
-    lv_style_set_bg_color(&styleListItem, LV_TRANSP_COLOR);
+    lv_style_set_bg_color(&styleListItem, COLOR_SPOTIFY_BG);
     lv_style_set_bg_opa(&styleListItem, LV_OPA_TRANSP);
     lv_style_set_pad_hor(&styleListItem, SPACING_MD);
     lv_style_set_pad_ver(&styleListItem, SPACING_SM);
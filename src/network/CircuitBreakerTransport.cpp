@@ -0,0 +1,169 @@
+/**
+ * @file CircuitBreakerTransport.cpp
+ * @brief Per-Host Circuit Breaker Implementation
+ */
+
+#include "CircuitBreakerTransport.hpp"
+
+CircuitBreakerTransport::CircuitBreakerTransport(HttpTransport* inner)
+    : inner(inner)
+    , circuitCount(0) {
+}
+
+int CircuitBreakerTransport::send(const HttpRequest& request, const ResponseHandler& onResponse) {
+    Circuit* circuit;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        circuit = find(request.url, true);
+
+        if (circuit && rejects(*circuit)) {
+            stats.rejected++;
+            return HTTPC_ERROR_CIRCUIT_OPEN;
+        }
+
+        // Backoff is over, this request finds out if the host is back
+        if (circuit && circuit->state == CircuitState::OPEN) {
+            circuit->state = CircuitState::HALF_OPEN;
+            stats.probes++;
+        }
+    }
+
+    int code = inner->send(request, onResponse);
+    if (!circuit) {
+        return code;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Local contention says nothing about the host, a probe gets another try
+    if (code == HTTPC_ERROR_NO_CONNECTION) {
+        if (circuit->state == CircuitState::HALF_OPEN) {
+            circuit->state = CircuitState::OPEN;
+        }
+        return code;
+    }
+
+    if (code > 0 && code < 500) {
+        if (circuit->state != CircuitState::CLOSED) {
+            Serial.printf("🔌 %s is back\n", circuit->host.c_str());
+        }
+        circuit->state = CircuitState::CLOSED;
+        circuit->failures = 0;
+        circuit->backoffMs = 0;
+        return code;
+    }
+
+    stats.failures++;
+
+    if (circuit->state == CircuitState::HALF_OPEN) {
+        open(*circuit);
+    } else if (circuit->state == CircuitState::CLOSED &&
+               ++circuit->failures >= CIRCUIT_FAILURE_THRESHOLD) {
+        open(*circuit);
+    }
+    return code;
+}
+
+CircuitState CircuitBreakerTransport::getState(const char* url) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Circuit* circuit = find(url);
+    return circuit ? circuit->state : CircuitState::CLOSED;
+}
+
+bool CircuitBreakerTransport::isRejecting(const char* url) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Circuit* circuit = find(url);
+    if (!circuit || !rejects(*circuit)) {
+        return false;
+    }
+    stats.rejected++;
+    return true;
+}
+
+void CircuitBreakerTransport::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < circuitCount; i++) {
+        circuits[i].state = CircuitState::CLOSED;
+        circuits[i].failures = 0;
+        circuits[i].backoffMs = 0;
+    }
+}
+
+CircuitBreakerTransport::Stats CircuitBreakerTransport::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+// Private methods
+
+CircuitBreakerTransport::Circuit* CircuitBreakerTransport::find(const char* url, bool create) {
+    const Circuit* circuit = static_cast<const CircuitBreakerTransport*>(this)->find(url);
+    if (circuit || !create || circuitCount == CIRCUIT_MAX_HOSTS) {
+        return const_cast<Circuit*>(circuit);
+    }
+
+    const char* host;
+    size_t length = hostOf(url, host);
+    Circuit& added = circuits[circuitCount];
+    if (length == 0 || !added.host.assign(host, length)) {
+        return nullptr;
+    }
+
+    added.state = CircuitState::CLOSED;
+    added.failures = 0;
+    added.openedAt = 0;
+    added.openMs = 0;
+    added.backoffMs = 0;
+    circuitCount++;
+    return &added;
+}
+
+const CircuitBreakerTransport::Circuit* CircuitBreakerTransport::find(const char* url) const {
+    const char* host;
+    size_t length = hostOf(url, host);
+
+    for (size_t i = 0; i < circuitCount; i++) {
+        if (circuits[i].host.length() == length &&
+            memcmp(circuits[i].host.c_str(), host, length) == 0) {
+            return &circuits[i];
+        }
+    }
+    return nullptr;
+}
+
+bool CircuitBreakerTransport::rejects(const Circuit& circuit) const {
+    switch (circuit.state) {
+        case CircuitState::OPEN:
+            return millis() - circuit.openedAt < circuit.openMs;
+        case CircuitState::HALF_OPEN:
+            return true;    // Until the probe is back
+        default:
+            return false;
+    }
+}
+
+void CircuitBreakerTransport::open(Circuit& circuit) {
+    circuit.backoffMs = circuit.backoffMs
+        ? min(circuit.backoffMs * 2, (unsigned long)CIRCUIT_OPEN_MAX_MS)
+        : CIRCUIT_OPEN_MIN_MS;
+
+    long jitter = static_cast<long>(circuit.backoffMs * CIRCUIT_JITTER_PERCENT / 100);
+    circuit.openMs = circuit.backoffMs + random(-jitter, jitter + 1);
+    circuit.openedAt = millis();
+    circuit.state = CircuitState::OPEN;
+    circuit.failures = 0;
+    stats.opened++;
+
+    Serial.printf("🔌 %s unreachable, next try in %lu ms\n", circuit.host.c_str(), circuit.openMs);
+}
+
+size_t CircuitBreakerTransport::hostOf(const char* url, const char*& host) {
+    const char* start = strstr(url, "://");
+    host = start ? start + 3 : url;
+
+    size_t length = 0;
+    while (host[length] && host[length] != '/' && host[length] != ':' && host[length] != '?') {
+        length++;
+    }
+    return length;
+}
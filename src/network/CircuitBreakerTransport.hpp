@@ -0,0 +1,149 @@
+/**
+ * @file CircuitBreakerTransport.hpp
+ * @brief Per-Host Circuit Breaker
+ *
+ * Wraps another transport and stops sending to a host that keeps
+ * failing, so an outage doesn't cost a blocking TLS attempt and an
+ * error log for every poll and tap:
+ * - closed: requests go through, CIRCUIT_FAILURE_THRESHOLD failures in
+ *   a row (no connection, or a 5xx response) open the circuit
+ * - open: requests fail at once with HTTPC_ERROR_CIRCUIT_OPEN until the
+ *   backoff has passed. It doubles with every failed probe, up to
+ *   CIRCUIT_OPEN_MAX_MS, with jitter so requests don't line up
+ * - half-open: the next request is let through as a probe, its result
+ *   closes the circuit or opens it again
+ *
+ * Any other response (429 and 4xx included) means the host is there.
+ * HTTPC_ERROR_NO_CONNECTION counts neither way, the request never left
+ * the device.
+ */
+
+#ifndef CIRCUIT_BREAKER_TRANSPORT_HPP
+#define CIRCUIT_BREAKER_TRANSPORT_HPP
+
+#include "HttpTransport.hpp"
+#include "../utils/FixedString.hpp"
+#include <mutex>
+
+// Returned by send() while the circuit of the host is open
+#define HTTPC_ERROR_CIRCUIT_OPEN (-100)
+
+// Breaker settings
+#define CIRCUIT_MAX_HOSTS 4                // API, accounts, image CDNs; more pass through
+#define CIRCUIT_HOST_LENGTH 63
+#define CIRCUIT_FAILURE_THRESHOLD 3
+#define CIRCUIT_OPEN_MIN_MS 2000           // First backoff
+#define CIRCUIT_OPEN_MAX_MS 60000
+#define CIRCUIT_JITTER_PERCENT 20          // Backoff varies by +/- this much
+
+/**
+ * @brief State of the circuit of one host
+ */
+enum class CircuitState : uint8_t {
+    CLOSED,     // Requests go through
+    OPEN,       // Requests fail at once
+    HALF_OPEN   // One probe request is on its way
+};
+
+/**
+ * @brief Circuit Breaker Transport Class
+ *
+ *     CircuitBreakerTransport breaker(&HttpsTransport::getInstance());
+ *     int code = breaker.send(request, onResponse);  // HTTPC_ERROR_CIRCUIT_OPEN while down
+ *
+ * Thread safe, like the transports it wraps.
+ */
+class CircuitBreakerTransport : public HttpTransport {
+public:
+    /**
+     * @brief Breaker statistics
+     */
+    struct Stats {
+        uint32_t failures;      // Transport errors and 5xx responses
+        uint32_t opened;        // Times a circuit opened (again)
+        uint32_t rejected;      // Requests failed without being sent
+        uint32_t probes;
+
+        Stats()
+            : failures(0)
+            , opened(0)
+            , rejected(0)
+            , probes(0) {
+        }
+    };
+
+    /**
+     * @param inner Transport the requests that get through are sent with
+     */
+    explicit CircuitBreakerTransport(HttpTransport* inner);
+
+    int send(const HttpRequest& request, const ResponseHandler& onResponse) override;
+
+    /**
+     * @brief Get the state of the circuit of the host of an URL
+     */
+    CircuitState getState(const char* url) const;
+
+    /**
+     * @brief Check if a request to this URL would fail without being sent
+     *
+     * Lets callers skip the request before building it. Counted as
+     * rejected, so only ask right before sending. False once the backoff
+     * has passed, the next request is the probe.
+     */
+    bool isRejecting(const char* url);
+
+    /**
+     * @brief Close all circuits (e.g. after the network came back)
+     */
+    void reset();
+
+    /**
+     * @brief Get breaker statistics
+     */
+    Stats getStats() const;
+
+private:
+    struct Circuit {
+        FixedString<CIRCUIT_HOST_LENGTH> host;
+        CircuitState state;
+        uint8_t failures;           // In a row, while closed
+        unsigned long openedAt;
+        unsigned long openMs;       // With jitter
+        unsigned long backoffMs;    // Without jitter, doubled by failed probes
+    };
+
+    /**
+     * @brief Find the circuit of the host of an URL (mutex held)
+     * @param create Add one if there is room
+     * @return nullptr if there is none
+     */
+    Circuit* find(const char* url, bool create);
+    const Circuit* find(const char* url) const;
+
+    /**
+     * @brief Check if a circuit rejects requests now (mutex held)
+     */
+    bool rejects(const Circuit& circuit) const;
+
+    /**
+     * @brief Open a circuit for its next backoff (mutex held)
+     */
+    void open(Circuit& circuit);
+
+    /**
+     * @brief Get the host part of an URL
+     * @return Length of the host, host points at its start
+     */
+    static size_t hostOf(const char* url, const char*& host);
+
+    HttpTransport* inner;
+
+    mutable std::mutex mutex;
+    Circuit circuits[CIRCUIT_MAX_HOSTS];
+    size_t circuitCount;
+
+    Stats stats;
+};
+
+#endif // CIRCUIT_BREAKER_TRANSPORT_HPP
@@ -0,0 +1,275 @@
+/**
+ * @file ConnectionPool.cpp
+ * @brief Keep-alive HTTPS Connection Pool Implementation
+ */
+
+#include "ConnectionPool.hpp"
+#include "HttpTransport.hpp"
+#include "RootCertificates.hpp"
+
+ConnectionPool::Connection* ConnectionPool::acquire(const char* url) {
+    char host[POOL_MAX_HOST_LENGTH];
+    uint16_t port;
+    if (!parseUrl(url, host, port)) {
+        Serial.printf("⚠️  Pool: invalid URL %s\n", url);
+        return nullptr;
+    }
+
+    Connection* conn;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        conn = findSlot(host, port);
+        if (conn) {
+            conn->inUse = true;
+        }
+    }
+
+    if (!conn) {
+        Serial.printf("⚠️  Pool: no free connection for %s\n", host);
+        return nullptr;
+    }
+
+    conn->url = url;   // Reuses the buffer once it's large enough
+    conn->timing = RequestTiming();
+    conn->acquiredUs = micros();
+
+    // Server closes idle keep-alive connections; don't find out the hard way
+    if (conn->client.connected() && millis() - conn->lastUsedMs > POOL_IDLE_TIMEOUT_MS) {
+        conn->client.stop();
+    }
+
+    if (conn->client.connected()) {
+        conn->timing.reused = true;
+    } else {
+        connect(conn);
+    }
+
+    conn->http.setReuse(true);
+    conn->http.begin(conn->client, conn->url);
+
+    return conn;
+}
+
+int ConnectionPool::send(Connection* conn, std::function<int(HTTPClient&)> request) {
+    // Invalid URL or no free slot, the host wasn't even tried
+    if (!conn) {
+        return HTTPC_ERROR_NO_CONNECTION;
+    }
+
+    if (!conn->client.connected()) {
+        // Handshake in acquire() already failed, don't wait for it twice
+        conn->timing.httpCode = HTTPC_ERROR_CONNECTION_REFUSED;
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    unsigned long start = micros();
+    int httpCode = request(conn->http);
+
+    if (conn->timing.reused && isStaleConnectionError(httpCode)) {
+        // Kept-alive socket was closed by the server, retry on a fresh one
+        Serial.printf("♻️  Pool: stale connection to %s, reconnecting\n", conn->host.c_str());
+        conn->stats.retries++;
+
+        conn->http.end();
+        conn->client.stop();
+        conn->timing.reused = false;
+
+        connect(conn);
+        conn->http.begin(conn->client, conn->url);
+
+        start = micros();
+        httpCode = request(conn->http);
+    }
+
+    conn->timing.requestUs = micros() - start;
+    conn->timing.httpCode = httpCode;
+
+    return httpCode;
+}
+
+void ConnectionPool::release(Connection* conn) {
+    if (!conn) {
+        return;
+    }
+
+    conn->http.end();
+
+    // Transport errors leave the socket in an unknown state
+    if (conn->timing.httpCode < 0) {
+        conn->client.stop();
+        conn->stats.failures++;
+    }
+
+    RequestTiming& t = conn->timing;
+    t.totalUs = micros() - conn->acquiredUs;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        HostStats& s = conn->stats;
+        s.requests++;
+        s.requestUsTotal += t.requestUs;
+        s.requestUsMax = max(s.requestUsMax, t.requestUs);
+
+        conn->inUse = false;
+        conn->lastUsedMs = millis();
+    }
+
+#if POOL_LOG_TIMING
+    Serial.printf("⏱  %s %d: handshake %lu.%lu ms, request %lu.%lu ms, total %lu.%lu ms%s\n",
+                  conn->host.c_str(), t.httpCode,
+                  t.handshakeUs / 1000, (t.handshakeUs % 1000) / 100,
+                  t.requestUs / 1000, (t.requestUs % 1000) / 100,
+                  t.totalUs / 1000, (t.totalUs % 1000) / 100,
+                  t.reused ? " (reused)" : "");
+#endif
+}
+
+void ConnectionPool::update() {
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned long now = millis();
+
+    for (auto& conn : connections) {
+        if (!conn.inUse && conn.client.connected() && now - conn.lastUsedMs > POOL_IDLE_TIMEOUT_MS) {
+            Serial.printf("🔌 Pool: closing idle connection to %s\n", conn.host.c_str());
+            conn.client.stop();
+        }
+    }
+}
+
+void ConnectionPool::closeAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Connections in use fail on their own and are closed on release
+    for (auto& conn : connections) {
+        if (!conn.inUse && conn.client.connected()) {
+            conn.client.stop();
+        }
+    }
+}
+
+ConnectionPool::HostStats ConnectionPool::getStats(const String& host) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& conn : connections) {
+        if (conn.host == host) {
+            return conn.stats;
+        }
+    }
+    return HostStats();
+}
+
+void ConnectionPool::printStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Serial.println("\n📊 Connection Pool:");
+    Serial.println("─────────────────────────────────");
+
+    for (const auto& conn : connections) {
+        if (conn.host.isEmpty()) {
+            continue;
+        }
+
+        const HostStats& s = conn.stats;
+        unsigned long avgHandshake = s.handshakes ? s.handshakeUsTotal / s.handshakes : 0;
+        unsigned long avgRequest = s.requests ? s.requestUsTotal / s.requests : 0;
+
+        Serial.printf("%s:\n", conn.host.c_str());
+        Serial.printf("  Requests: %u (%u handshakes, %u retries, %u failures)\n",
+                      (unsigned)s.requests, (unsigned)s.handshakes,
+                      (unsigned)s.retries, (unsigned)s.failures);
+        Serial.printf("  Handshake: avg %lu us, max %lu us\n", avgHandshake, s.handshakeUsMax);
+        Serial.printf("  Request:   avg %lu us, max %lu us\n", avgRequest, s.requestUsMax);
+    }
+
+    Serial.println("─────────────────────────────────\n");
+}
+
+// Private methods
+
+ConnectionPool::Connection* ConnectionPool::findSlot(const char* host, uint16_t port) {
+    Connection* freeSlot = nullptr;
+    Connection* oldest = nullptr;
+
+    for (auto& conn : connections) {
+        if (conn.host == host && conn.port == port) {
+            return conn.inUse ? nullptr : &conn;
+        }
+        if (conn.host.isEmpty() && !freeSlot) {
+            freeSlot = &conn;
+        }
+        if (!conn.inUse && (!oldest || conn.lastUsedMs < oldest->lastUsedMs)) {
+            oldest = &conn;
+        }
+    }
+
+    Connection* slot = freeSlot ? freeSlot : oldest;
+    if (!slot) {
+        return nullptr;
+    }
+
+    if (slot->client.connected()) {
+        slot->client.stop();
+    }
+
+#if POOL_TLS_INSECURE
+    slot->client.setInsecure();
+#else
+    // A host without pinned roots has nothing to be checked against and fails to connect
+    const char* roots = getRootCertificates(host);
+    if (!roots) {
+        Serial.printf("⚠️  Pool: no root certificate for %s\n", host);
+    }
+    slot->client.setCACert(roots);
+#endif
+    slot->host = host;
+    slot->port = port;
+    slot->stats = HostStats();
+
+    return slot;
+}
+
+bool ConnectionPool::connect(Connection* conn) {
+    unsigned long start = micros();
+    bool ok = conn->client.connect(conn->host.c_str(), conn->port, POOL_CONNECT_TIMEOUT_MS);
+    unsigned long elapsed = micros() - start;
+
+    conn->timing.handshakeUs += elapsed;
+    conn->stats.handshakes++;
+    conn->stats.handshakeUsTotal += elapsed;
+    conn->stats.handshakeUsMax = max(conn->stats.handshakeUsMax, elapsed);
+
+    if (!ok) {
+        Serial.printf("⚠️  Pool: connection to %s:%u failed\n", conn->host.c_str(), conn->port);
+    }
+
+    return ok;
+}
+
+bool ConnectionPool::isStaleConnectionError(int code) {
+    return code == HTTPC_ERROR_SEND_HEADER_FAILED ||
+           code == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+           code == HTTPC_ERROR_NOT_CONNECTED ||
+           code == HTTPC_ERROR_CONNECTION_LOST;
+}
+
+bool ConnectionPool::parseUrl(const char* url, char* host, uint16_t& port) {
+    const char* start = strstr(url, "://");
+    if (!start) {
+        return false;
+    }
+
+    port = strncmp(url, "https", 5) == 0 ? 443 : 80;
+    start += 3;
+
+    size_t length = strcspn(start, ":/");
+    if (length == 0 || length >= POOL_MAX_HOST_LENGTH) {
+        return false;
+    }
+    memcpy(host, start, length);
+    host[length] = '\0';
+
+    if (start[length] == ':') {
+        port = static_cast<uint16_t>(atoi(start + length + 1));
+    }
+
+    return true;
+}
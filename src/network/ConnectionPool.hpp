@@ -0,0 +1,212 @@
+/**
+ * @file ConnectionPool.hpp
+ * @brief Keep-alive HTTPS Connection Pool
+ *
+ * Keeps one TLS connection per host (api.spotify.com,
+ * accounts.spotify.com, i.scdn.co) open across requests so the
+ * handshake is paid once instead of on every poll and button press.
+ * Idle connections are closed before the server drops them and are
+ * re-established transparently on the next request.
+ */
+
+#ifndef CONNECTION_POOL_HPP
+#define CONNECTION_POOL_HPP
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include <functional>
+#include <mutex>
+
+// Pool settings
+#define POOL_MAX_HOSTS 3
+#define POOL_IDLE_TIMEOUT_MS 30000     // Close connections idle this long
+#define POOL_CONNECT_TIMEOUT_MS 5000
+#define POOL_MAX_HOST_LENGTH 64
+
+// Skip certificate validation, only for local test servers with a
+// self-signed certificate (tools/spotify-stub)
+#ifndef POOL_TLS_INSECURE
+#define POOL_TLS_INSECURE 0
+#endif
+
+// Log handshake/request timing for every request
+#ifndef POOL_LOG_TIMING
+#ifdef NATIVE_BUILD
+#define POOL_LOG_TIMING 1
+#else
+#define POOL_LOG_TIMING 0
+#endif
+#endif
+
+/**
+ * @brief Timing of a single request
+ */
+struct RequestTiming {
+    unsigned long handshakeUs;  // TCP connect + TLS handshake (0 if reused)
+    unsigned long requestUs;    // Send request until response headers
+    unsigned long totalUs;      // acquire() until release()
+    bool reused;                // Existing connection was reused
+    int httpCode;
+
+    RequestTiming()
+        : handshakeUs(0)
+        , requestUs(0)
+        , totalUs(0)
+        , reused(false)
+        , httpCode(0) {
+    }
+};
+
+/**
+ * @brief Connection Pool Class
+ *
+ * Singleton pattern. Usage:
+ *
+ *     auto* conn = pool.acquire(url);
+ *     int code = pool.send(conn, [&](HTTPClient& http) {
+ *         http.addHeader(...);
+ *         return http.GET();
+ *     });
+ *     String body = conn->http.getString();
+ *     pool.release(conn);
+ *
+ * The request callback may run twice: if a reused connection turns out
+ * to be stale, it is reopened and the request is sent again.
+ *
+ * Safe to use from several tasks: a connection belongs to the caller
+ * between acquire() and release().
+ */
+class ConnectionPool {
+public:
+    /**
+     * @brief Per-host statistics
+     */
+    struct HostStats {
+        uint32_t requests;
+        uint32_t handshakes;
+        uint32_t retries;
+        uint32_t failures;
+        unsigned long handshakeUsTotal;
+        unsigned long requestUsTotal;
+        unsigned long handshakeUsMax;
+        unsigned long requestUsMax;
+
+        HostStats()
+            : requests(0)
+            , handshakes(0)
+            , retries(0)
+            , failures(0)
+            , handshakeUsTotal(0)
+            , requestUsTotal(0)
+            , handshakeUsMax(0)
+            , requestUsMax(0) {
+        }
+    };
+
+    /**
+     * @brief Pooled connection to one host
+     */
+    struct Connection {
+        String host;
+        uint16_t port;
+        String url;
+
+        WiFiClientSecure client;
+        HTTPClient http;
+
+        bool inUse;
+        unsigned long lastUsedMs;
+        unsigned long acquiredUs;
+
+        RequestTiming timing;
+        HostStats stats;
+
+        Connection() : port(0), inUse(false), lastUsedMs(0), acquiredUs(0) {}
+    };
+
+    /**
+     * @brief Get the singleton instance
+     */
+    static ConnectionPool& getInstance() {
+        static ConnectionPool instance;
+        return instance;
+    }
+
+    // Delete copy constructor and assignment operator
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * @brief Get a connection for a URL and begin the request
+     * @param url Full https:// URL
+     * @return Connection, or nullptr if the URL is invalid or no slot is free
+     */
+    Connection* acquire(const char* url);
+
+    /**
+     * @brief Send the request, reconnecting once if the connection was stale
+     * @param conn Connection from acquire()
+     * @param request Adds headers and calls the HTTP verb, returns its code
+     * @return HTTP status code or HTTPC_ERROR_* (< 0),
+     *         HTTPC_ERROR_NO_CONNECTION if conn is nullptr
+     */
+    int send(Connection* conn, std::function<int(HTTPClient&)> request);
+
+    /**
+     * @brief Finish the request and keep the connection for reuse
+     */
+    void release(Connection* conn);
+
+    /**
+     * @brief Close connections that have been idle too long (call periodically)
+     */
+    void update();
+
+    /**
+     * @brief Close all connections (e.g. after WiFi loss)
+     */
+    void closeAll();
+
+    /**
+     * @brief Get statistics for a host
+     */
+    HostStats getStats(const String& host) const;
+
+    /**
+     * @brief Print per-host statistics to Serial
+     */
+    void printStats() const;
+
+private:
+    ConnectionPool() = default;
+    ~ConnectionPool() = default;
+
+    /**
+     * @brief Find the slot for host:port, or free/evict one
+     */
+    Connection* findSlot(const char* host, uint16_t port);
+
+    /**
+     * @brief Open the TLS connection and record handshake time
+     */
+    bool connect(Connection* conn);
+
+    /**
+     * @brief Check if an error means the kept-alive socket was dead
+     */
+    static bool isStaleConnectionError(int code);
+
+    /**
+     * @brief Split an URL into host and port
+     * @param host Buffer of POOL_MAX_HOST_LENGTH bytes
+     */
+    static bool parseUrl(const char* url, char* host, uint16_t& port);
+
+    Connection connections[POOL_MAX_HOSTS];
+
+    // Guards slot assignment, inUse and stats
+    mutable std::mutex mutex;
+};
+
+#endif // CONNECTION_POOL_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file FakeTransport.cpp
+ * @brief In-process Fake Transport Implementation
+ */
+
+#include "FakeTransport.hpp"
+
+/**
+ * @brief Response body read from memory
+ */
+class FakeResponse : public HttpResponse, public Stream {
+public:
+    FakeResponse(int code, const char* data, size_t length, int retryAfter)
+        : code(code)
+        , data(data)
+        , length(length)
+        , position(0)
+        , aborted(false)
+        , retryAfter(retryAfter) {
+    }
+
+    // HttpResponse interface
+    int getCode() const override { return code; }
+    int getSize() override { return static_cast<int>(length); }
+    Stream& getBody() override { return *this; }
+    size_t getBytesRead() const override { return position; }
+    bool isComplete() const override { return !aborted && position == length; }
+    unsigned long getRequestUs() const override { return 0; }
+    void abort() override {
+        position = length;
+        aborted = true;
+    }
+
+    String getHeader(const char* name) override {
+        if (retryAfter > 0 && strcasecmp(name, "Retry-After") == 0) {
+            return String(retryAfter);
+        }
+        return String();
+    }
+
+    // Stream interface
+    int available() override { return static_cast<int>(length - position); }
+    int read() override { return position < length ? static_cast<uint8_t>(data[position++]) : -1; }
+    int peek() override { return position < length ? static_cast<uint8_t>(data[position]) : -1; }
+
+    size_t readBytes(char* buffer, size_t count) override {
+        size_t n = min(count, length - position);
+        memcpy(buffer, data + position, n);
+        position += n;
+        return n;
+    }
+    using Stream::readBytes;
+
+    size_t write(uint8_t) override { return 0; }
+    using Print::write;
+
+private:
+    int code;
+    const char* data;
+    size_t length;
+    size_t position;
+    bool aborted;
+    int retryAfter;
+};
+
+FakeTransport::FakeTransport()
+    : routeCount(0)
+    , retryAfter(0)
+    , defaultCode(404)
+    , requestCount(0) {
+}
+
+bool FakeTransport::on(const char* method, const char* path, int code, const char* body) {
+    return on(method, path, code, reinterpret_cast<const uint8_t*>(body), strlen(body));
+}
+
+bool FakeTransport::on(const char* method, const char* path, int code, const uint8_t* body, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Replace an existing route for the same request
+    Route* route = nullptr;
+    for (size_t i = 0; i < routeCount; i++) {
+        if (routes[i].method == method && routes[i].path == path) {
+            route = &routes[i];
+            break;
+        }
+    }
+
+    if (!route) {
+        if (routeCount >= FAKE_TRANSPORT_MAX_ROUTES) {
+            Serial.printf("⚠️  FakeTransport: no room for %s %s\n", method, path);
+            return false;
+        }
+        route = &routes[routeCount++];
+        route->method = method;
+        route->path = path;
+        route->count = 0;
+    }
+
+    route->code = code;
+    route->body = String();
+    route->body.concat(reinterpret_cast<const char*>(body), length);
+    return true;
+}
+
+void FakeTransport::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < routeCount; i++) {
+        routes[i] = Route();
+    }
+    routeCount = 0;
+    requestCount = 0;
+    lastRequest = RecordedRequest();
+}
+
+int FakeTransport::send(const HttpRequest& request, const ResponseHandler& onResponse) {
+    Route* route;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requestCount++;
+        lastRequest.method = request.method;
+        lastRequest.url = request.url;
+        lastRequest.body.assign(request.body, request.body ? request.bodyLength : 0);
+
+        route = findRoute(request.method, pathOf(request.url));
+        if (route) {
+            route->count++;
+        }
+    }
+
+    int code = route ? route->code : defaultCode;
+    if (code <= 0) {
+        return code;
+    }
+
+    const char* body = route ? route->body.c_str() : "";
+    size_t length = route ? route->body.length() : 0;
+    FakeResponse response(code, body, length, code == 429 ? retryAfter : 0);
+    if (onResponse) {
+        onResponse(response);
+    }
+
+    return code;
+}
+
+uint32_t FakeTransport::getRequestCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requestCount;
+}
+
+uint32_t FakeTransport::getRequestCount(const char* method, const char* path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < routeCount; i++) {
+        if (routes[i].method == method && routes[i].path == path) {
+            return routes[i].count;
+        }
+    }
+    return 0;
+}
+
+RecordedRequest FakeTransport::getLastRequest() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastRequest;
+}
+
+// Private methods
+
+FakeTransport::Route* FakeTransport::findRoute(const char* method, const char* path) {
+    size_t pathLength = strcspn(path, "?");
+
+    for (size_t i = 0; i < routeCount; i++) {
+        Route& route = routes[i];
+        if (route.method != "*" && route.method != method) {
+            continue;
+        }
+
+        // Without a query in the route, the request's query doesn't matter
+        bool exact = strchr(route.path.c_str(), '?') != nullptr;
+        if (exact ? route.path == path
+                  : route.path.length() == pathLength
+                    && strncmp(route.path.c_str(), path, pathLength) == 0) {
+            return &route;
+        }
+    }
+    return nullptr;
+}
+
+const char* FakeTransport::pathOf(const char* url) {
+    const char* host = strstr(url, "://");
+    host = host ? host + 3 : url;
+
+    const char* path = strchr(host, '/');
+    return path ? path : "/";
+}
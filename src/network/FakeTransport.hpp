@@ -0,0 +1,123 @@
+/**
+ * @file FakeTransport.hpp
+ * @brief In-process Fake Transport
+ *
+ * Answers requests from canned responses in memory, without sockets.
+ * Lets the parsing and state handling of SpotifyClient run offline and
+ * be benchmarked at a rate where the network would hide everything:
+ *
+ *     FakeTransport fake;
+ *     fake.on("GET", "/v1/me/player", 200, playerJson);
+ *     SpotifyClient client(&auth, &fake);
+ *
+ * Sending a request doesn't allocate.
+ */
+
+#ifndef FAKE_TRANSPORT_HPP
+#define FAKE_TRANSPORT_HPP
+
+#include "HttpTransport.hpp"
+#include "RequestBuilder.hpp"
+#include "../utils/FixedString.hpp"
+#include <mutex>
+
+// Fake settings
+#define FAKE_TRANSPORT_MAX_ROUTES 16
+#define FAKE_TRANSPORT_METHOD_LENGTH 7
+
+/**
+ * @brief Copy of a request the fake received
+ */
+struct RecordedRequest {
+    FixedString<FAKE_TRANSPORT_METHOD_LENGTH> method;
+    FixedString<REQUEST_URL_SIZE> url;
+    FixedString<REQUEST_BODY_SIZE> body;
+};
+
+/**
+ * @brief Fake Transport Class
+ *
+ * Routes should be set up before other tasks send requests through it;
+ * counters and the recorded request are safe to read at any time.
+ */
+class FakeTransport : public HttpTransport {
+public:
+    FakeTransport();
+
+    /**
+     * @brief Answer requests to a path with a fixed response
+     * @param method "GET", "PUT", ... or "*" for any
+     * @param path Path after the host, e.g. "/v1/me/player". Matches with
+     *             any query string unless it contains one itself.
+     * @param code Status code, or HTTPC_ERROR_* to fail without a response
+     * @param body Response body (copied)
+     * @return false if all FAKE_TRANSPORT_MAX_ROUTES are in use
+     */
+    bool on(const char* method, const char* path, int code, const char* body = "");
+
+    /**
+     * @brief Answer requests to a path with a binary body (e.g. a JPEG)
+     */
+    bool on(const char* method, const char* path, int code, const uint8_t* body, size_t length);
+
+    /**
+     * @brief Forget all routes and counters
+     */
+    void reset();
+
+    /**
+     * @brief Set the Retry-After header sent with 429 responses
+     */
+    void setRetryAfter(int seconds) { retryAfter = seconds; }
+
+    /**
+     * @brief Set the status code for requests no route matches (default 404)
+     */
+    void setDefaultCode(int code) { defaultCode = code; }
+
+    int send(const HttpRequest& request, const ResponseHandler& onResponse) override;
+
+    /**
+     * @brief Get number of requests sent, in total or to a path
+     */
+    uint32_t getRequestCount() const;
+    uint32_t getRequestCount(const char* method, const char* path) const;
+
+    /**
+     * @brief Get a copy of the last request
+     */
+    RecordedRequest getLastRequest() const;
+
+private:
+    struct Route {
+        FixedString<FAKE_TRANSPORT_METHOD_LENGTH> method;
+        String path;
+        int code;
+        String body;
+        uint32_t count;
+    };
+
+    /**
+     * @brief Find the route for a request, or nullptr
+     */
+    Route* findRoute(const char* method, const char* path);
+
+    /**
+     * @brief Get the path of an URL (after scheme and host)
+     */
+    static const char* pathOf(const char* url);
+
+    Route routes[FAKE_TRANSPORT_MAX_ROUTES];
+    size_t routeCount;
+
+    int retryAfter;
+    int defaultCode;
+
+    uint32_t requestCount;
+    RecordedRequest lastRequest;
+
+    // Guards counters and lastRequest
+    mutable std::mutex mutex;
+};
+
+#endif // FAKE_TRANSPORT_HPP
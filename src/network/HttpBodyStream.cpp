@@ -0,0 +1,192 @@
+/**
+ * @file HttpBodyStream.cpp
+ * @brief HTTP Response Body Stream Implementation
+ */
+
+#include "HttpBodyStream.hpp"
+
+HttpBodyStream::HttpBodyStream(WiFiClient* client, int size, bool chunked)
+    : client(client)
+    , chunked(chunked)
+    , finished(false)
+    , failed(false)
+    , chunkStarted(false)
+    , remaining(chunked ? 0 : size)
+    , bytesRead(0)
+    , bufferPos(0)
+    , bufferLen(0) {
+    if (!client) {
+        failed = true;
+    } else if (!chunked && size == 0) {
+        finished = true;
+    }
+}
+
+int HttpBodyStream::available() {
+    int buffered = static_cast<int>(bufferLen - bufferPos);
+    if (finished || failed || !client) {
+        return buffered;
+    }
+
+    int pending = client->available();
+    if (remaining >= 0 && pending > remaining) {
+        pending = static_cast<int>(remaining);
+    }
+    return buffered + pending;
+}
+
+int HttpBodyStream::read() {
+    if (!fill()) {
+        return -1;
+    }
+    bytesRead++;
+    return buffer[bufferPos++];
+}
+
+int HttpBodyStream::peek() {
+    if (!fill()) {
+        return -1;
+    }
+    return buffer[bufferPos];
+}
+
+size_t HttpBodyStream::readBytes(char* out, size_t length) {
+    size_t count = 0;
+
+    while (count < length && fill()) {
+        size_t n = min(length - count, bufferLen - bufferPos);
+        memcpy(out + count, buffer + bufferPos, n);
+        bufferPos += n;
+        count += n;
+    }
+
+    bytesRead += count;
+    return count;
+}
+
+bool HttpBodyStream::drain() {
+    while (fill()) {
+        bytesRead += bufferLen - bufferPos;
+        bufferPos = bufferLen;
+    }
+    return finished && !failed;
+}
+
+// Private methods
+
+bool HttpBodyStream::fill() {
+    if (bufferPos < bufferLen) {
+        return true;
+    }
+    if (finished || failed) {
+        return false;
+    }
+
+    if (remaining == 0) {
+        if (!chunked || !nextChunk()) {
+            finished = !failed;
+            return false;
+        }
+    }
+
+    unsigned long start = millis();
+    while (client->available() <= 0) {
+        if (!client->connected()) {
+            // Closing the connection only ends a body of unknown length
+            if (remaining < 0) {
+                finished = true;
+            } else {
+                failed = true;
+            }
+            return false;
+        }
+        if (millis() - start >= HTTP_BODY_TIMEOUT_MS) {
+            failed = true;
+            return false;
+        }
+        delay(1);
+    }
+
+    size_t want = sizeof(buffer);
+    if (remaining >= 0 && static_cast<size_t>(remaining) < want) {
+        want = static_cast<size_t>(remaining);
+    }
+
+    int n = client->read(buffer, want);
+    if (n <= 0) {
+        failed = true;
+        return false;
+    }
+
+    bufferPos = 0;
+    bufferLen = static_cast<size_t>(n);
+    if (remaining > 0) {
+        remaining -= n;
+    }
+
+    return true;
+}
+
+bool HttpBodyStream::nextChunk() {
+    String line;
+
+    // Chunk data is followed by CRLF
+    if (chunkStarted && (!readLine(line) || !line.isEmpty())) {
+        failed = true;
+        return false;
+    }
+
+    if (!readLine(line)) {
+        failed = true;
+        return false;
+    }
+
+    char* end;
+    long size = strtol(line.c_str(), &end, 16);
+    if (end == line.c_str() || size < 0) {
+        failed = true;
+        return false;
+    }
+
+    if (size == 0) {
+        // Last chunk, skip the trailer up to the empty line
+        while (true) {
+            if (!readLine(line)) {
+                failed = true;
+                return false;
+            }
+            if (line.isEmpty()) {
+                return false;
+            }
+        }
+    }
+
+    chunkStarted = true;
+    remaining = size;
+    return true;
+}
+
+bool HttpBodyStream::readLine(String& line) {
+    line = "";
+
+    unsigned long start = millis();
+    while (millis() - start < HTTP_BODY_TIMEOUT_MS) {
+        int c = client->read();
+        if (c < 0) {
+            if (!client->connected()) {
+                return false;
+            }
+            delay(1);
+            continue;
+        }
+
+        if (c == '\n') {
+            return true;
+        }
+        if (c != '\r') {
+            line += static_cast<char>(c);
+        }
+    }
+
+    return false;
+}
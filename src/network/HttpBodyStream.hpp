@@ -0,0 +1,92 @@
+/**
+ * @file HttpBodyStream.hpp
+ * @brief HTTP Response Body Stream
+ *
+ * Reads a response body straight from the connection so it can be
+ * parsed with deserializeJson() without buffering it in a String.
+ * Decodes chunked transfer encoding and never reads past the end of
+ * the body, so a kept-alive connection stays usable afterwards
+ * (HTTPClient::getStreamPtr() returns the raw socket, which only works
+ * for HTTP/1.0 responses and would prevent reuse).
+ */
+
+#ifndef HTTP_BODY_STREAM_HPP
+#define HTTP_BODY_STREAM_HPP
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// Bytes read from the socket at a time
+#define HTTP_BODY_BUFFER_SIZE 256
+#define HTTP_BODY_TIMEOUT_MS 5000
+
+/**
+ * @brief HTTP Body Stream Class
+ */
+class HttpBodyStream : public Stream {
+public:
+    /**
+     * @param client Connection positioned at the start of the body
+     * @param size Content-Length, or -1 if unknown
+     * @param chunked Body uses chunked transfer encoding
+     */
+    HttpBodyStream(WiFiClient* client, int size, bool chunked);
+
+    // Stream interface
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    using Stream::readBytes;
+
+    size_t write(uint8_t) override { return 0; }
+    using Print::write;
+
+    /**
+     * @brief Discard the rest of the body
+     * @return true if the whole body was read and the connection can be reused
+     */
+    bool drain();
+
+    /**
+     * @brief Get number of body bytes read so far
+     */
+    size_t getBytesRead() const { return bytesRead; }
+
+    /**
+     * @brief Check if the end of the body was reached without an error
+     */
+    bool isComplete() const { return finished && !failed; }
+
+private:
+    /**
+     * @brief Refill the buffer, waiting for data up to the timeout
+     * @return false at the end of the body or on timeout
+     */
+    bool fill();
+
+    /**
+     * @brief Read the next chunk header (and the trailer after the last chunk)
+     */
+    bool nextChunk();
+
+    /**
+     * @brief Read a CRLF terminated line from the connection
+     */
+    bool readLine(String& line);
+
+    WiFiClient* client;
+
+    bool chunked;
+    bool finished;
+    bool failed;
+    bool chunkStarted;
+    long remaining;  // Bytes left in body or current chunk, -1 = until close
+    size_t bytesRead;
+
+    uint8_t buffer[HTTP_BODY_BUFFER_SIZE];
+    size_t bufferPos;
+    size_t bufferLen;
+};
+
+#endif // HTTP_BODY_STREAM_HPP
@@ -0,0 +1,123 @@
+/**
+ * @file HttpTransport.hpp
+ * @brief HTTP Transport Interface
+ *
+ * What SpotifyClient and AuthManager send their requests through:
+ * a request goes in, a status code and a streamed body come out.
+ * HttpsTransport talks to the real servers over ConnectionPool,
+ * FakeTransport answers from memory for benchmarks and offline runs.
+ */
+
+#ifndef HTTP_TRANSPORT_HPP
+#define HTTP_TRANSPORT_HPP
+
+#include <Arduino.h>
+#include <functional>
+
+// Returned by send() when there was no connection to send the request on
+// (invalid URL, or every pool slot in use). Nothing reached the server.
+#define HTTPC_ERROR_NO_CONNECTION (-102)
+
+/**
+ * @brief Request to send
+ *
+ * Only points at the caller's buffers, which must stay valid until
+ * send() returns.
+ */
+struct HttpRequest {
+    const char* method;         // "GET", "PUT", "POST", "DELETE"
+    const char* url;            // Full URL
+    const char* contentType;    // nullptr if there's no body
+    const char* body;
+    size_t bodyLength;
+    const char* authorization;  // Authorization header value, nullptr for none
+
+    HttpRequest(const char* method, const char* url)
+        : method(method)
+        , url(url)
+        , contentType(nullptr)
+        , body(nullptr)
+        , bodyLength(0)
+        , authorization(nullptr) {
+    }
+};
+
+/**
+ * @brief Response passed to the handler of HttpTransport::send()
+ */
+class HttpResponse {
+public:
+    virtual ~HttpResponse() = default;
+
+    /**
+     * @brief Get the HTTP status code
+     */
+    virtual int getCode() const = 0;
+
+    /**
+     * @brief Get the Content-Length, or -1 if unknown (chunked)
+     */
+    virtual int getSize() = 0;
+
+    /**
+     * @brief Get the body, ends where the response ends
+     */
+    virtual Stream& getBody() = 0;
+
+    /**
+     * @brief Get number of body bytes read so far
+     */
+    virtual size_t getBytesRead() const = 0;
+
+    /**
+     * @brief Check if the body was read to its end
+     *
+     * False after a timeout, a dropped connection or abort(). A chunked
+     * body ends with its last chunk, not when the connection closes.
+     */
+    virtual bool isComplete() const = 0;
+
+    /**
+     * @brief Get a response header (only Retry-After is guaranteed)
+     */
+    virtual String getHeader(const char* name) = 0;
+
+    /**
+     * @brief Get time from sending the request until the response headers (us)
+     */
+    virtual unsigned long getRequestUs() const = 0;
+
+    /**
+     * @brief Close the connection instead of skipping the rest of the body
+     *
+     * For large bodies that are no longer wanted (cancelled downloads).
+     */
+    virtual void abort() = 0;
+};
+
+/**
+ * @brief HTTP Transport Interface
+ *
+ *     HttpRequest request("GET", url);
+ *     int code = transport.send(request, [&](HttpResponse& response) {
+ *         deserializeJson(doc, response.getBody());
+ *     });
+ *
+ * Whatever the handler leaves of the body is skipped afterwards.
+ * Implementations must be safe to call from several tasks.
+ */
+class HttpTransport {
+public:
+    using ResponseHandler = std::function<void(HttpResponse&)>;
+
+    virtual ~HttpTransport() = default;
+
+    /**
+     * @brief Send a request and hand the response to a handler
+     * @param onResponse Called if a response arrived (code > 0), may be empty
+     * @return HTTP status code or HTTPC_ERROR_* (< 0)
+     */
+    virtual int send(const HttpRequest& request, const ResponseHandler& onResponse) = 0;
+};
+
+#endif // HTTP_TRANSPORT_HPP
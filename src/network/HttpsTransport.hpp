@@ -0,0 +1,41 @@
+/**
+ * @file HttpsTransport.hpp
+ * @brief HTTPS Transport
+ *
+ * HttpTransport over the kept-alive connections in ConnectionPool.
+ * Bodies are streamed from the socket with HttpBodyStream and drained
+ * after the handler so the connection can be reused.
+ */
+
+#ifndef HTTPS_TRANSPORT_HPP
+#define HTTPS_TRANSPORT_HPP
+
+#include "HttpTransport.hpp"
+
+/**
+ * @brief HTTPS Transport Class
+ *
+ * Singleton pattern, stateless apart from the shared ConnectionPool.
+ */
+class HttpsTransport : public HttpTransport {
+public:
+    /**
+     * @brief Get the singleton instance
+     */
+    static HttpsTransport& getInstance() {
+        static HttpsTransport instance;
+        return instance;
+    }
+
+    // Delete copy constructor and assignment operator
+    HttpsTransport(const HttpsTransport&) = delete;
+    HttpsTransport& operator=(const HttpsTransport&) = delete;
+
+    int send(const HttpRequest& request, const ResponseHandler& onResponse) override;
+
+private:
+    HttpsTransport() = default;
+    ~HttpsTransport() = default;
+};
+
+#endif // HTTPS_TRANSPORT_HPP
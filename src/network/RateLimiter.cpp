@@ -0,0 +1,129 @@
+/**
+ * @file RateLimiter.cpp
+ * @brief Token Bucket Rate Limiter Implementation
+ */
+
+#include "RateLimiter.hpp"
+
+RateLimiter::RateLimiter()
+    : tokens(RATE_LIMIT_BURST)
+    , lastRefill(millis())
+    , blockedUntil(0)
+    , blocked(false) {
+}
+
+bool RateLimiter::acquire(RequestPriority priority) {
+    unsigned long start = millis();
+    bool waited = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;) {
+        refill();
+
+        unsigned long waitMs = getWaitMs(priority);
+        if (waitMs == 0) {
+            tokens--;
+            stats.allowed++;
+            if (waited) {
+                stats.waited++;
+                stats.waitMs += millis() - start;
+            }
+            return true;
+        }
+
+        if (priority == RequestPriority::BACKGROUND) {
+            stats.deferred++;
+            return false;
+        }
+
+        if (millis() - start + waitMs > RATE_LIMIT_MAX_WAIT_MS) {
+            stats.rejected++;
+            Serial.printf("⏳ Rate limited, dropping request (%lu ms to wait)\n", waitMs);
+            return false;
+        }
+
+        waited = true;
+        lock.unlock();
+        delay(waitMs);
+        lock.lock();
+    }
+}
+
+void RateLimiter::onRateLimited(unsigned long retryAfterMs) {
+    if (retryAfterMs == 0) {
+        retryAfterMs = RATE_LIMIT_DEFAULT_RETRY_MS;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.throttled++;
+
+    // Keep the later deadline if several requests were throttled
+    unsigned long until = millis() + retryAfterMs;
+    if (!blocked || static_cast<long>(until - blockedUntil) > 0) {
+        blockedUntil = until;
+    }
+    blocked = true;
+    tokens = 0;
+
+    Serial.printf("⏳ HTTP 429, pausing requests for %lu ms\n", retryAfterMs);
+}
+
+unsigned long RateLimiter::getBlockedMs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!blocked) {
+        return 0;
+    }
+
+    long left = static_cast<long>(blockedUntil - millis());
+    return left > 0 ? static_cast<unsigned long>(left) : 0;
+}
+
+RateLimiter::Stats RateLimiter::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+// Private methods
+
+void RateLimiter::refill() {
+    unsigned long now = millis();
+
+    if (blocked && static_cast<long>(now - blockedUntil) >= 0) {
+        blocked = false;
+        lastRefill = now;
+        tokens = 1;     // Ease back in instead of a full burst
+    }
+    if (blocked) {
+        lastRefill = now;
+        return;
+    }
+
+    unsigned long elapsed = now - lastRefill;
+    int added = static_cast<int>(elapsed / RATE_LIMIT_REFILL_MS);
+    if (added > 0) {
+        tokens = min(tokens + added, RATE_LIMIT_BURST);
+        lastRefill += added * RATE_LIMIT_REFILL_MS;
+    }
+    if (tokens == RATE_LIMIT_BURST) {
+        lastRefill = now;
+    }
+}
+
+unsigned long RateLimiter::getWaitMs(RequestPriority priority) const {
+    unsigned long now = millis();
+
+    if (blocked) {
+        return max(1L, static_cast<long>(blockedUntil - now));
+    }
+
+    // Background requests leave the reserve to user requests
+    int needed = priority == RequestPriority::BACKGROUND ? RATE_LIMIT_USER_RESERVE + 1 : 1;
+    if (tokens >= needed) {
+        return 0;
+    }
+
+    unsigned long sinceRefill = now - lastRefill;
+    unsigned long nextToken = sinceRefill < RATE_LIMIT_REFILL_MS ? RATE_LIMIT_REFILL_MS - sinceRefill : 1;
+    return nextToken + (needed - tokens - 1) * RATE_LIMIT_REFILL_MS;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file RateLimiter.hpp
+ * @brief Token Bucket Rate Limiter
+ *
+ * Paces requests to the Spotify API so bursts of UI activity don't run
+ * into 429 Too Many Requests, and stops all requests for the Retry-After
+ * time when they do. Background requests (polls, prefetches) never wait:
+ * they are deferred while the bucket is low so the remaining tokens are
+ * left to user commands.
+ */
+
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP
+
+#include <Arduino.h>
+#include <mutex>
+#include "RequestQueue.hpp"
+
+// Bucket settings (burst and refill can be raised for benchmarks on FakeTransport)
+#ifndef RATE_LIMIT_BURST
+#define RATE_LIMIT_BURST 10              // Requests that can be sent back to back
+#endif
+#ifndef RATE_LIMIT_REFILL_MS
+#define RATE_LIMIT_REFILL_MS 500         // One token per interval (2 requests/s sustained)
+#endif
+#define RATE_LIMIT_USER_RESERVE 3        // Tokens background requests leave untouched
+#define RATE_LIMIT_MAX_WAIT_MS 3000      // Longest a user request waits for a token
+#define RATE_LIMIT_DEFAULT_RETRY_MS 5000 // 429 without a Retry-After header
+
+// Status of a background request acquire() deferred, it was never sent
+#define HTTPC_ERROR_DEFERRED (-101)
+
+/**
+ * @brief Rate Limiter Class
+ *
+ * Thread safe. acquire() blocks, so it's meant for the request worker.
+ */
+class RateLimiter {
+public:
+    /**
+     * @brief Rate limiter statistics
+     */
+    struct Stats {
+        uint32_t allowed;
+        uint32_t throttled;     // 429 responses
+        uint32_t deferred;      // Background requests not sent
+        uint32_t waited;        // User requests that had to wait
+        uint32_t rejected;      // User requests that would have waited too long
+        unsigned long waitMs;   // Total time user requests waited
+
+        Stats()
+            : allowed(0)
+            , throttled(0)
+            , deferred(0)
+            , waited(0)
+            , rejected(0)
+            , waitMs(0) {
+        }
+    };
+
+    RateLimiter();
+
+    /**
+     * @brief Take a token before sending a request
+     *
+     * User requests wait up to RATE_LIMIT_MAX_WAIT_MS for a token.
+     * Background requests return false right away instead.
+     * @return true if the request may be sent
+     */
+    bool acquire(RequestPriority priority);
+
+    /**
+     * @brief Stop sending requests after a 429 response
+     * @param retryAfterMs Retry-After from the response, 0 if missing
+     */
+    void onRateLimited(unsigned long retryAfterMs);
+
+    /**
+     * @brief Get time left until requests may be sent again after a 429
+     */
+    unsigned long getBlockedMs() const;
+
+    /**
+     * @brief Get rate limiter statistics
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Add tokens for the time since the last refill (mutex held)
+     */
+    void refill();
+
+    /**
+     * @brief Get time until a request of this priority could be sent (mutex held)
+     */
+    unsigned long getWaitMs(RequestPriority priority) const;
+
+    mutable std::mutex mutex;
+    int tokens;
+    unsigned long lastRefill;
+    unsigned long blockedUntil;
+    bool blocked;
+
+    Stats stats;
+};
+
+#endif // RATE_LIMITER_HPP
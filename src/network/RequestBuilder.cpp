@@ -0,0 +1,76 @@
+/**
+ * @file RequestBuilder.cpp
+ * @brief Fixed Buffer Request Builder Implementation
+ */
+
+#include "RequestBuilder.hpp"
+#include "../utils/UrlEncode.hpp"
+#include <stdarg.h>
+
+RequestBuilder::RequestBuilder(const char* base, const char* path)
+    : urlLength(0)
+    , baseLength(0)
+    , bodyLength(0)
+    , overflow(false) {
+    url[0] = '\0';
+    bodyBuffer[0] = '\0';
+
+    append(base, strlen(base));
+    baseLength = urlLength;
+    append(path, strlen(path));
+}
+
+RequestBuilder& RequestBuilder::path(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(url + urlLength, sizeof(url) - urlLength, format, args);
+    va_end(args);
+
+    if (n < 0 || static_cast<size_t>(n) >= sizeof(url) - urlLength) {
+        overflow = true;
+        urlLength = sizeof(url) - 1;
+        url[urlLength] = '\0';
+    } else {
+        urlLength += n;
+    }
+    return *this;
+}
+
+RequestBuilder& RequestBuilder::encoded(const char* text) {
+    int n = urlEncode(text, url + urlLength, sizeof(url) - urlLength);
+    if (n < 0) {
+        overflow = true;
+        urlLength += strlen(url + urlLength);
+    } else {
+        urlLength += n;
+    }
+    return *this;
+}
+
+RequestBuilder& RequestBuilder::body(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(bodyBuffer, sizeof(bodyBuffer), format, args);
+    va_end(args);
+
+    if (n < 0 || static_cast<size_t>(n) >= sizeof(bodyBuffer)) {
+        overflow = true;
+        bodyLength = sizeof(bodyBuffer) - 1;
+    } else {
+        bodyLength = n;
+    }
+    return *this;
+}
+
+// Private methods
+
+void RequestBuilder::append(const char* text, size_t length) {
+    if (urlLength + length >= sizeof(url)) {
+        overflow = true;
+        return;
+    }
+
+    memcpy(url + urlLength, text, length);
+    urlLength += length;
+    url[urlLength] = '\0';
+}
@@ -0,0 +1,75 @@
+/**
+ * @file RequestBuilder.hpp
+ * @brief Fixed Buffer Request Builder
+ *
+ * Formats a request URL and body into fixed buffers instead of
+ * concatenating Strings, so building a request never touches the heap.
+ * Meant to live on the stack of the request being sent:
+ *
+ *     RequestBuilder request(SPOTIFY_API_BASE);
+ *     request.path("/me/player/volume?volume_percent=%d", volume);
+ *     httpPut(request);
+ */
+
+#ifndef REQUEST_BUILDER_HPP
+#define REQUEST_BUILDER_HPP
+
+#include <Arduino.h>
+
+// Buffer sizes (a /me/tracks/contains URL with 50 ids is ~1.2 KB)
+#define REQUEST_URL_SIZE 1280
+#define REQUEST_BODY_SIZE 256
+
+/**
+ * @brief Request Builder Class
+ */
+class RequestBuilder {
+public:
+    /**
+     * @param base URL prefix, e.g. SPOTIFY_API_BASE
+     * @param path Path appended to base (no formatting)
+     */
+    explicit RequestBuilder(const char* base, const char* path = "");
+
+    /**
+     * @brief Append printf-formatted text to the URL
+     */
+    RequestBuilder& path(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Append text to the URL, percent-encoded (RFC 3986)
+     */
+    RequestBuilder& encoded(const char* text);
+
+    /**
+     * @brief Set the body to printf-formatted text
+     */
+    RequestBuilder& body(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Check that nothing was cut off
+     */
+    bool isValid() const { return !overflow; }
+
+    const char* getUrl() const { return url; }
+    const char* getPath() const { return url + baseLength; }
+    const char* getBody() const { return bodyBuffer; }
+    size_t getBodyLength() const { return bodyLength; }
+
+private:
+    /**
+     * @brief Append to the URL (overflow sets the error flag)
+     */
+    void append(const char* text, size_t length);
+
+    char url[REQUEST_URL_SIZE];
+    size_t urlLength;
+    size_t baseLength;
+
+    char bodyBuffer[REQUEST_BODY_SIZE];
+    size_t bodyLength;
+
+    bool overflow;
+};
+
+#endif // REQUEST_BUILDER_HPP
@@ -0,0 +1,154 @@
+/**
+ * @file RequestQueue.cpp
+ * @brief Background Request Queue Implementation
+ */
+
+#include "RequestQueue.hpp"
+#include <algorithm>
+
+RequestQueue::RequestQueue()
+    : busy(false)
+    , runningPriority(RequestPriority::USER)
+    , userRequests(0)
+    , started(false)
+    , stopping(false) {
+}
+
+RequestQueue::~RequestQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+#ifdef NATIVE_BUILD
+    // Finish the running request before the queue goes away at exit
+    if (worker.joinable()) {
+        worker.join();
+    }
+#endif
+}
+
+bool RequestQueue::begin() {
+    if (started) {
+        return true;
+    }
+
+#ifdef NATIVE_BUILD
+    worker = std::thread([this]() { run(); });
+#else
+    if (xTaskCreatePinnedToCore(taskEntry, "requests", REQUEST_TASK_STACK_SIZE, this,
+                                REQUEST_TASK_PRIORITY, nullptr, REQUEST_TASK_CORE) != pdPASS) {
+        Serial.println("❌ Failed to start request task");
+        return false;
+    }
+#endif
+
+    started = true;
+    Serial.println("✅ Request queue started");
+    return true;
+}
+
+bool RequestQueue::submit(Request request, Completion onComplete, RequestPriority priority) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (jobs.size() >= REQUEST_QUEUE_MAX) {
+            stats.rejected++;
+            Serial.println("⚠️  Request queue full, dropping request");
+            return false;
+        }
+
+        jobs.push_back({std::move(request), std::move(onComplete), millis(), priority});
+        if (priority == RequestPriority::USER) {
+            userRequests++;
+        }
+        stats.submitted++;
+        stats.maxDepth = max(stats.maxDepth, jobs.size());
+    }
+
+    wake.notify_one();
+    return true;
+}
+
+void RequestQueue::update() {
+    // Runs every loop, so it mustn't allocate when there is nothing to do
+    // (even an empty std::deque does)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (results.empty()) {
+            return;
+        }
+        completing.swap(results);
+    }
+
+    for (auto& result : completing) {
+        result.onComplete(result.success);
+    }
+    completing.clear();
+}
+
+size_t RequestQueue::getPending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size() + (busy ? 1 : 0);
+}
+
+RequestQueue::Stats RequestQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+// Private methods
+
+void RequestQueue::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return !jobs.empty() || stopping; });
+            if (stopping) {
+                return;
+            }
+
+            // First user request, or the oldest background request
+            auto next = std::find_if(jobs.begin(), jobs.end(), [](const Job& queued) {
+                return queued.priority == RequestPriority::USER;
+            });
+            if (next == jobs.end()) {
+                next = jobs.begin();
+            }
+
+            job = std::move(*next);
+            jobs.erase(next);
+            busy = true;
+            runningPriority = job.priority;
+
+            stats.maxWaitMs = max(stats.maxWaitMs, millis() - job.queuedMs);
+        }
+
+        unsigned long start = millis();
+        bool success = job.request();
+        unsigned long elapsed = millis() - start;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+            runningPriority = RequestPriority::USER;
+            if (job.priority == RequestPriority::USER) {
+                userRequests--;
+            }
+            stats.completed++;
+            stats.maxRunMs = max(stats.maxRunMs, elapsed);
+
+            if (job.onComplete) {
+                results.push_back({std::move(job.onComplete), success});
+            }
+        }
+    }
+}
+
+#ifndef NATIVE_BUILD
+void RequestQueue::taskEntry(void* param) {
+    static_cast<RequestQueue*>(param)->run();
+}
+#endif
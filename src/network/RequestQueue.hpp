@@ -0,0 +1,179 @@
+/**
+ * @file RequestQueue.hpp
+ * @brief Background Request Queue
+ *
+ * Runs network requests on a dedicated worker (a FreeRTOS task on the
+ * ESP32, a std::thread on the native build) so App::loop and LVGL event
+ * callbacks never wait on a TLS round trip. Completion callbacks are run
+ * back on the loop task from update().
+ */
+
+#ifndef REQUEST_QUEUE_HPP
+#define REQUEST_QUEUE_HPP
+
+#include <Arduino.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#ifdef NATIVE_BUILD
+#include <thread>
+#endif
+
+// Worker settings
+#define REQUEST_QUEUE_MAX 16
+#define REQUEST_TASK_STACK_SIZE 12288  // TLS needs a deep stack
+#define REQUEST_TASK_PRIORITY 1
+#define REQUEST_TASK_CORE 0            // Loop and LVGL run on core 1
+
+/**
+ * @brief Request priority
+ *
+ * User requests run before queued background requests (polls, prefetches)
+ * and may use tokens the rate limiter keeps back from background requests.
+ */
+enum class RequestPriority {
+    USER,
+    BACKGROUND
+};
+
+/**
+ * @brief Request Queue Class
+ *
+ * Singleton pattern. Usage:
+ *
+ *     RequestQueue::getInstance().submit(
+ *         [spotify]() { return spotify->nextTrack(); },
+ *         [](bool ok) { ... runs on the loop task ... });
+ */
+class RequestQueue {
+public:
+    using Request = std::function<bool()>;
+    using Completion = std::function<void(bool)>;
+
+    /**
+     * @brief Queue statistics
+     */
+    struct Stats {
+        uint32_t submitted;
+        uint32_t completed;
+        uint32_t rejected;      // Queue was full
+        size_t maxDepth;
+        unsigned long maxWaitMs;    // Longest time a request sat in the queue
+        unsigned long maxRunMs;     // Longest request
+
+        Stats()
+            : submitted(0)
+            , completed(0)
+            , rejected(0)
+            , maxDepth(0)
+            , maxWaitMs(0)
+            , maxRunMs(0) {
+        }
+    };
+
+    /**
+     * @brief Get the singleton instance
+     */
+    static RequestQueue& getInstance() {
+        static RequestQueue instance;
+        return instance;
+    }
+
+    // Delete copy constructor and assignment operator
+    RequestQueue(const RequestQueue&) = delete;
+    RequestQueue& operator=(const RequestQueue&) = delete;
+
+    /**
+     * @brief Start the worker
+     */
+    bool begin();
+
+    /**
+     * @brief Queue a request
+     * @param request Runs on the worker, returns success
+     * @param onComplete Runs on the loop task with the result (optional)
+     * @param priority Background requests wait for queued user requests
+     * @return false if the queue is full
+     */
+    bool submit(Request request, Completion onComplete = nullptr,
+                RequestPriority priority = RequestPriority::USER);
+
+    /**
+     * @brief Run completion callbacks (call from the loop)
+     */
+    void update();
+
+    /**
+     * @brief Get number of requests waiting or running
+     */
+    size_t getPending() const;
+
+    /**
+     * @brief Get queue statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Get the priority of the request running on the worker
+     *
+     * Only meaningful on the worker, from within a request. USER while
+     * the worker is idle. Other tasks use hasUserRequests().
+     */
+    RequestPriority getRunningPriority() const { return runningPriority; }
+
+    /**
+     * @brief Check if user requests are queued or running
+     *
+     * Safe from any task. Set when a user request is submitted, cleared
+     * when the last one has run.
+     */
+    bool hasUserRequests() const { return userRequests > 0; }
+
+private:
+    RequestQueue();
+    ~RequestQueue();
+
+    struct Job {
+        Request request;
+        Completion onComplete;
+        unsigned long queuedMs;
+        RequestPriority priority;
+    };
+
+    struct Result {
+        Completion onComplete;
+        bool success;
+    };
+
+    /**
+     * @brief Worker main loop
+     */
+    void run();
+
+#ifndef NATIVE_BUILD
+    static void taskEntry(void* param);
+#endif
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    std::deque<Result> completing;          // Loop task only, kept to reuse its storage
+    bool busy;
+    std::atomic<RequestPriority> runningPriority;
+    std::atomic<uint32_t> userRequests;     // Queued or running
+    bool started;
+    bool stopping;
+
+#ifdef NATIVE_BUILD
+    std::thread worker;
+#endif
+
+    Stats stats;
+};
+
+#endif // REQUEST_QUEUE_HPP
@@ -0,0 +1,22 @@
+/**
+ * @file RootCertificates.hpp
+ * @brief Pinned Root Certificates
+ *
+ * The root CAs the certificate chains of the Spotify hosts are checked
+ * against, so tokens and requests only go to the real servers. A host
+ * that isn't listed has nothing to be checked against and can't be
+ * connected to (unless POOL_TLS_INSECURE is set).
+ */
+
+#ifndef ROOT_CERTIFICATES_HPP
+#define ROOT_CERTIFICATES_HPP
+
+#include <Arduino.h>
+
+/**
+ * @brief Get the root certificates for a host
+ * @return PEM bundle (one or more certificates), nullptr if the host isn't pinned
+ */
+const char* getRootCertificates(const char* host);
+
+#endif // ROOT_CERTIFICATES_HPP
@@ -167,7 +167,7 @@ void WiFiManager::attemptConnect() {
     connectStartTime = millis();
 }
 
-void WiFiManager::onWiFiEvent(WiFiEvent_t event) {
+void WiFiManager::onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
     if (!instance) {
         return;
     }
@@ -187,9 +187,9 @@ void WiFiManager::onWiFiEvent(WiFiEvent_t event) {
 
         case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
             Serial.printf("📶 WiFi disconnected: %d\n",
-                         ((WiFiEventInfo_t*)xTaskGetCurrentTaskHandle())->disconnected.reason);
+                         info.wifi_sta_disconnected.reason);
             instance->lastDisconnectTime = millis();
-            instance->lastDisconnectReason = (WiFiMode_t)((WiFiEventInfo_t*)xTaskGetCurrentTaskHandle())->disconnected.reason;
+            instance->lastDisconnectReason = (wifi_err_reason_t)info.wifi_sta_disconnected.reason;
             instance->state = WiFiState::DISCONNECTED;
             break;
 
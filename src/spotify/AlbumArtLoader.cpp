@@ -0,0 +1,271 @@
+/**
+ * @file AlbumArtLoader.cpp
+ * @brief Album Art Loader Implementation
+ */
+
+#include "AlbumArtLoader.hpp"
+#include "../network/RequestQueue.hpp"
+#include <LittleFS.h>
+
+AlbumArtLoader::AlbumArtLoader(SpotifyClient* client)
+    : client(client)
+    , wantedSince(0)
+    , inFlight(false)
+    , generation(0) {
+}
+
+void AlbumArtLoader::load(const SpotifyId& albumId, const char* url) {
+    if (wantedUrl == url) {
+        return;
+    }
+
+    // Already decoded (the same album again, or a track skipped back to).
+    // Tracks of an album can link different sizes of the same cover.
+    std::shared_ptr<CoverImage> image = albumId.isEmpty()
+        ? (loadedUrl == url ? loaded : nullptr)
+        : images.get(albumId, ALBUM_ART_SIZE);
+    if (image) {
+        cancel();
+        loaded = image;
+        loadedUrl = url;
+        if (loadedHandler) {
+            loadedHandler(url, image);
+        }
+        return;
+    }
+
+    // A running download of the old cover stops at its next chunk
+    generation++;
+    wantedUrl = url;
+    wantedAlbumId = albumId;
+    wantedSince = millis();
+
+    // A prefetch of this cover hands it over when it's done
+    if (!inFlight && findPrefetch(albumId) < 0) {
+        send();
+    }
+}
+
+void AlbumArtLoader::prefetch(const SpotifyId& albumId, const char* url) {
+    Url coverUrl;
+    if (!client || albumId.isEmpty() || !coverUrl.assign(url) || coverUrl.isEmpty() ||
+        albumId == wantedAlbumId || findPrefetch(albumId) >= 0 ||
+        images.contains(albumId, ALBUM_ART_SIZE)) {
+        return;
+    }
+
+    int slot = -1;
+    for (int i = 0; i < ALBUM_ART_PREFETCH_MAX; i++) {
+        if (prefetching[i].isEmpty()) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        return;
+    }
+
+    auto result = std::make_shared<Fetched>();
+
+    bool queued = RequestQueue::getInstance().submit(
+        [this, albumId, coverUrl, result]() {
+            // Nothing is waiting for it, so nothing can make it stale
+            auto never = []() { return false; };
+            return fetch(albumId, coverUrl, std::ref(never), *result);
+        },
+        [this, albumId, result](bool ok) {
+            int index = findPrefetch(albumId);
+            if (index >= 0) {
+                prefetching[index].clear();
+            }
+
+            if (ok) {
+                keep(albumId, *result);
+                stats.prefetched++;
+            }
+
+            // The track started before the prefetch was done
+            if (wantedUrl.isEmpty() || wantedAlbumId != albumId) {
+                return;
+            }
+            if (ok) {
+                if (result->fromCache) {
+                    stats.cached++;
+                }
+                deliver(result->image);
+            } else if (!inFlight) {
+                send();
+            }
+        },
+        RequestPriority::BACKGROUND);
+
+    if (queued) {
+        prefetching[slot] = albumId;
+    }
+}
+
+void AlbumArtLoader::cancel() {
+    generation++;
+    wantedUrl.clear();
+    wantedAlbumId.clear();
+}
+
+// Private methods
+
+void AlbumArtLoader::send() {
+    if (!client || wantedUrl.isEmpty()) {
+        return;
+    }
+
+    uint32_t gen = generation;
+    Url url = wantedUrl;
+    SpotifyId albumId = wantedAlbumId;
+    auto result = std::make_shared<Fetched>();
+
+    inFlight = RequestQueue::getInstance().submit(
+        [this, gen, albumId, url, result]() {
+            auto cancelled = [this, gen]() { return generation != gen; };
+            return fetch(albumId, url, std::ref(cancelled), *result);
+        },
+        [this, gen, albumId, result](bool ok) {
+            inFlight = false;
+
+            // Worth keeping even if the track moved on meanwhile
+            if (ok) {
+                keep(albumId, *result);
+            }
+
+            if (generation != gen) {
+                stats.cancelled++;
+            } else if (ok) {
+                if (result->fromCache) {
+                    stats.cached++;
+                } else {
+                    stats.lastDecodeMs = result->decodeMs;
+                }
+                deliver(result->image);
+            } else {
+                stats.failed++;
+                wantedUrl.clear();
+                wantedAlbumId.clear();
+            }
+
+            // The track changed while this ran
+            if (!wantedUrl.isEmpty() && findPrefetch(wantedAlbumId) < 0) {
+                send();
+            }
+        },
+        RequestPriority::BACKGROUND);
+
+    if (inFlight) {
+        stats.requests++;
+    }
+}
+
+void AlbumArtLoader::keep(const SpotifyId& albumId, const Fetched& result) {
+    images.put(albumId, result.image);
+    images.put(albumId, result.thumbnail);
+    if (!result.fromCache) {
+        store(albumId, result.image);
+    }
+}
+
+void AlbumArtLoader::deliver(const std::shared_ptr<CoverImage>& image) {
+    Url url = wantedUrl;
+
+    loaded = image;
+    loadedUrl = url;
+    stats.completed++;
+    stats.lastLatencyMs = millis() - wantedSince;
+    wantedUrl.clear();
+    wantedAlbumId.clear();
+
+    if (loadedHandler) {
+        loadedHandler(url.c_str(), image);
+    }
+}
+
+int AlbumArtLoader::findPrefetch(const SpotifyId& albumId) const {
+    if (albumId.isEmpty()) {
+        return -1;
+    }
+    for (int i = 0; i < ALBUM_ART_PREFETCH_MAX; i++) {
+        if (prefetching[i] == albumId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void AlbumArtLoader::store(const SpotifyId& albumId, const std::shared_ptr<CoverImage>& image) {
+    if (albumId.isEmpty()) {
+        return;
+    }
+
+    // A flash write takes a while, user requests queued meanwhile go first
+    RequestQueue::getInstance().submit(
+        [this, albumId, image]() { return cache.write(albumId, *image); },
+        nullptr, RequestPriority::BACKGROUND);
+}
+
+bool AlbumArtLoader::fetch(const SpotifyId& albumId, const Url& url,
+                           const std::function<bool()>& cancelled, Fetched& result) {
+    if (cancelled()) {
+        return false;
+    }
+
+    auto image = std::make_shared<CoverImage>();
+
+    result.fromCache = cache.read(albumId, ALBUM_ART_SIZE, *image);
+    if (result.fromCache) {
+        Serial.printf("🖼️  Album art %s from flash in %lu ms\n",
+                      albumId.c_str(), cache.getStats().lastReadMs);
+    } else {
+        if (!decode(url, *image, cancelled)) {
+            return false;
+        }
+        result.decodeMs = decoder.getInfo().decodeUs / 1000;
+    }
+
+    // Lists show the same cover smaller, scaling the decoded one is cheap
+    auto thumbnail = std::make_shared<CoverImage>();
+    if (!thumbnail->scaleFrom(*image, ALBUM_THUMB_SIZE, ALBUM_THUMB_SIZE)) {
+        thumbnail.reset();
+    }
+
+    result.image = std::move(image);
+    result.thumbnail = std::move(thumbnail);
+    return true;
+}
+
+bool AlbumArtLoader::decode(const Url& url, CoverImage& image, const std::function<bool()>& cancelled) {
+    // ALBUM_ART_PATH is only replaced once the new cover is complete
+    if (!client->downloadImage(url.c_str(), ALBUM_ART_PATH, cancelled) || cancelled()) {
+        return false;
+    }
+
+    if (!image.allocate(ALBUM_ART_SIZE, ALBUM_ART_SIZE)) {
+        return false;
+    }
+
+    File file = LittleFS.open(ALBUM_ART_PATH, "r");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = decoder.decode(file, image.getPixels(), ALBUM_ART_SIZE, ALBUM_ART_SIZE);
+    file.close();
+
+    if (!ok) {
+        Serial.printf("❌ Album art decode failed: %s\n", decoder.getError());
+        return false;
+    }
+
+    const JpegDecoder::Info& info = decoder.getInfo();
+    Serial.printf("🖼️  Album art %dx%d decoded at 1/%d in %lu ms (%u bytes work)\n",
+                  info.width, info.height, info.scale, info.decodeUs / 1000,
+                  static_cast<unsigned>(info.workBytes));
+
+    image.setValid(true);
+    return true;
+}
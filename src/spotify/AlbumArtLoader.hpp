@@ -0,0 +1,227 @@
+/**
+ * @file AlbumArtLoader.hpp
+ * @brief Album Art Downloads
+ *
+ * Fetches the cover of the current track in the background:
+ * - keeps at most one download in flight, on the request worker
+ * - a download for a cover that is no longer wanted (the track changed)
+ *   is dropped between chunks, or never started if it is still queued
+ * - the image goes straight to a LittleFS file, never into RAM as a whole
+ * - the worker then decodes it at the size it is shown (JpegDecoder), so
+ *   the loop task only has to point the widget at the finished bitmap
+ * - decoded covers are kept on flash per album (CoverCache), the next
+ *   track of the same album or a reboot doesn't download them again
+ * - the last few albums stay decoded in PSRAM (CoverImageCache), along
+ *   with a thumbnail for lists, so going back to one is a lookup
+ * - covers of upcoming tracks can be prefetched into both caches, so the
+ *   next track change shows its cover right away
+ */
+
+#ifndef ALBUM_ART_LOADER_HPP
+#define ALBUM_ART_LOADER_HPP
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "SpotifyClient.hpp"
+#include "../display/CoverImage.hpp"
+#include "../utils/JpegDecoder.hpp"
+#include "CoverCache.hpp"
+#include "CoverImageCache.hpp"
+#include "SpotifyId.hpp"
+
+// Where the last downloaded cover is stored
+#define ALBUM_ART_PATH "/cover.jpg"
+
+// Edge of the decoded cover (px), as shown on Now Playing
+#ifndef ALBUM_ART_SIZE
+#define ALBUM_ART_SIZE 220
+#endif
+
+// Edge of the list thumbnail made from each cover (px)
+#ifndef ALBUM_THUMB_SIZE
+#define ALBUM_THUMB_SIZE 64
+#endif
+
+// Prefetches queued at a time, more are dropped
+#define ALBUM_ART_PREFETCH_MAX 2
+
+/**
+ * @brief Album Art Loader Class
+ *
+ * Use from the loop task only. Usage:
+ *
+ *     loader.setLoadedHandler([](const char* url, const std::shared_ptr<CoverImage>& image) {
+ *         shown = image;      // Keep it while the widget shows it
+ *         lv_image_set_src(widget, image->getDescriptor());
+ *     });
+ *     loader.load(track.albumId, track.coverUrl.c_str());
+ */
+class AlbumArtLoader {
+public:
+    using LoadedHandler = std::function<void(const char* url, const std::shared_ptr<CoverImage>& image)>;
+
+    /**
+     * @brief Download statistics
+     */
+    struct Stats {
+        uint32_t requests;      // Loads started
+        uint32_t completed;
+        uint32_t cached;        // Completed from the flash cache (PSRAM hits don't get this far)
+        uint32_t cancelled;     // Superseded while queued or running
+        uint32_t failed;        // Download or decode failed
+        uint32_t prefetched;    // Covers of upcoming tracks made ready
+        unsigned long lastLatencyMs;   // load() until the cover was decoded
+        unsigned long lastDecodeMs;
+
+        Stats()
+            : requests(0)
+            , completed(0)
+            , cached(0)
+            , cancelled(0)
+            , failed(0)
+            , prefetched(0)
+            , lastLatencyMs(0)
+            , lastDecodeMs(0) {
+        }
+    };
+
+    explicit AlbumArtLoader(SpotifyClient* client);
+
+    /**
+     * @brief Set the callback for decoded covers (on the loop task)
+     */
+    void setLoadedHandler(LoadedHandler handler) { loadedHandler = handler; }
+
+    /**
+     * @brief Load a cover, replacing whatever was wanted before
+     *
+     * Does nothing if url is already on its way. If the cover is
+     * decoded in PSRAM, the handler is called right away.
+     * @param albumId Cache key, covers without one aren't cached
+     */
+    void load(const SpotifyId& albumId, const char* url);
+
+    /**
+     * @brief Get a cover ready for a later load() (upcoming tracks)
+     *
+     * Reads or downloads it in the background and keeps it in the caches,
+     * the handler isn't called. Queued behind everything else; a load()
+     * of the same album meanwhile waits for it instead of downloading
+     * it again. Does nothing if the cover is already in PSRAM.
+     */
+    void prefetch(const SpotifyId& albumId, const char* url);
+
+    /**
+     * @brief Drop the wanted cover and any download in flight
+     */
+    void cancel();
+
+    /**
+     * @brief Check if a cover is still on its way
+     */
+    bool isLoading() const { return !wantedUrl.isEmpty(); }
+
+    /**
+     * @brief Get download statistics
+     */
+    const Stats& getStats() const { return stats; }
+
+    /**
+     * @brief Get a decoded cover if it is in PSRAM
+     * @param edge ALBUM_ART_SIZE or ALBUM_THUMB_SIZE
+     * @return nullptr if it isn't, nothing is loaded
+     */
+    std::shared_ptr<CoverImage> getCover(const SpotifyId& albumId, int edge) {
+        return images.get(albumId, edge);
+    }
+
+    /**
+     * @brief Get flash cache statistics
+     */
+    const CoverCache::Stats& getCacheStats() const { return cache.getStats(); }
+
+    /**
+     * @brief Get PSRAM cache statistics
+     */
+    const CoverImageCache::Stats& getImageCacheStats() const { return images.getStats(); }
+
+private:
+    using Url = FixedString<SPOTIFY_IMAGE_URL_LENGTH>;
+
+    /**
+     * @brief Result of fetch(), handed to its completion
+     */
+    struct Fetched {
+        std::shared_ptr<CoverImage> image;
+        std::shared_ptr<CoverImage> thumbnail;
+        bool fromCache;
+        unsigned long decodeMs;
+
+        Fetched()
+            : fromCache(false)
+            , decodeMs(0) {
+        }
+    };
+
+    /**
+     * @brief Queue the download of the wanted cover
+     */
+    void send();
+
+    /**
+     * @brief Read, or download and decode, the cover and its thumbnail (worker task)
+     */
+    bool fetch(const SpotifyId& albumId, const Url& url,
+               const std::function<bool()>& cancelled, Fetched& result);
+
+    /**
+     * @brief Put a fetched cover in PSRAM, and on flash if it was downloaded
+     */
+    void keep(const SpotifyId& albumId, const Fetched& result);
+
+    /**
+     * @brief Hand the wanted cover to the handler
+     */
+    void deliver(const std::shared_ptr<CoverImage>& image);
+
+    /**
+     * @brief Find the prefetch slot of an album, or -1
+     */
+    int findPrefetch(const SpotifyId& albumId) const;
+
+    /**
+     * @brief Download a cover and decode it at ALBUM_ART_SIZE (worker task)
+     */
+    bool decode(const Url& url, CoverImage& image, const std::function<bool()>& cancelled);
+
+    /**
+     * @brief Queue writing a decoded cover to the flash cache
+     */
+    void store(const SpotifyId& albumId, const std::shared_ptr<CoverImage>& image);
+
+    SpotifyClient* client;
+    LoadedHandler loadedHandler;
+
+    Url wantedUrl;                  // Empty when nothing is wanted
+    SpotifyId wantedAlbumId;
+    Url loadedUrl;                  // Last cover loaded, for covers without an album id
+    std::shared_ptr<CoverImage> loaded;
+    unsigned long wantedSince;
+    bool inFlight;
+
+    CoverImageCache images;
+    JpegDecoder decoder;            // Worker task only
+    CoverCache cache;               // Worker task only
+
+    // Albums being prefetched, empty slots are free
+    SpotifyId prefetching[ALBUM_ART_PREFETCH_MAX];
+
+    // Changes whenever the download in flight goes stale
+    std::atomic<uint32_t> generation;
+
+    Stats stats;
+};
+
+#endif // ALBUM_ART_LOADER_HPP
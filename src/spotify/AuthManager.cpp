@@ -4,9 +4,15 @@
  */
 
 #include "AuthManager.hpp"
+#include "SpotifyClient.hpp"  // SPOTIFY_SCOPES
+#include "../network/HttpsTransport.hpp"
 
-AuthManager::AuthManager()
-    : tokenExpiryTime(0)
+#include <base64.h>
+#include <sha/sha_parallel_engine.h>
+
+AuthManager::AuthManager(HttpTransport* transport)
+    : transport(transport ? transport : &HttpsTransport::getInstance())
+    , tokenExpiryTime(0)
     , authServer(nullptr)
     , state(AuthState::NONE)
     , authStartTime(0)
@@ -49,7 +55,7 @@ void AuthManager::startAuthServer() {
     // Generate PKCE values
     codeVerifier = generateCodeVerifier();
     codeChallenge = generateCodeChallenge(codeVerifier);
-    state = generateState();
+    oauthState = generateState();
 
     // Create web server
     authServer = new WebServer(AUTH_SERVER_PORT);
@@ -64,7 +70,7 @@ void AuthManager::startAuthServer() {
     Serial.printf("✅ Auth server started on port %d\n", AUTH_SERVER_PORT);
     Serial.printf("🔗 Auth URL: %s\n", getAuthUrl().c_str());
 
-    this->state = AuthState::WAITING_FOR_AUTH;
+    state = AuthState::WAITING_FOR_AUTH;
     authStartTime = millis();
 }
 
@@ -85,19 +91,12 @@ String AuthManager::getAuthUrl() {
     url += "&scope=" + String(SPOTIFY_SCOPES);
     url += "&code_challenge=" + codeChallenge;
     url += "&code_challenge_method=S256";
-    url += "&state=" + state;
+    url += "&state=" + oauthState;
 
     return url;
 }
 
 bool AuthManager::exchangeCodeForTokens(const String& code) {
-    WiFiClientSecure client;
-    client.setInsecure();
-
-    HTTPClient http;
-    http.begin(client, SPOTIFY_TOKEN_URL);
-    http.addHeader("Content-Type", "application/x-www-form-urlencoded");
-
     // Build request body
     String body = "grant_type=authorization_code";
     body += "&code=" + code;
@@ -105,10 +104,8 @@ bool AuthManager::exchangeCodeForTokens(const String& code) {
     body += "&client_id=" + clientId;
     body += "&code_verifier=" + codeVerifier;
 
-    int httpCode = http.POST(body);
-    String response = http.getString();
-
-    http.end();
+    String response;
+    int httpCode = postTokenRequest(body, response);
 
     if (httpCode == 200) {
         StaticJsonDocument<1024> doc;
@@ -139,22 +136,13 @@ bool AuthManager::exchangeCodeForTokens(const String& code) {
     return false;
 }
 
-String AuthManager::refreshAccessToken(const String& refreshToken) {
-    WiFiClientSecure client;
-    client.setInsecure();
-
-    HTTPClient http;
-    http.begin(client, SPOTIFY_TOKEN_URL);
-    http.addHeader("Content-Type", "application/x-www-form-urlencoded");
-
+String AuthManager::refreshAccessToken(const String& currentRefreshToken) {
     String body = "grant_type=refresh_token";
-    body += "&refresh_token=" + refreshToken;
+    body += "&refresh_token=" + currentRefreshToken;
     body += "&client_id=" + clientId;
 
-    int httpCode = http.POST(body);
-    String response = http.getString();
-
-    http.end();
+    String response;
+    int httpCode = postTokenRequest(body, response);
 
     if (httpCode == 200) {
         StaticJsonDocument<1024> doc;
@@ -164,8 +152,10 @@ String AuthManager::refreshAccessToken(const String& refreshToken) {
             String newToken = doc["access_token"].as<String>();
             int expiresIn = doc["expires_in"].as<int>();
 
+            accessToken = newToken;
+            refreshToken = doc["refresh_token"] | currentRefreshToken.c_str();
             tokenExpiryTime = millis() + (expiresIn * 1000);
-            Serial.println("✅ Access token refreshed");
+            Serial.printf("✅ Access token refreshed, expires in %d seconds\n", expiresIn);
 
             return newToken;
         }
@@ -175,6 +165,26 @@ String AuthManager::refreshAccessToken(const String& refreshToken) {
     return "";
 }
 
+int AuthManager::postTokenRequest(const String& body, String& response) {
+    HttpRequest request("POST", SPOTIFY_TOKEN_URL);
+    request.contentType = "application/x-www-form-urlencoded";
+    request.body = body.c_str();
+    request.bodyLength = body.length();
+
+    return transport->send(request, [&response](HttpResponse& httpResponse) {
+        int size = httpResponse.getSize();
+        if (size > 0) {
+            response.reserve(size);
+        }
+
+        char buffer[128];
+        size_t length;
+        while ((length = httpResponse.getBody().readBytes(buffer, sizeof(buffer))) > 0) {
+            response.concat(buffer, length);
+        }
+    });
+}
+
 void AuthManager::handleWebServer() {
     if (authServer) {
         authServer->handleClient();
@@ -198,13 +208,13 @@ void AuthManager::handleIndex() {
     html += "<div class='container'>";
     html += "<p>Connect your Spotify account to control playback.</p>";
 
-    if (this->state == AuthState::WAITING_FOR_AUTH) {
+    if (state == AuthState::WAITING_FOR_AUTH) {
         html += "<div class='status'>Waiting for authentication...</div>";
         html += "<a href='" + getAuthUrl() + "' class='btn'>Connect Spotify</a>";
-    } else if (this->state == AuthState::AUTHENTICATED) {
+    } else if (state == AuthState::AUTHENTICATED) {
         html += "<div class='status' style='background:#d4edda;'>✅ Successfully connected!</div>";
         html += "<p>You can close this window.</p>";
-    } else if (this->state == AuthState::ERROR) {
+    } else if (state == AuthState::ERROR) {
         html += "<div class='status' style='background:#f8d7da;'>❌ Authentication failed</div>";
         html += "<a href='/' class='btn'>Try Again</a>";
     }
@@ -216,7 +226,7 @@ void AuthManager::handleIndex() {
 
 void AuthManager::handleCallback() {
     // Check state
-    if (!authServer->hasArg("state") || authServer->arg("state") != state) {
+    if (!authServer->hasArg("state") || authServer->arg("state") != oauthState) {
         Serial.println("⚠️  Invalid state parameter");
         state = AuthState::ERROR;
         authServer->send(400, "text/plain", "Invalid state");
@@ -257,9 +267,16 @@ String AuthManager::generateCodeVerifier() {
 }
 
 String AuthManager::generateCodeChallenge(const String& verifier) {
-    // SHA-256 hash, then Base64 URL encode
-    String hash = sha256(verifier);
-    return base64UrlEncode(hash);
+    // SHA-256 hash (already Base64), then make it URL safe
+    String encoded = sha256(verifier);
+    encoded.replace("+", "-");
+    encoded.replace("/", "_");
+
+    while (encoded.endsWith("=")) {
+        encoded.remove(encoded.length() - 1);
+    }
+
+    return encoded;
 }
 
 String AuthManager::generateState() {
@@ -309,23 +326,8 @@ String AuthManager::base64UrlDecode(const String& input) {
 String AuthManager::sha256(const String& input) {
     // Use ESP32 hardware SHA-256
     uint8_t hash[32];
-    esp_sha(SHA256, (const uint8_t*)input.c_str(), input.length(), hash);
-
-    // Convert to hex string, then encode
-    String hex;
-    for (int i = 0; i < 32; i++) {
-        char buf[4];
-        sprintf(buf, "%02x", hash[i]);
-        hex += buf;
-    }
-
-    // Convert hex to bytes
-    std::vector<uint8_t> bytes;
-    for (size_t i = 0; i < hex.length(); i += 2) {
-        uint8_t byte = strtol(hex.substring(i, i + 2).c_str(), NULL, 16);
-        bytes.push_back(byte);
-    }
+    esp_sha(SHA2_256, (const uint8_t*)input.c_str(), input.length(), hash);
 
-    // Base64 encode
-    return base64::encode((const char*)bytes.data(), bytes.size());
+    // Base64 encode the raw digest
+    return base64::encode(hash, sizeof(hash));
 }
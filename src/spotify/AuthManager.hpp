@@ -13,11 +13,13 @@
 #include <ArduinoJson.h>
 #include <WiFi.h>
 #include <WebServer.h>
-#include <WiFiClientSecure.h>
+#include "../network/HttpTransport.hpp"
 
 // Spotify Auth endpoints
 #define SPOTIFY_AUTH_URL "https://accounts.spotify.com/authorize"
+#ifndef SPOTIFY_TOKEN_URL
 #define SPOTIFY_TOKEN_URL "https://accounts.spotify.com/api/token"
+#endif
 
 // Auth server settings
 #define AUTH_SERVER_PORT 8080
@@ -38,7 +40,10 @@ enum class AuthState {
  */
 class AuthManager {
 public:
-    AuthManager();
+    /**
+     * @param transport Where token requests go, HttpsTransport if nullptr
+     */
+    explicit AuthManager(HttpTransport* transport = nullptr);
     ~AuthManager();
 
     /**
@@ -81,6 +86,19 @@ public:
      */
     String getRefreshToken() const { return refreshToken; }
 
+    /**
+     * @brief Get the millis() at which the access token expires
+     */
+    unsigned long getTokenExpiryTime() const { return tokenExpiryTime; }
+
+    /**
+     * @brief Get the time left until the access token expires, 0 once it has
+     */
+    unsigned long getMsUntilExpiry() const {
+        long remaining = (long)(tokenExpiryTime - millis());
+        return remaining > 0 ? remaining : 0;
+    }
+
     /**
      * @brief Get authorization URL
      */
@@ -93,8 +111,11 @@ public:
 
     /**
      * @brief Refresh access token
+     *
+     * Also updates the refresh token if Spotify sends a new one.
+     * @return New access token, empty on failure
      */
-    String refreshAccessToken(const String& refreshToken);
+    String refreshAccessToken(const String& currentRefreshToken);
 
     /**
      * @brief Generate PKCE code verifier
@@ -112,6 +133,12 @@ public:
     String generateState();
 
 private:
+    /**
+     * @brief POST a form body to the token endpoint
+     * @return HTTP status code or HTTPC_ERROR_* (< 0)
+     */
+    int postTokenRequest(const String& body, String& response);
+
     /**
      * @brief Handle web server requests
      */
@@ -147,6 +174,9 @@ private:
      */
     String sha256(const String& input);
 
+    // Token requests
+    HttpTransport* transport;
+
     // Client credentials
     String clientId;
     String clientSecret;
@@ -159,7 +189,7 @@ private:
     // PKCE
     String codeVerifier;
     String codeChallenge;
-    String state;
+    String oauthState;
 
     // Web server
     WebServer* authServer;
@@ -0,0 +1,112 @@
+/**
+ * @file CoalescedCommand.cpp
+ * @brief Latest-Wins Command Coalescing Implementation
+ */
+
+#include "CoalescedCommand.hpp"
+#include "../network/RequestQueue.hpp"
+
+CoalescedCommand::CoalescedCommand(const char* name, Sender sender, FailureHandler onFailure)
+    : name(name)
+    , sender(sender)
+    , onFailure(onFailure)
+    , value(0)
+    , queued(false)
+    , active(false)
+    , outstanding(0)
+    , interactionChanges(0)
+    , interactionSent(0) {
+}
+
+void CoalescedCommand::set(int newValue) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = newValue;
+        active = true;
+        interactionChanges++;
+        stats.changes++;
+
+        // The queued request sends whatever value is latest when it runs
+        if (queued) {
+            return;
+        }
+        queued = true;
+        outstanding++;
+    }
+
+    bool submitted = RequestQueue::getInstance().submit(
+        [this]() { return send(); },
+        [this](bool ok) { onComplete(ok); });
+
+    // No request will complete the interaction, fail it like a request would
+    if (!submitted) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queued = false;
+        }
+        onComplete(false);
+    }
+}
+
+int CoalescedCommand::getLatest(int fallback) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return active ? value : fallback;
+}
+
+bool CoalescedCommand::isActive() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return active;
+}
+
+CoalescedCommand::Stats CoalescedCommand::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+// Private methods
+
+bool CoalescedCommand::send() {
+    int sendValue;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sendValue = value;
+        queued = false;
+        interactionSent++;
+        stats.sent++;
+    }
+
+    return sender(sendValue);
+}
+
+void CoalescedCommand::onComplete(bool ok) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        outstanding--;
+
+        // A newer value is still on its way, the interaction goes on
+        if (outstanding > 0 || !active) {
+            return;
+        }
+
+        finishInteraction();
+    }
+
+    if (!ok && onFailure) {
+        onFailure();
+    }
+}
+
+void CoalescedCommand::finishInteraction() {
+    active = false;
+    stats.interactions++;
+    stats.lastChanges = interactionChanges;
+    stats.lastSent = interactionSent;
+
+    Serial.printf("🎚  %s: %u changes, %u requests (%u saved)\n", name,
+                  (unsigned)interactionChanges, (unsigned)interactionSent,
+                  (unsigned)(interactionChanges - interactionSent));
+
+    interactionChanges = 0;
+    interactionSent = 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file CoalescedCommand.hpp
+ * @brief Latest-Wins Command Coalescing
+ *
+ * For commands that carry a value (volume, seek position) only the
+ * latest value matters. While a request is queued, new values replace
+ * its value instead of queueing another request, so a slider drag
+ * costs at most one running and one queued request.
+ */
+
+#ifndef COALESCED_COMMAND_HPP
+#define COALESCED_COMMAND_HPP
+
+#include <Arduino.h>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Coalesced Command Class
+ */
+class CoalescedCommand {
+public:
+    /**
+     * @brief Sends a value, runs on the request worker
+     */
+    using Sender = std::function<bool(int)>;
+
+    /**
+     * @brief Called on the loop task when the latest value failed
+     */
+    using FailureHandler = std::function<void()>;
+
+    /**
+     * @brief Coalescing statistics
+     */
+    struct Stats {
+        uint32_t interactions;   // Bursts of changes until the last request finished
+        uint32_t changes;        // Values set
+        uint32_t sent;           // Requests actually sent
+        uint32_t lastChanges;    // Changes in the last interaction
+        uint32_t lastSent;       // Requests in the last interaction
+
+        Stats()
+            : interactions(0)
+            , changes(0)
+            , sent(0)
+            , lastChanges(0)
+            , lastSent(0) {
+        }
+
+        uint32_t saved() const { return changes - sent; }
+    };
+
+    /**
+     * @param name Name for logging
+     * @param sender Sends the value, returns success
+     * @param onFailure Reconciles the state when the latest value failed
+     */
+    CoalescedCommand(const char* name, Sender sender, FailureHandler onFailure);
+
+    /**
+     * @brief Set a new value, queueing a request if none is queued
+     */
+    void set(int value);
+
+    /**
+     * @brief Get the latest value set in the current interaction
+     * @param fallback Returned when no interaction is in progress
+     */
+    int getLatest(int fallback) const;
+
+    /**
+     * @brief Check if a request is queued or running
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Get statistics
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Send the latest value (on the worker)
+     */
+    bool send();
+
+    /**
+     * @brief Request finished (on the loop task)
+     *
+     * A failure is only reported if no newer value is on its way, the newer
+     * request reconciles the state either way.
+     */
+    void onComplete(bool ok);
+
+    /**
+     * @brief End the interaction and log its statistics (mutex held)
+     */
+    void finishInteraction();
+
+    const char* name;
+    Sender sender;
+    FailureHandler onFailure;
+
+    mutable std::mutex mutex;
+    int value;
+    bool queued;     // A request is waiting and will pick up value
+    bool active;     // Interaction in progress
+    uint32_t outstanding;  // Requests submitted and not completed yet
+    uint32_t interactionChanges;
+    uint32_t interactionSent;
+
+    Stats stats;
+};
+
+#endif // COALESCED_COMMAND_HPP
@@ -0,0 +1,309 @@
+/**
+ * @file CoverCache.cpp
+ * @brief Decoded Album Art on Flash Implementation
+ */
+
+#include "CoverCache.hpp"
+#include <LittleFS.h>
+
+#define COVER_FILE_MAGIC 0x31565243     // "CRV1"
+#define COVER_INDEX_MAGIC 0x31584943    // "CIX1"
+#define COVER_PATH_LENGTH 48
+
+// Start of every cover file, followed by width * height RGB565 pixels
+struct CoverFileHeader {
+    uint32_t magic;
+    uint16_t width;
+    uint16_t height;
+};
+
+struct CoverIndexHeader {
+    uint32_t magic;
+    uint16_t entrySize;         // Detects a changed Entry layout
+    uint16_t count;
+    uint32_t useClock;
+};
+
+// Ids end up in file names
+static bool isValidId(const SpotifyId& albumId) {
+    if (albumId.isEmpty()) {
+        return false;
+    }
+    for (const char* c = albumId.c_str(); *c; c++) {
+        if (!isalnum(static_cast<unsigned char>(*c))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CoverCache::CoverCache(size_t budget)
+    : budget(budget)
+    , loaded(false)
+    , entryCount(0)
+    , useClock(0) {
+}
+
+bool CoverCache::read(const SpotifyId& albumId, int edge, CoverImage& image) {
+    unsigned long start = millis();
+    image.setValid(false);
+
+    if (!isValidId(albumId)) {
+        return false;
+    }
+
+    ensureLoaded();
+
+    int index = find(albumId, edge);
+    if (index < 0) {
+        stats.misses++;
+        return false;
+    }
+
+    char path[COVER_PATH_LENGTH];
+    makePath(path, sizeof(path), albumId.c_str(), edge);
+
+    File file = LittleFS.open(path, FILE_READ);
+    CoverFileHeader header = {};
+    size_t pixelBytes = sizeof(uint16_t) * edge * edge;
+
+    bool ok = file
+        && file.size() == sizeof(header) + pixelBytes
+        && file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header)
+        && header.magic == COVER_FILE_MAGIC && header.width == edge && header.height == edge
+        && image.allocate(edge, edge)
+        && file.read(reinterpret_cast<uint8_t*>(image.getPixels()), pixelBytes) == pixelBytes;
+
+    if (file) {
+        file.close();
+    }
+
+    if (!ok) {
+        // Deleted or cut short, fetch it again
+        Serial.printf("⚠️  Cover cache entry %s broken, dropped\n", path);
+        remove(index);
+        stats.misses++;
+        return false;
+    }
+
+    // Only in memory, saved with the next write (no flash writes for hits)
+    entries[index].lastUsed = ++useClock;
+
+    image.setValid(true);
+    stats.hits++;
+    stats.lastReadMs = millis() - start;
+    return true;
+}
+
+bool CoverCache::write(const SpotifyId& albumId, const CoverImage& image) {
+    if (!image.isValid() || image.getWidth() != image.getHeight() || !isValidId(albumId)) {
+        return false;
+    }
+
+    ensureLoaded();
+
+    int edge = image.getWidth();
+    size_t pixelBytes = sizeof(uint16_t) * edge * edge;
+    size_t bytes = sizeof(CoverFileHeader) + pixelBytes;
+    if (bytes > budget) {
+        return false;
+    }
+
+    char path[COVER_PATH_LENGTH];
+    char tempPath[COVER_PATH_LENGTH + 4];
+    makePath(path, sizeof(path), albumId.c_str(), edge);
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    // An older copy of the same cover goes first
+    int existing = find(albumId, edge);
+    if (existing >= 0) {
+        remove(existing);
+    }
+
+    // Least recently used covers make room
+    while (entryCount > 0 &&
+           (entryCount >= COVER_CACHE_MAX_ENTRIES || stats.bytes + bytes > budget)) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < entryCount; i++) {
+            if (entries[i].lastUsed < entries[oldest].lastUsed) {
+                oldest = i;
+            }
+        }
+        remove(oldest);
+        stats.evictions++;
+    }
+
+    File file = LittleFS.open(tempPath, FILE_WRITE);
+    if (!file) {
+        Serial.printf("⚠️  Failed to create %s\n", tempPath);
+        saveIndex();
+        return false;
+    }
+
+    CoverFileHeader header = { COVER_FILE_MAGIC, static_cast<uint16_t>(edge), static_cast<uint16_t>(edge) };
+    bool ok = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header)
+        && file.write(reinterpret_cast<const uint8_t*>(image.getPixels()), pixelBytes) == pixelBytes;
+    file.close();
+
+    if (!ok || !LittleFS.rename(tempPath, path)) {
+        Serial.printf("⚠️  Failed to write %s (flash full?)\n", path);
+        LittleFS.remove(tempPath);
+        saveIndex();
+        return false;
+    }
+
+    Entry& entry = entries[entryCount++];
+    memset(&entry, 0, sizeof(entry));
+    strncpy(entry.albumId, albumId.c_str(), sizeof(entry.albumId) - 1);
+    entry.bytes = bytes;
+    entry.lastUsed = ++useClock;
+    entry.edge = edge;
+
+    stats.bytes += bytes;
+    stats.entries = entryCount;
+    stats.writes++;
+
+    return saveIndex();
+}
+
+void CoverCache::clear() {
+    ensureLoaded();
+
+    while (entryCount > 0) {
+        remove(entryCount - 1);
+    }
+    saveIndex();
+}
+
+// Private methods
+
+void CoverCache::ensureLoaded() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    LittleFS.mkdir(COVER_CACHE_DIR);
+
+    File file = LittleFS.open(COVER_CACHE_INDEX, FILE_READ);
+    if (file) {
+        CoverIndexHeader header = {};
+        bool ok = file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header)
+            && header.magic == COVER_INDEX_MAGIC
+            && header.entrySize == sizeof(Entry)
+            && header.count <= COVER_CACHE_MAX_ENTRIES
+            && file.size() == sizeof(header) + header.count * sizeof(Entry)
+            && file.read(reinterpret_cast<uint8_t*>(entries), header.count * sizeof(Entry))
+                   == header.count * sizeof(Entry);
+        file.close();
+
+        if (ok) {
+            entryCount = header.count;
+            useClock = header.useClock;
+        } else {
+            Serial.println("⚠️  Cover cache index invalid, starting empty");
+        }
+    }
+
+    stats.bytes = 0;
+    for (size_t i = 0; i < entryCount; i++) {
+        entries[i].albumId[SPOTIFY_ID_LENGTH] = '\0';
+        stats.bytes += entries[i].bytes;
+    }
+    stats.entries = entryCount;
+
+    removeOrphans();
+
+    Serial.printf("🖼️  Cover cache: %u covers, %u KB\n",
+                  static_cast<unsigned>(entryCount), static_cast<unsigned>(stats.bytes / 1024));
+}
+
+bool CoverCache::saveIndex() {
+    const char* tempPath = COVER_CACHE_INDEX ".tmp";
+
+    File file = LittleFS.open(tempPath, FILE_WRITE);
+    if (!file) {
+        Serial.println("⚠️  Failed to create the cover cache index");
+        return false;
+    }
+
+    CoverIndexHeader header = {
+        COVER_INDEX_MAGIC, static_cast<uint16_t>(sizeof(Entry)),
+        static_cast<uint16_t>(entryCount), useClock
+    };
+    size_t length = entryCount * sizeof(Entry);
+    bool ok = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header)
+        && file.write(reinterpret_cast<const uint8_t*>(entries), length) == length;
+    file.close();
+
+    // rename() replaces the old index in one step, a crash leaves one of the two
+    if (!ok || !LittleFS.rename(tempPath, COVER_CACHE_INDEX)) {
+        Serial.println("⚠️  Failed to write the cover cache index");
+        LittleFS.remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void CoverCache::removeOrphans() {
+    // Removing while iterating isn't safe, start over after each file
+    // (there are only orphans after a crash)
+    bool removed;
+    do {
+        removed = false;
+
+        File dir = LittleFS.open(COVER_CACHE_DIR);
+        if (!dir || !dir.isDirectory()) {
+            return;
+        }
+
+        char orphan[COVER_PATH_LENGTH + 4] = "";
+        for (File file = dir.openNextFile(); file && !orphan[0]; file = dir.openNextFile()) {
+            char path[COVER_PATH_LENGTH + 4];
+            snprintf(path, sizeof(path), COVER_CACHE_DIR "/%s", file.name());
+            bool known = file.isDirectory() || strcmp(path, COVER_CACHE_INDEX) == 0;
+            file.close();
+
+            for (size_t i = 0; i < entryCount && !known; i++) {
+                char entryPath[COVER_PATH_LENGTH];
+                makePath(entryPath, sizeof(entryPath), entries[i].albumId, entries[i].edge);
+                known = strcmp(path, entryPath) == 0;
+            }
+
+            if (!known) {
+                strcpy(orphan, path);
+            }
+        }
+        dir.close();
+
+        if (orphan[0]) {
+            Serial.printf("🗑️  Removing unknown cover file %s\n", orphan);
+            removed = LittleFS.remove(orphan);
+        }
+    } while (removed);
+}
+
+int CoverCache::find(const SpotifyId& albumId, int edge) const {
+    for (size_t i = 0; i < entryCount; i++) {
+        if (entries[i].edge == edge && albumId == entries[i].albumId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void CoverCache::remove(int index) {
+    char path[COVER_PATH_LENGTH];
+    makePath(path, sizeof(path), entries[index].albumId, entries[index].edge);
+    LittleFS.remove(path);
+
+    stats.bytes -= entries[index].bytes;
+
+    // Order doesn't matter, the last entry fills the gap
+    entries[index] = entries[--entryCount];
+    stats.entries = entryCount;
+}
+
+void CoverCache::makePath(char* path, size_t size, const char* albumId, int edge) {
+    snprintf(path, size, COVER_CACHE_DIR "/%s_%d", albumId, edge);
+}
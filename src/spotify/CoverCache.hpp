@@ -0,0 +1,128 @@
+/**
+ * @file CoverCache.hpp
+ * @brief Decoded Album Art on Flash
+ *
+ * Keeps covers on LittleFS the way they are shown: RGB565 pixels at the
+ * display size, keyed by album id. A cached cover is a file read, with
+ * no download and no decode, and survives reboots.
+ *
+ * - A small binary index (COVER_CACHE_INDEX) holds the entries and
+ *   their last use, so nothing has to scan the directory to find one
+ * - The least recently used covers are deleted to stay within a byte
+ *   budget
+ * - Covers and the index are written to a .tmp file and renamed; files
+ *   the index doesn't know (a crash between the two) are deleted when
+ *   the index is loaded, entries whose file is gone are dropped on read
+ */
+
+#ifndef COVER_CACHE_HPP
+#define COVER_CACHE_HPP
+
+#include <Arduino.h>
+#include "SpotifyId.hpp"
+#include "../display/CoverImage.hpp"
+
+// Cache settings
+#define COVER_CACHE_DIR "/covers"
+#define COVER_CACHE_INDEX COVER_CACHE_DIR "/index"
+#define COVER_CACHE_MAX_ENTRIES 32
+#ifndef COVER_CACHE_BUDGET
+#define COVER_CACHE_BUDGET (1024 * 1024)  // Ten 220x220 covers
+#endif
+
+/**
+ * @brief Cover Cache Class
+ *
+ * Use from one task only (the request worker, flash access is slow);
+ * getStats() can be read from anywhere.
+ */
+class CoverCache {
+public:
+    /**
+     * @brief Cache statistics
+     */
+    struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t writes;
+        uint32_t evictions;
+        uint32_t bytes;         // Covers on flash
+        uint16_t entries;
+        unsigned long lastReadMs;
+
+        Stats()
+            : hits(0)
+            , misses(0)
+            , writes(0)
+            , evictions(0)
+            , bytes(0)
+            , entries(0)
+            , lastReadMs(0) {
+        }
+    };
+
+    explicit CoverCache(size_t budget = COVER_CACHE_BUDGET);
+
+    /**
+     * @brief Read a cover into image
+     * @param edge Width and height of the wanted cover
+     * @return false if it isn't cached (image is then invalid)
+     */
+    bool read(const SpotifyId& albumId, int edge, CoverImage& image);
+
+    /**
+     * @brief Store a decoded cover, evicting old ones to make room
+     */
+    bool write(const SpotifyId& albumId, const CoverImage& image);
+
+    /**
+     * @brief Delete all cached covers
+     */
+    void clear();
+
+    /**
+     * @brief Get cache statistics
+     */
+    const Stats& getStats() const { return stats; }
+
+private:
+    // Index file record
+    struct Entry {
+        char albumId[SPOTIFY_ID_LENGTH + 2];
+        uint32_t bytes;
+        uint32_t lastUsed;      // Value of useClock at the last read or write
+        uint16_t edge;
+        uint16_t reserved;
+    };
+
+    /**
+     * @brief Load the index on first use and delete unknown files
+     */
+    void ensureLoaded();
+
+    bool saveIndex();
+    void removeOrphans();
+
+    /**
+     * @brief Find an entry, or -1
+     */
+    int find(const SpotifyId& albumId, int edge) const;
+
+    /**
+     * @brief Delete an entry and its file (index saved by the caller)
+     */
+    void remove(int index);
+
+    static void makePath(char* path, size_t size, const char* albumId, int edge);
+
+    size_t budget;
+    bool loaded;
+
+    Entry entries[COVER_CACHE_MAX_ENTRIES];
+    size_t entryCount;
+    uint32_t useClock;
+
+    Stats stats;
+};
+
+#endif // COVER_CACHE_HPP
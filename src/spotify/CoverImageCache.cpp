@@ -0,0 +1,85 @@
+/**
+ * @file CoverImageCache.cpp
+ * @brief Decoded Album Art in PSRAM Implementation
+ */
+
+#include "CoverImageCache.hpp"
+
+CoverImageCache::CoverImageCache(size_t budget)
+    : budget(budget)
+    , entryCount(0)
+    , useClock(0) {
+}
+
+std::shared_ptr<CoverImage> CoverImageCache::get(const SpotifyId& albumId, int edge) {
+    int index = find(albumId, edge);
+    if (index < 0) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    stats.hits++;
+    entries[index].lastUsed = ++useClock;
+    return entries[index].image;
+}
+
+bool CoverImageCache::contains(const SpotifyId& albumId, int edge) const {
+    return find(albumId, edge) >= 0;
+}
+
+void CoverImageCache::put(const SpotifyId& albumId, std::shared_ptr<CoverImage> image) {
+    if (albumId.isEmpty() || !image || !image->isValid() || image->getBytes() > budget) {
+        return;
+    }
+
+    int existing = find(albumId, image->getWidth());
+    if (existing >= 0) {
+        remove(existing);
+    }
+
+    // Least recently used covers make room
+    while (entryCount > 0 &&
+           (entryCount >= COVER_IMAGE_CACHE_MAX_ENTRIES || stats.bytes + image->getBytes() > budget)) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < entryCount; i++) {
+            if (entries[i].lastUsed < entries[oldest].lastUsed) {
+                oldest = i;
+            }
+        }
+        remove(oldest);
+        stats.evictions++;
+    }
+
+    Entry& entry = entries[entryCount++];
+    entry.albumId = albumId;
+    entry.lastUsed = ++useClock;
+    stats.bytes += image->getBytes();
+    stats.entries = entryCount;
+    entry.image = std::move(image);
+}
+
+void CoverImageCache::clear() {
+    while (entryCount > 0) {
+        remove(entryCount - 1);
+    }
+}
+
+// Private methods
+
+int CoverImageCache::find(const SpotifyId& albumId, int edge) const {
+    for (size_t i = 0; i < entryCount; i++) {
+        if (entries[i].image->getWidth() == edge && entries[i].albumId == albumId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void CoverImageCache::remove(size_t index) {
+    stats.bytes -= entries[index].image->getBytes();
+
+    // Order doesn't matter, the last entry fills the gap
+    entries[index] = std::move(entries[--entryCount]);
+    entries[entryCount].image.reset();
+    stats.entries = entryCount;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file CoverImageCache.hpp
+ * @brief Decoded Album Art in PSRAM
+ *
+ * The most recently used covers, ready to draw, in each size the UI
+ * shows them (Now Playing art and list thumbnails). Going back to a
+ * track or scrolling past an album again is a lookup, no flash read
+ * and no JPEG decode.
+ *
+ * Images are shared: one that is evicted while a widget shows it is
+ * freed when the widget lets go of it.
+ */
+
+#ifndef COVER_IMAGE_CACHE_HPP
+#define COVER_IMAGE_CACHE_HPP
+
+#include <Arduino.h>
+#include <memory>
+#include "SpotifyId.hpp"
+#include "../display/CoverImage.hpp"
+
+// Cache settings
+#define COVER_IMAGE_CACHE_MAX_ENTRIES 48
+#ifndef COVER_IMAGE_CACHE_BUDGET
+#define COVER_IMAGE_CACHE_BUDGET (1024 * 1024)  // ~9 albums at 220 px + 64 px thumbnail
+#endif
+
+/**
+ * @brief Cover Image Cache Class
+ *
+ * Use from the loop task only.
+ */
+class CoverImageCache {
+public:
+    /**
+     * @brief Cache statistics
+     */
+    struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t bytes;         // Pixels held by the cache
+        uint16_t entries;
+
+        Stats()
+            : hits(0)
+            , misses(0)
+            , evictions(0)
+            , bytes(0)
+            , entries(0) {
+        }
+    };
+
+    explicit CoverImageCache(size_t budget = COVER_IMAGE_CACHE_BUDGET);
+
+    /**
+     * @brief Look up a cover
+     * @param edge Width and height of the wanted variant
+     * @return nullptr if it isn't cached
+     */
+    std::shared_ptr<CoverImage> get(const SpotifyId& albumId, int edge);
+
+    /**
+     * @brief Check if a cover is cached, without counting a hit or miss
+     */
+    bool contains(const SpotifyId& albumId, int edge) const;
+
+    /**
+     * @brief Add a cover variant, evicting the least recently used ones
+     */
+    void put(const SpotifyId& albumId, std::shared_ptr<CoverImage> image);
+
+    /**
+     * @brief Drop all covers
+     */
+    void clear();
+
+    /**
+     * @brief Get cache statistics
+     */
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Entry {
+        SpotifyId albumId;
+        std::shared_ptr<CoverImage> image;
+        uint32_t lastUsed;
+    };
+
+    int find(const SpotifyId& albumId, int edge) const;
+    void remove(size_t index);
+
+    size_t budget;
+    Entry entries[COVER_IMAGE_CACHE_MAX_ENTRIES];
+    size_t entryCount;
+    uint32_t useClock;
+
+    Stats stats;
+};
+
+#endif // COVER_IMAGE_CACHE_HPP
@@ -0,0 +1,51 @@
+/**
+ * @file PlaybackClock.cpp
+ * @brief Locally Interpolated Playback Position Implementation
+ */
+
+#include "PlaybackClock.hpp"
+
+PlaybackClock::PlaybackClock()
+    : baseProgressMs(0)
+    , baseTimeMs(0)
+    , durationMs(0)
+    , playing(false) {
+}
+
+void PlaybackClock::sync(int progressMs, int duration, bool isPlaying, unsigned long sampledAtMs) {
+    baseProgressMs = progressMs;
+    baseTimeMs = sampledAtMs;
+    durationMs = duration;
+    playing = isPlaying;
+}
+
+void PlaybackClock::seek(int positionMs) {
+    baseProgressMs = positionMs;
+    baseTimeMs = millis();
+}
+
+void PlaybackClock::setPlaying(bool isPlaying) {
+    if (playing == isPlaying) {
+        return;
+    }
+
+    baseProgressMs = getProgressMs();
+    baseTimeMs = millis();
+    playing = isPlaying;
+}
+
+int PlaybackClock::getProgressAt(unsigned long timeMs) const {
+    long progress = baseProgressMs;
+
+    // sampledAt can be slightly in the future of a caller's timestamp
+    if (playing && static_cast<long>(timeMs - baseTimeMs) > 0) {
+        progress += static_cast<long>(timeMs - baseTimeMs);
+    }
+
+    // Spotify moves to the next track at the end, the next poll picks it up
+    if (durationMs > 0 && progress > durationMs) {
+        progress = durationMs;
+    }
+
+    return static_cast<int>(progress);
+}
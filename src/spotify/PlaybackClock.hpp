@@ -0,0 +1,68 @@
+/**
+ * @file PlaybackClock.hpp
+ * @brief Locally Interpolated Playback Position
+ *
+ * Advances the playback position from the last polled progress_ms with
+ * millis() while the track is playing, so progress can be shown
+ * smoothly without polling more often. Re-synced on every poll.
+ */
+
+#ifndef PLAYBACK_CLOCK_HPP
+#define PLAYBACK_CLOCK_HPP
+
+#include <Arduino.h>
+
+/**
+ * @brief Playback Clock Class
+ */
+class PlaybackClock {
+public:
+    PlaybackClock();
+
+    /**
+     * @brief Re-sync to a polled position
+     * @param progressMs Position reported by Spotify
+     * @param durationMs Track duration (0 if unknown)
+     * @param playing Track is playing
+     * @param sampledAtMs millis() at which progressMs was current
+     */
+    void sync(int progressMs, int durationMs, bool playing, unsigned long sampledAtMs);
+
+    /**
+     * @brief Jump to a position (e.g. after a seek)
+     */
+    void seek(int positionMs);
+
+    /**
+     * @brief Start or stop advancing, keeping the current position
+     */
+    void setPlaying(bool playing);
+
+    /**
+     * @brief Get the current position
+     */
+    int getProgressMs() const { return getProgressAt(millis()); }
+
+    /**
+     * @brief Get the predicted position at a point in time
+     */
+    int getProgressAt(unsigned long timeMs) const;
+
+    /**
+     * @brief Get track duration
+     */
+    int getDurationMs() const { return durationMs; }
+
+    /**
+     * @brief Check if the clock is advancing
+     */
+    bool isPlaying() const { return playing; }
+
+private:
+    int baseProgressMs;
+    unsigned long baseTimeMs;
+    int durationMs;
+    bool playing;
+};
+
+#endif // PLAYBACK_CLOCK_HPP
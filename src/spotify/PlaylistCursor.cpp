@@ -0,0 +1,125 @@
+/**
+ * @file PlaylistCursor.cpp
+ * @brief Paged Playlist Browser Implementation
+ */
+
+#include "PlaylistCursor.hpp"
+
+PlaylistCursor::PlaylistCursor(SpotifyClient* client, int pageSize, int windowPages)
+    : client(client)
+    , pageSize(constrain(pageSize, 1, SPOTIFY_PLAYLIST_LIMIT))
+    , windowPages(max(windowPages, 1))
+    , total(-1)
+    , position(0)
+    , pageLoads(0) {
+}
+
+int PlaylistCursor::getTotal() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return total;
+}
+
+bool PlaylistCursor::isLoaded(int index) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findPage(index) != nullptr;
+}
+
+bool PlaylistCursor::get(int index, PlaylistInfo& playlist) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const Page* page = findPage(index);
+    if (!page) {
+        return false;
+    }
+
+    playlist = page->items[index - page->offset];
+    return true;
+}
+
+bool PlaylistCursor::fetch(int index) {
+    if (index < 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (findPage(index)) {
+            return true;
+        }
+        if (total >= 0 && index >= total) {
+            return false;
+        }
+    }
+
+    // Pages are aligned so neighbouring indexes share a page
+    int offset = (index / pageSize) * pageSize;
+
+    SpotifyClient::PlaylistPage result;
+    if (!client || !client->getPlaylists(result, offset, pageSize)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pageLoads++;
+
+    // Spotify reports the end through "next", trust it over a stale total
+    total = result.hasNext ? max(result.total, offset + static_cast<int>(result.items.size()) + 1)
+                           : offset + static_cast<int>(result.items.size());
+
+    if (result.items.empty()) {
+        return false;
+    }
+
+    if (!findPage(offset)) {
+        Page page;
+        page.offset = offset;
+        page.items = std::move(result.items);
+        pages.push_back(std::move(page));
+        trimWindow(index);
+    }
+
+    return findPage(index) != nullptr;
+}
+
+bool PlaylistCursor::next(PlaylistInfo& playlist) {
+    if (!fetch(position) || !get(position, playlist)) {
+        return false;
+    }
+
+    position++;
+    return true;
+}
+
+void PlaylistCursor::seek(int index) {
+    position = max(index, 0);
+}
+
+void PlaylistCursor::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    pages.clear();
+    total = -1;
+    position = 0;
+}
+
+// Private methods
+
+const PlaylistCursor::Page* PlaylistCursor::findPage(int index) const {
+    for (const Page& page : pages) {
+        if (index >= page.offset && index < page.offset + static_cast<int>(page.items.size())) {
+            return &page;
+        }
+    }
+    return nullptr;
+}
+
+void PlaylistCursor::trimWindow(int index) {
+    while (pages.size() > windowPages) {
+        auto farthest = pages.begin();
+        for (auto it = pages.begin(); it != pages.end(); ++it) {
+            if (abs(it->offset - index) > abs(farthest->offset - index)) {
+                farthest = it;
+            }
+        }
+        pages.erase(farthest);
+    }
+}
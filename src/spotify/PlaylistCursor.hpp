@@ -0,0 +1,122 @@
+/**
+ * @file PlaylistCursor.hpp
+ * @brief Paged Playlist Browser
+ *
+ * Walks the user's playlists a page at a time with /me/playlists
+ * limit/offset, keeping only a window of pages in memory, so libraries
+ * with thousands of playlists can be browsed at constant memory.
+ */
+
+#ifndef PLAYLIST_CURSOR_HPP
+#define PLAYLIST_CURSOR_HPP
+
+#include <Arduino.h>
+#include <deque>
+#include <mutex>
+#include "SpotifyClient.hpp"
+
+// Pages kept in memory (PLAYLIST_WINDOW_PAGES * page size playlists)
+#ifndef PLAYLIST_WINDOW_PAGES
+#define PLAYLIST_WINDOW_PAGES 3
+#endif
+
+/**
+ * @brief Playlist Cursor Class
+ *
+ * fetch()/next() send requests, so run them on the RequestQueue worker.
+ * isLoaded()/get() only read the window and are safe from the loop task.
+ *
+ *     PlaylistCursor cursor(spotify);
+ *     SpotifyClient::PlaylistInfo playlist;
+ *     while (cursor.next(playlist)) { ... }
+ */
+class PlaylistCursor {
+public:
+    using PlaylistInfo = SpotifyClient::PlaylistInfo;
+
+    /**
+     * @param client Client used to fetch pages
+     * @param pageSize Playlists per request (max SPOTIFY_PLAYLIST_LIMIT)
+     * @param windowPages Pages kept in memory
+     */
+    PlaylistCursor(SpotifyClient* client,
+                   int pageSize = SPOTIFY_PLAYLIST_LIMIT,
+                   int windowPages = PLAYLIST_WINDOW_PAGES);
+
+    /**
+     * @brief Get the number of playlists (-1 until the first page is loaded)
+     */
+    int getTotal() const;
+
+    /**
+     * @brief Check if the playlist at index is in memory
+     */
+    bool isLoaded(int index) const;
+
+    /**
+     * @brief Get a playlist if it is in memory, without a request
+     */
+    bool get(int index, PlaylistInfo& playlist) const;
+
+    /**
+     * @brief Make sure the page containing index is in memory
+     * @return false if index is past the end or the request failed
+     */
+    bool fetch(int index);
+
+    /**
+     * @brief Get the playlist at the cursor and advance it
+     *
+     * Loads the next page when the cursor reaches it.
+     * @return false at the end of the library or on error
+     */
+    bool next(PlaylistInfo& playlist);
+
+    /**
+     * @brief Move the cursor to index
+     */
+    void seek(int index);
+
+    /**
+     * @brief Get the cursor position
+     */
+    int getPosition() const { return position; }
+
+    /**
+     * @brief Forget all pages (e.g. after the library changed)
+     */
+    void reset();
+
+    /**
+     * @brief Get number of page requests made
+     */
+    uint32_t getPageLoads() const { return pageLoads; }
+
+private:
+    struct Page {
+        int offset;
+        std::vector<PlaylistInfo> items;
+    };
+
+    /**
+     * @brief Find the page containing index (mutex held)
+     */
+    const Page* findPage(int index) const;
+
+    /**
+     * @brief Drop the page farthest from index until the window fits (mutex held)
+     */
+    void trimWindow(int index);
+
+    SpotifyClient* client;
+    int pageSize;
+    size_t windowPages;
+
+    mutable std::mutex mutex;
+    std::deque<Page> pages;
+    int total;
+    int position;
+    uint32_t pageLoads;
+};
+
+#endif // PLAYLIST_CURSOR_HPP
@@ -0,0 +1,94 @@
+/**
+ * @file PollScheduler.cpp
+ * @brief Adaptive Now Playing Poll Scheduler Implementation
+ */
+
+#include "PollScheduler.hpp"
+
+PollScheduler::PollScheduler()
+    : lastScheduled(0)
+    , nextDelay(0)
+    , boostStart(0)
+    , errorDelay(0)
+    , boosting(false)
+    , idle(false)
+    , pollCount(0) {
+}
+
+bool PollScheduler::isDue() const {
+    return millis() - lastScheduled >= nextDelay;
+}
+
+unsigned long PollScheduler::getTimeUntilNext() const {
+    unsigned long elapsed = millis() - lastScheduled;
+    return elapsed >= nextDelay ? 0 : nextDelay - elapsed;
+}
+
+void PollScheduler::onPollComplete(bool success, bool playing, int progressMs, int durationMs) {
+    pollCount++;
+
+    if (!success) {
+        errorDelay = errorDelay ? min(errorDelay * 2, (unsigned long)POLL_ERROR_MAX_MS) : POLL_ERROR_MIN_MS;
+        scheduleIn(errorDelay);
+        return;
+    }
+    errorDelay = 0;
+
+    scheduleIn(getRegularDelay(playing, progressMs, durationMs));
+}
+
+void PollScheduler::onPollDeferred(bool playing, int progressMs, int durationMs) {
+    scheduleIn(getRegularDelay(playing, progressMs, durationMs));
+}
+
+void PollScheduler::onUserCommand() {
+    boosting = true;
+    boostStart = millis();
+
+    if (getTimeUntilNext() > POLL_COMMAND_DELAY_MS) {
+        scheduleIn(POLL_COMMAND_DELAY_MS);
+    }
+}
+
+void PollScheduler::setIdle(bool isIdle) {
+    if (idle && !isIdle) {
+        // Screen woke up, show the current state right away
+        pollNow();
+    }
+    idle = isIdle;
+}
+
+void PollScheduler::pollNow() {
+    scheduleIn(0);
+}
+
+// Private methods
+
+unsigned long PollScheduler::getRegularDelay(bool playing, int progressMs, int durationMs) {
+    if (boosting && millis() - boostStart >= POLL_BOOST_DURATION_MS) {
+        boosting = false;
+    }
+
+    unsigned long delayMs;
+    if (boosting) {
+        delayMs = POLL_BOOST_INTERVAL_MS;
+    } else if (idle) {
+        delayMs = POLL_IDLE_MS;
+    } else if (!playing || durationMs <= 0) {
+        delayMs = POLL_PAUSED_MS;
+    } else {
+        // Next change we can predict is the end of the track
+        delayMs = POLL_PLAYING_MAX_MS;
+        long remaining = static_cast<long>(durationMs) - progressMs;
+        if (remaining >= 0 && static_cast<unsigned long>(remaining) + POLL_TRACK_END_SLACK_MS < delayMs) {
+            delayMs = remaining + POLL_TRACK_END_SLACK_MS;
+        }
+    }
+
+    return max(delayMs, (unsigned long)POLL_MIN_INTERVAL_MS);
+}
+
+void PollScheduler::scheduleIn(unsigned long delayMs) {
+    lastScheduled = millis();
+    nextDelay = delayMs;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file PollScheduler.hpp
+ * @brief Adaptive Now Playing Poll Scheduler
+ *
+ * Decides when to poll /me/player next:
+ * - while playing, right after the predicted end of the track
+ *   (capped so changes made from another device still show up)
+ * - backs off while paused, and further while the screen is idle
+ * - polls quickly for a few seconds after a user command
+ * - backs off exponentially while requests fail (not when the rate
+ *   limiter only held a poll back)
+ */
+
+#ifndef POLL_SCHEDULER_HPP
+#define POLL_SCHEDULER_HPP
+
+#include <Arduino.h>
+
+// Poll intervals
+#define POLL_MIN_INTERVAL_MS 500
+#define POLL_PLAYING_MAX_MS 10000      // Longest gap while playing
+#define POLL_PAUSED_MS 15000
+#define POLL_IDLE_MS 60000             // Screen idle, nobody is looking
+#define POLL_TRACK_END_SLACK_MS 400    // Poll this long after the predicted track end
+#define POLL_ERROR_MIN_MS 2000
+#define POLL_ERROR_MAX_MS 60000
+
+// Fast polling after a user command
+#define POLL_COMMAND_DELAY_MS 300      // Give Spotify time to apply the command
+#define POLL_BOOST_INTERVAL_MS 1000
+#define POLL_BOOST_DURATION_MS 5000
+
+/**
+ * @brief Poll Scheduler Class
+ */
+class PollScheduler {
+public:
+    PollScheduler();
+
+    /**
+     * @brief Check if a poll is due
+     */
+    bool isDue() const;
+
+    /**
+     * @brief Get time until the next poll (0 if due)
+     */
+    unsigned long getTimeUntilNext() const;
+
+    /**
+     * @brief Schedule the next poll from the result of this one
+     * @param success Request succeeded
+     * @param playing Track is playing
+     * @param progressMs Playback position
+     * @param durationMs Track duration (0 if nothing is loaded)
+     */
+    void onPollComplete(bool success, bool playing, int progressMs, int durationMs);
+
+    /**
+     * @brief Schedule the next poll after the rate limiter held this one back
+     *
+     * Nothing was sent, so the regular interval applies and the error
+     * backoff is left as it is.
+     * @param playing Track is playing
+     * @param progressMs Predicted playback position
+     * @param durationMs Track duration (0 if nothing is loaded)
+     */
+    void onPollDeferred(bool playing, int progressMs, int durationMs);
+
+    /**
+     * @brief Poll soon and keep polling fast for a while
+     */
+    void onUserCommand();
+
+    /**
+     * @brief Set whether the screen is idle (screensaver/dimmed)
+     *
+     * Leaving idle schedules an immediate poll.
+     */
+    void setIdle(bool idle);
+
+    /**
+     * @brief Poll on the next check
+     */
+    void pollNow();
+
+    /**
+     * @brief Get number of completed polls
+     */
+    uint32_t getPollCount() const { return pollCount; }
+
+    /**
+     * @brief Get the current interval until the next poll
+     */
+    unsigned long getInterval() const { return nextDelay; }
+
+private:
+    /**
+     * @brief Get the delay until the next poll while requests succeed
+     */
+    unsigned long getRegularDelay(bool playing, int progressMs, int durationMs);
+
+    /**
+     * @brief Schedule the next poll after delayMs
+     */
+    void scheduleIn(unsigned long delayMs);
+
+    unsigned long lastScheduled;   // Time the next poll was scheduled at
+    unsigned long nextDelay;       // Delay from lastScheduled
+    unsigned long boostStart;
+    unsigned long errorDelay;
+
+    bool boosting;
+    bool idle;
+    uint32_t pollCount;
+};
+
+#endif // POLL_SCHEDULER_HPP
@@ -0,0 +1,103 @@
+/**
+ * @file SavedTrackCache.cpp
+ * @brief Saved Track Cache Implementation
+ */
+
+#include "SavedTrackCache.hpp"
+#include <algorithm>
+
+SavedState SavedTrackCache::get(const SpotifyId& trackId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entries.find(trackId);
+    if (it == entries.end() || !isFresh(it->second)) {
+        return SavedState::UNKNOWN;
+    }
+
+    hits++;
+    return it->second.saved ? SavedState::SAVED : SavedState::NOT_SAVED;
+}
+
+bool SavedTrackCache::request(const SpotifyId& trackId) {
+    if (trackId.isEmpty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entries.find(trackId);
+    if (it != entries.end() && isFresh(it->second)) {
+        hits++;
+        return false;
+    }
+
+    if (std::find(pending.begin(), pending.end(), trackId) != pending.end()) {
+        return false;
+    }
+
+    misses++;
+    pending.push_back(trackId);
+    return true;
+}
+
+std::vector<SpotifyId> SavedTrackCache::takeBatch() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size_t count = min(pending.size(), static_cast<size_t>(SAVED_LOOKUP_BATCH_SIZE));
+    std::vector<SpotifyId> batch(pending.begin(), pending.begin() + count);
+    pending.erase(pending.begin(), pending.begin() + count);
+    return batch;
+}
+
+bool SavedTrackCache::hasPending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending.empty();
+}
+
+void SavedTrackCache::set(const SpotifyId& trackId, bool saved) {
+    if (trackId.isEmpty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (entries.find(trackId) == entries.end()) {
+        evictIfFull();
+    }
+
+    Entry& entry = entries[trackId];
+    entry.saved = saved;
+    entry.storedMs = millis();
+}
+
+void SavedTrackCache::invalidate(const SpotifyId& trackId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(trackId);
+}
+
+void SavedTrackCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    pending.clear();
+}
+
+// Private methods
+
+bool SavedTrackCache::isFresh(const Entry& entry) {
+    return millis() - entry.storedMs < SAVED_CACHE_TTL_MS;
+}
+
+void SavedTrackCache::evictIfFull() {
+    if (entries.size() < SAVED_CACHE_MAX_ENTRIES) {
+        return;
+    }
+
+    unsigned long now = millis();
+    auto oldest = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (now - it->second.storedMs > now - oldest->second.storedMs) {
+            oldest = it;
+        }
+    }
+    entries.erase(oldest);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file SavedTrackCache.hpp
+ * @brief Cache of "saved in Your Library" state per track
+ *
+ * Remembers the result of /me/tracks/contains per track id and collects
+ * ids that still need a lookup, so they can be fetched 50 at a time
+ * instead of one request per track.
+ */
+
+#ifndef SAVED_TRACK_CACHE_HPP
+#define SAVED_TRACK_CACHE_HPP
+
+#include <Arduino.h>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "SpotifyId.hpp"
+
+// Cache settings
+#define SAVED_CACHE_MAX_ENTRIES 256
+#define SAVED_CACHE_TTL_MS 600000      // Saved state can change on other devices
+#define SAVED_LOOKUP_BATCH_SIZE 50     // Max ids per /me/tracks/contains
+
+/**
+ * @brief Saved state of a track
+ */
+enum class SavedState {
+    UNKNOWN,
+    SAVED,
+    NOT_SAVED
+};
+
+/**
+ * @brief Saved Track Cache Class
+ *
+ * Safe to use from the loop task and the request worker.
+ */
+class SavedTrackCache {
+public:
+    SavedTrackCache() = default;
+
+    /**
+     * @brief Get the cached state of a track
+     */
+    SavedState get(const SpotifyId& trackId) const;
+
+    /**
+     * @brief Queue a track for lookup unless its state is cached
+     * @return true if the track was queued
+     */
+    bool request(const SpotifyId& trackId);
+
+    /**
+     * @brief Take up to SAVED_LOOKUP_BATCH_SIZE queued ids
+     */
+    std::vector<SpotifyId> takeBatch();
+
+    /**
+     * @brief Check if ids are waiting for a lookup
+     */
+    bool hasPending() const;
+
+    /**
+     * @brief Store a known state (lookup result, save or remove)
+     */
+    void set(const SpotifyId& trackId, bool saved);
+
+    /**
+     * @brief Forget a track (e.g. a save/remove failed)
+     */
+    void invalidate(const SpotifyId& trackId);
+
+    /**
+     * @brief Forget everything
+     */
+    void clear();
+
+    /**
+     * @brief Get number of lookups answered from the cache
+     */
+    uint32_t getHits() const { return hits; }
+
+    /**
+     * @brief Get number of lookups that needed a request
+     */
+    uint32_t getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        bool saved;
+        unsigned long storedMs;
+    };
+
+    /**
+     * @brief Check if an entry is still valid (mutex held)
+     */
+    static bool isFresh(const Entry& entry);
+
+    /**
+     * @brief Drop the oldest entry when full (mutex held)
+     */
+    void evictIfFull();
+
+    mutable std::mutex mutex;
+    std::map<SpotifyId, Entry> entries;
+    std::vector<SpotifyId> pending;
+
+    mutable uint32_t hits = 0;
+    uint32_t misses = 0;
+};
+
+#endif // SAVED_TRACK_CACHE_HPP
@@ -0,0 +1,197 @@
+/**
+ * @file SearchEngine.cpp
+ * @brief Type-Ahead Search Implementation
+ */
+
+#include "SearchEngine.hpp"
+#include "../network/RequestQueue.hpp"
+#include <memory>
+
+SearchEngine::SearchEngine(SpotifyClient* client)
+    : client(client)
+    , lastKeyTime(0)
+    , pending(false)
+    , nextOffset(0)
+    , hasMore(false)
+    , inFlight(false)
+    , wantedOffset(0)
+    , generation(0) {
+}
+
+void SearchEngine::setQuery(const String& text) {
+    String query = normalize(text);
+    if (query == typedQuery && (pending || query == shownQuery)) {
+        return;
+    }
+
+    typedQuery = query;
+    lastKeyTime = millis();
+
+    // Whatever was wanted before is stale now, a queued request won't be sent
+    wantedQuery = "";
+    generation++;
+
+    if (query.isEmpty()) {
+        pending = false;
+        deliver(query, SpotifyClient::SearchResult(), 0);
+        return;
+    }
+
+    pending = true;
+}
+
+bool SearchEngine::loadMore() {
+    if (pending || shownQuery.isEmpty() || !hasMore) {
+        return false;
+    }
+
+    fetch(shownQuery, nextOffset);
+    return true;
+}
+
+void SearchEngine::update() {
+    if (pending && millis() - lastKeyTime >= SEARCH_DEBOUNCE_MS) {
+        pending = false;
+        stats.queries++;
+        fetch(typedQuery, 0);
+    }
+
+    // Retry if the queue was full
+    if (!inFlight && !wantedQuery.isEmpty()) {
+        send(wantedQuery, wantedOffset);
+    }
+}
+
+// Private methods
+
+void SearchEngine::fetch(const String& query, int offset) {
+    const SpotifyClient::SearchResult* cached = lookup(cacheKey(query, offset));
+    if (cached) {
+        stats.cacheHits++;
+        wantedQuery = "";
+        deliver(query, *cached, offset);
+        return;
+    }
+
+    wantedQuery = query;
+    wantedOffset = offset;
+
+    // Otherwise it's sent when the running request is done
+    if (!inFlight) {
+        send(query, offset);
+    }
+}
+
+void SearchEngine::send(const String& query, int offset) {
+    if (!client) {
+        return;
+    }
+
+    auto result = std::make_shared<SpotifyClient::SearchResult>();
+    uint32_t gen = generation;
+    SpotifyClient* spotify = client;
+
+    inFlight = RequestQueue::getInstance().submit(
+        [this, spotify, result, gen, query, offset]() {
+            if (generation != gen) {
+                return false;
+            }
+            *result = spotify->search(query, SEARCH_PAGE_SIZE, offset);
+            return true;
+        },
+        [this, result, query, offset](bool sent) {
+            inFlight = false;
+
+            if (!sent) {
+                stats.superseded++;
+            } else {
+                // An empty page may be an error, don't keep it
+                if (!result->tracks.empty() || !result->playlists.empty()) {
+                    store(cacheKey(query, offset), *result);
+                }
+
+                if (query == wantedQuery && offset == wantedOffset) {
+                    wantedQuery = "";
+                    deliver(query, *result, offset);
+                } else {
+                    stats.discarded++;
+                }
+            }
+
+            // Typing went on while this ran
+            if (!wantedQuery.isEmpty()) {
+                fetch(wantedQuery, wantedOffset);
+            }
+        });
+
+    if (inFlight) {
+        stats.requests++;
+    }
+}
+
+void SearchEngine::deliver(const String& query, const SpotifyClient::SearchResult& page, int offset) {
+    shownQuery = query;
+    nextOffset = offset + SEARCH_PAGE_SIZE;
+    hasMore = page.hasMore && nextOffset < SEARCH_MAX_OFFSET;
+
+    if (offset == 0 && !query.isEmpty()) {
+        stats.lastLatencyMs = millis() - lastKeyTime - SEARCH_DEBOUNCE_MS;
+        Serial.printf("🔍 \"%s\": %u tracks, %u playlists in %lu ms\n",
+                      query.c_str(),
+                      static_cast<unsigned>(page.tracks.size()),
+                      static_cast<unsigned>(page.playlists.size()),
+                      stats.lastLatencyMs);
+    }
+
+    if (resultsHandler) {
+        resultsHandler(query, page, offset);
+    }
+}
+
+const SpotifyClient::SearchResult* SearchEngine::lookup(const String& key) {
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->key == key) {
+            cache.splice(cache.begin(), cache, it);
+            return &cache.front().result;
+        }
+    }
+    return nullptr;
+}
+
+void SearchEngine::store(const String& key, const SpotifyClient::SearchResult& result) {
+    if (lookup(key)) {
+        cache.front().result = result;
+        return;
+    }
+
+    cache.push_front({key, result});
+    if (cache.size() > SEARCH_CACHE_ENTRIES) {
+        cache.pop_back();
+    }
+}
+
+String SearchEngine::normalize(const String& text) {
+    String query;
+    query.reserve(text.length());
+
+    bool space = false;
+    for (unsigned int i = 0; i < text.length(); i++) {
+        char c = text[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            space = !query.isEmpty();
+            continue;
+        }
+        if (space) {
+            query += ' ';
+            space = false;
+        }
+        query += c;
+    }
+
+    query.toLowerCase();
+    return query;
+}
+
+String SearchEngine::cacheKey(const String& query, int offset) {
+    return query + "#" + String(offset);
+}
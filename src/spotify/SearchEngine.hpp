@@ -0,0 +1,176 @@
+/**
+ * @file SearchEngine.hpp
+ * @brief Type-Ahead Search
+ *
+ * Turns keystrokes into as few search requests as possible:
+ * - waits for a pause in typing before searching
+ * - keeps at most one search in flight; a query that was superseded
+ *   while queued is never sent, stale results are dropped
+ * - answers repeated queries from an LRU cache of result pages
+ * - loads further pages on demand
+ */
+
+#ifndef SEARCH_ENGINE_HPP
+#define SEARCH_ENGINE_HPP
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <list>
+#include "SpotifyClient.hpp"
+
+// Search settings
+#define SEARCH_DEBOUNCE_MS 250       // Pause in typing before searching
+#define SEARCH_PAGE_SIZE 10          // Results per type and page, small pages arrive sooner
+#define SEARCH_MAX_OFFSET 100        // Stop paging here
+#define SEARCH_CACHE_ENTRIES 3       // Result pages kept, about 12 KB each
+#define SEARCH_CACHE_BUDGET (40 * 1024)   // Internal heap the cache may take
+
+/**
+ * @brief Search Engine Class
+ *
+ * Use from the loop task only. Usage:
+ *
+ *     search.setResultsHandler([](const String& query,
+ *                                 const SpotifyClient::SearchResult& page,
+ *                                 int offset) {
+ *         // offset 0 replaces the list, later pages append
+ *     });
+ *     search.setQuery(text);   // on every keystroke
+ *     search.loadMore();       // when the list is scrolled to the end
+ */
+class SearchEngine {
+public:
+    using ResultsHandler = std::function<void(const String& query,
+                                              const SpotifyClient::SearchResult& page,
+                                              int offset)>;
+
+    /**
+     * @brief Search statistics
+     */
+    struct Stats {
+        uint32_t queries;       // Queries that reached the debounce
+        uint32_t requests;      // Requests sent
+        uint32_t cacheHits;
+        uint32_t superseded;    // Dropped before they were sent
+        uint32_t discarded;     // Results that arrived for an old query
+        unsigned long lastLatencyMs;   // Typing stopped until results shown
+
+        Stats()
+            : queries(0)
+            , requests(0)
+            , cacheHits(0)
+            , superseded(0)
+            , discarded(0)
+            , lastLatencyMs(0) {
+        }
+    };
+
+    explicit SearchEngine(SpotifyClient* client);
+
+    /**
+     * @brief Set the callback results are delivered to (on the loop task)
+     */
+    void setResultsHandler(ResultsHandler handler) { resultsHandler = handler; }
+
+    /**
+     * @brief Set the search text, call on every keystroke
+     *
+     * An empty query clears the results.
+     */
+    void setQuery(const String& text);
+
+    /**
+     * @brief Load the next page of the current query
+     * @return false if there is no further page
+     */
+    bool loadMore();
+
+    /**
+     * @brief Send due searches (call from the loop)
+     */
+    void update();
+
+    /**
+     * @brief Check if results for the latest query are still on their way
+     */
+    bool isSearching() const { return pending || inFlight; }
+
+    /**
+     * @brief Get the query the shown results belong to
+     */
+    const String& getQuery() const { return shownQuery; }
+
+    /**
+     * @brief Get search statistics
+     */
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct CacheEntry {
+        String key;
+        SpotifyClient::SearchResult result;
+    };
+
+    /**
+     * @brief Show a page from the cache or request it
+     */
+    void fetch(const String& query, int offset);
+
+    /**
+     * @brief Queue a search request
+     */
+    void send(const String& query, int offset);
+
+    /**
+     * @brief Deliver a page to the results handler
+     */
+    void deliver(const String& query, const SpotifyClient::SearchResult& page, int offset);
+
+    /**
+     * @brief Find a cached page and mark it recently used
+     */
+    const SpotifyClient::SearchResult* lookup(const String& key);
+
+    /**
+     * @brief Cache a page, evicting the least recently used
+     */
+    void store(const String& key, const SpotifyClient::SearchResult& result);
+
+    /**
+     * @brief Trim, lowercase and collapse spaces so equal queries share a cache entry
+     */
+    static String normalize(const String& text);
+
+    static String cacheKey(const String& query, int offset);
+
+    SpotifyClient* client;
+    ResultsHandler resultsHandler;
+
+    // Typing
+    String typedQuery;
+    unsigned long lastKeyTime;
+    bool pending;           // typedQuery waits for the debounce
+
+    // Shown results
+    String shownQuery;
+    int nextOffset;
+    bool hasMore;
+
+    // Request in flight; generation changes whenever its result goes stale
+    bool inFlight;
+    String wantedQuery;     // Query/offset to fetch once the request is done
+    int wantedOffset;
+    std::atomic<uint32_t> generation;
+
+    std::list<CacheEntry> cache;   // Most recently used first
+    Stats stats;
+};
+
+// A page holds up to SEARCH_PAGE_SIZE tracks and playlists, fixed size rows
+static_assert(SEARCH_CACHE_ENTRIES * SEARCH_PAGE_SIZE *
+                  (sizeof(SpotifyClient::TrackInfo) + sizeof(SpotifyClient::PlaylistInfo))
+                  <= SEARCH_CACHE_BUDGET,
+              "Search cache exceeds SEARCH_CACHE_BUDGET");
+
+#endif // SEARCH_ENGINE_HPP
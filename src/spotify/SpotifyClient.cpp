@@ -4,15 +4,70 @@
  */
 
 #include "SpotifyClient.hpp"
+#include "../network/HttpsTransport.hpp"
+#include "../network/RequestQueue.hpp"
+#include <HTTPClient.h>
+#include <LittleFS.h>
+#include <sys/time.h>
+
+#if SPOTIFY_COUNT_ALLOCS
+#include <native_heap.h>
+#endif
+
+// Longest part of an error response that is logged
+#define SPOTIFY_ERROR_LOG_LENGTH 160
+
+// A cut off URL is useless, leave it empty instead
+template <size_t N>
+static void assignUrl(FixedString<N>& field, const char* url) {
+    if (!field.assign(url)) {
+        field.clear();
+    }
+}
 
-SpotifyClient::SpotifyClient(AuthManager* auth)
+SpotifyClient::SpotifyClient(AuthManager* auth, HttpTransport* transport)
     : authManager(auth)
     , tokenExpiryTime(0)
+    , tokenRefreshTime(0)
+    , tokenGeneration(0)
+    , refreshing(false)
+    , refreshSucceeded(false)
+    , refreshQueued(false)
+    , breaker(transport ? transport : &HttpsTransport::getInstance())
+    , transport(&breaker)
+    , lastHttpCode(0)
+    , lastResponseTime(0)
+    , lastRequestLatency(0)
+    , shuffleState(false)
+    , repeatMode(RepeatMode::OFF)
+    , upcomingCount(0)
+    , queueStale(false)
+    , queueInFlight(false)
+    , queueDueTime(0)
+    , predictedTime(0)
+    , volumeCommand("volume", [this](int value) { return setVolume(value); },
+                    [this]() {
+                        rollbackCommand([this]() {
+                            currentDevice.volumePercent = volumeBeforeCommand;
+                            markChanged(CHANGED_VOLUME);
+                        });
+                    })
+    // Seeks aren't applied optimistically, the poll corrects the position
+    , seekCommand("seek", [this](int value) { return seek(value); },
+                  [this]() { rollbackCommand([]() {}); })
+    , volumeBeforeCommand(0)
+    , eventBus(nullptr)
+    , apiReachable(true)
+    , pendingChanges(0)
+    , stateGeneration(0)
+    , publishedGeneration(0)
+    , commandsInFlight(0)
+    , lastCommandTime(0)
+    , skipPending(false)
     , initialized(false) {
 }
 
 SpotifyClient::~SpotifyClient() {
-    http.end();
 }
 
 void SpotifyClient::init() {
@@ -22,65 +77,343 @@ void SpotifyClient::init() {
 
     Serial.println("🎵 Initializing SpotifyClient...");
 
-    // Configure HTTPS client
-    client.setInsecure();  // For Spotify API (TODO: add certificate validation)
-
     initialized = true;
     Serial.println("✅ SpotifyClient initialized");
 }
 
-void SpotifyClient::setTokens(const String& access, const String& refresh) {
+void SpotifyClient::setTokens(const String& access, const String& refresh, unsigned long expiresInMs) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
     accessToken = access;
     refreshToken = refresh;
-
-    // Parse expiry time from JWT (simplified - in production, parse actual expiry)
-    // For now, assume 1 hour expiry
-    tokenExpiryTime = millis() + 3600000;
+    authorizationHeader = "Bearer " + access;
+    tokenGeneration++;
+
+    unsigned long now = millis();
+    if (expiresInMs > 0) {
+        tokenExpiryTime = now + expiresInMs;
+        tokenRefreshTime = now + (expiresInMs > SPOTIFY_TOKEN_REFRESH_MARGIN_MS
+                                  ? expiresInMs - SPOTIFY_TOKEN_REFRESH_MARGIN_MS : 0);
+    } else {
+        // Stored token of unknown age, keep using it until the refresh is done
+        tokenExpiryTime = now + SPOTIFY_TOKEN_DEFAULT_LIFETIME_MS;
+        tokenRefreshTime = now;
+    }
 
     Serial.println("🎫 Spotify tokens set");
 }
 
+void SpotifyClient::update() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        advanceAtTrackEnd();
+    }
+
+    // Changes made by polls and commands since the last loop
+    publishChanges();
+
+    bool reachable = isApiReachable();
+    if (reachable != apiReachable) {
+        apiReachable = reachable;
+        publish(Event(reachable ? EventType::SPOTIFY_REACHABLE : EventType::SPOTIFY_UNREACHABLE));
+    }
+
+    scheduleQueueFetch();
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (refreshQueued || refreshToken.isEmpty() ||
+            static_cast<long>(millis() - tokenRefreshTime) < 0) {
+            return;
+        }
+        refreshQueued = true;
+    }
+
+    // Queued ahead of the token expiring, so requests never wait for it
+    bool queued = RequestQueue::getInstance().submit(
+        [this]() { return refreshAccessToken(); },
+        [this](bool success) {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                refreshQueued = false;
+            }
+            if (success) {
+                publish(Event(EventType::TOKEN_REFRESHED));
+            }
+        },
+        RequestPriority::BACKGROUND);
+
+    if (!queued) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        refreshQueued = false;
+    }
+}
+
+bool SpotifyClient::isPollDue(bool screenIdle) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    pollScheduler.setIdle(screenIdle);
+
+    // Nothing is sent until Retry-After has passed anyway
+    return pollScheduler.isDue() && rateLimiter.getBlockedMs() == 0;
+}
+
 bool SpotifyClient::updateNowPlaying() {
     if (!ensureValidToken()) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pollScheduler.onPollComplete(false, false, 0, 0);
         return false;
     }
 
-    StaticJsonDocument<4096> doc;
+    DynamicJsonDocument doc(SPOTIFY_PLAYER_JSON_SIZE);
+
+    // The full player state costs no more than currently-playing
+    if (!httpGet(RequestBuilder(SPOTIFY_API_BASE, "/me/player"), doc, 200, &playerFilter())) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (lastHttpCode == HTTPC_ERROR_DEFERRED) {
+            // Tokens are kept for user commands, not an error worth backing off for
+            pollScheduler.onPollDeferred(currentTrack.isPlaying, playbackClock.getProgressMs(),
+                                         currentTrack.durationMs);
+        } else {
+            pollScheduler.onPollComplete(false, false, 0, 0);
+        }
+        return false;
+    }
+
+    // Parse outside the lock, the loop task reads the current track
+    bool hasItem = doc.containsKey("item") && doc["item"] != nullptr;
+    bool hasDevice = doc.containsKey("device");
+    TrackInfo track;
+    DeviceInfo device;
+    ContextInfo context;
+    bool shuffle = doc["shuffle_state"] | false;
+    RepeatMode repeat = parseRepeatMode(doc["repeat_state"] | "off");
+    unsigned long sampledAt = 0;
+
+    // Sent without an item too (ads, or between tracks)
+    if (hasDevice) {
+        JsonObject deviceJson = doc["device"];
+        device.id = deviceJson["id"] | "";
+        device.name = deviceJson["name"] | "";
+        device.type = deviceJson["type"] | "";
+        device.isActive = deviceJson["is_active"] | false;
+        device.volumePercent = deviceJson["volume_percent"] | 50;
+    }
+
+    // null when playing from search results or a single track
+    if (!doc["context"].isNull()) {
+        assignUrl(context.uri, doc["context"]["uri"] | "");
+        context.type = doc["context"]["type"] | "";
+    }
+
+    if (hasItem) {
+        JsonObject item = doc["item"];
+        track = parseTrack(item);
+        track.isPlaying = doc["is_playing"] | false;
+        track.progressMs = doc["progress_ms"] | 0;
+        sampledAt = estimateSampleTime(doc["timestamp"].as<int64_t>());
+
+        // Only a new (or expired) track costs a lookup
+        if (savedTracks.request(track.id)) {
+            fetchSavedTracks();
+        }
+        track.saved = savedTracks.get(track.id) == SavedState::SAVED;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
 
-    if (!httpGet("/me/player/currently-playing", doc, 200)) {
-        // 204 means nothing is playing
-        if (http.lastResponseCode() == 204) {
-            currentTrack.isPlaying = false;
+    // Right after the predicted end of a track Spotify may still report it
+    if (!predictedFromTrackId.isEmpty()) {
+        if (hasItem && track.id == predictedFromTrackId &&
+            millis() - predictedTime < SPOTIFY_TRACK_END_HOLD_MS) {
+            pollScheduler.onPollComplete(true, track.isPlaying, track.progressMs, track.durationMs);
             return true;
         }
+        predictedFromTrackId.clear();
+    }
+
+    // Right after a command Spotify may still report the old state
+    bool hold = isHoldingOptimisticState();
+    uint32_t changes = 0;
+
+    // 204 means nothing is playing
+    if (lastHttpCode == 204 && !hold) {
+        if (currentTrack.isPlaying) {
+            changes |= CHANGED_PLAYING;
+        }
+        currentTrack.isPlaying = false;
+        playbackClock.setPlaying(false);
+    }
+
+    if (hasItem) {
+        bool skipping = skipPending && track.id == skipFromTrackId;
+        if (hold) {
+            track.isPlaying = currentTrack.isPlaying;
+        }
+
+        // What comes next changed with the track
+        if (track.id != currentTrack.id) {
+            queueStale = true;
+            queueDueTime = millis() + SPOTIFY_QUEUE_FETCH_DELAY_MS;
+        }
+
+        changes |= diffTrack(currentTrack, track);
+        currentTrack = track;
+        if (!skipping) {
+            // Regular playback is predicted by the clock, only a jump is news
+            int predictedMs = playbackClock.getProgressMs();
+            playbackClock.sync(track.progressMs, track.durationMs, track.isPlaying, sampledAt);
+            if (abs(playbackClock.getProgressMs() - predictedMs) >= SPOTIFY_PROGRESS_JUMP_MS) {
+                changes |= CHANGED_PROGRESS;
+            }
+        }
+
+        // Skip is done once the track changed or Spotify had time to apply it
+        if (skipPending && (!skipping || !hold)) {
+            skipPending = false;
+            changes |= CHANGED_SKIP;
+        }
+    }
+
+    if (hasDevice) {
+        if (device.id != currentDevice.id || device.name != currentDevice.name ||
+            device.type != currentDevice.type || device.isActive != currentDevice.isActive) {
+            changes |= CHANGED_DEVICE;
+        }
+        currentDevice.id = device.id;
+        currentDevice.name = device.name;
+        currentDevice.type = device.type;
+        currentDevice.isActive = device.isActive;
+        if (!volumeCommand.isActive() && device.volumePercent != currentDevice.volumePercent) {
+            currentDevice.volumePercent = device.volumePercent;
+            changes |= CHANGED_VOLUME;
+        }
+
+        if (shuffle != shuffleState || repeat != repeatMode) {
+            shuffleState = shuffle;
+            repeatMode = repeat;
+            changes |= CHANGED_MODE;
+        }
+        if (context.uri != currentContext.uri || context.type != currentContext.type) {
+            currentContext = context;
+            changes |= CHANGED_CONTEXT;
+        }
+    }
+
+    markChanged(changes);
+
+    pollScheduler.onPollComplete(true, currentTrack.isPlaying,
+                                 currentTrack.progressMs, currentTrack.durationMs);
+    return true;
+}
+
+bool SpotifyClient::updateQueue() {
+    if (!ensureValidToken()) {
         return false;
     }
 
-    // Parse response
-    if (doc.containsKey("item") && doc["item"] != nullptr) {
-        JsonObject item = doc["item"];
-        currentTrack = parseTrack(item);
-        currentTrack.isPlaying = doc["is_playing"] | false;
-        currentTrack.progressMs = doc["progress_ms"] | 0;
+    // Sized for the whole queue, only the first few are kept
+    DynamicJsonDocument doc(SPOTIFY_QUEUE_JSON_SIZE);
+
+    if (!httpGet(RequestBuilder(SPOTIFY_API_BASE, "/me/player/queue"), doc, 200, &queueFilter())) {
+        return false;
+    }
+
+    SpotifyId playingId;
+    playingId = doc["currently_playing"]["id"] | "";
 
-        // Get device info
-        if (doc.containsKey("device")) {
-            JsonObject device = doc["device"];
-            currentDevice.id = device["id"] | "";
-            currentDevice.name = device["name"] | "";
-            currentDevice.volumePercent = device["volume_percent"] | 50;
+    TrackInfo tracks[SPOTIFY_QUEUE_PREFETCH];
+    size_t count = 0;
+    for (JsonObject item : doc["queue"].as<JsonArray>()) {
+        if (count == SPOTIFY_QUEUE_PREFETCH) {
+            break;
         }
+        tracks[count++] = parseTrack(item);
     }
 
+    // The heart is right as soon as the track starts, one lookup for all of them
+    bool lookup = false;
+    for (size_t i = 0; i < count; i++) {
+        lookup |= savedTracks.request(tracks[i].id);
+    }
+    if (lookup) {
+        fetchSavedTracks();
+    }
+    for (size_t i = 0; i < count; i++) {
+        tracks[i].saved = savedTracks.get(tracks[i].id) == SavedState::SAVED;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    // The track changed meanwhile, its own fetch is queued
+    if (playingId != currentTrack.id) {
+        return true;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        upcoming[i] = tracks[i];
+    }
+    upcomingCount = count;
+    upcomingAfterId = playingId;
+    markChanged(CHANGED_QUEUE);
+
+    Serial.printf("📋 Up next: %s\n", count > 0 ? tracks[0].title.c_str() : "nothing");
     return true;
 }
 
+bool SpotifyClient::getUpcomingTrack(size_t index, TrackInfo& track) const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (index >= upcomingCount || upcomingAfterId != currentTrack.id) {
+        return false;
+    }
+    track = upcoming[index];
+    return true;
+}
+
+void SpotifyClient::requestTogglePlay() {
+    if (rejectWhileUnreachable()) {
+        return;
+    }
+
+    bool playing;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        playing = !currentTrack.isPlaying;
+        currentTrack.isPlaying = playing;
+        playbackClock.setPlaying(playing);
+        markChanged(CHANGED_PLAYING);
+    }
+
+    runCommand([this, playing]() { return playing ? play() : pause(); },
+               [this, playing]() {
+                   // Only undo if nothing changed it since
+                   if (currentTrack.isPlaying == playing) {
+                       currentTrack.isPlaying = !playing;
+                       playbackClock.setPlaying(!playing);
+                       markChanged(CHANGED_PLAYING);
+                   }
+               });
+}
+
+void SpotifyClient::requestNextTrack() {
+    requestSkip(true);
+}
+
+void SpotifyClient::requestPreviousTrack() {
+    requestSkip(false);
+}
+
 bool SpotifyClient::play() {
     if (!ensureValidToken()) {
         return false;
     }
 
-    return httpPut("/me/player/play");
+    if (!httpPut(RequestBuilder(SPOTIFY_API_BASE, "/me/player/play"))) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    playbackClock.setPlaying(true);
+    return true;
 }
 
 bool SpotifyClient::pause() {
@@ -88,11 +421,23 @@ bool SpotifyClient::pause() {
         return false;
     }
 
-    return httpPut("/me/player/pause");
+    if (!httpPut(RequestBuilder(SPOTIFY_API_BASE, "/me/player/pause"))) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    playbackClock.setPlaying(false);
+    return true;
 }
 
 bool SpotifyClient::togglePlay() {
-    if (currentTrack.isPlaying) {
+    bool playing;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        playing = currentTrack.isPlaying;
+    }
+
+    if (playing) {
         return pause();
     } else {
         return play();
@@ -104,7 +449,7 @@ bool SpotifyClient::nextTrack() {
         return false;
     }
 
-    return httpPost("/me/player/next", "", 204);
+    return httpPost(RequestBuilder(SPOTIFY_API_BASE, "/me/player/next"), 204);
 }
 
 bool SpotifyClient::previousTrack() {
@@ -112,7 +457,7 @@ bool SpotifyClient::previousTrack() {
         return false;
     }
 
-    return httpPost("/me/player/previous", "", 204);
+    return httpPost(RequestBuilder(SPOTIFY_API_BASE, "/me/player/previous"), 204);
 }
 
 bool SpotifyClient::seek(int positionMs) {
@@ -120,8 +465,16 @@ bool SpotifyClient::seek(int positionMs) {
         return false;
     }
 
-    String endpoint = "/me/player/seek?position_ms=" + String(positionMs);
-    return httpPut(endpoint);
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/me/player/seek?position_ms=%d", positionMs);
+    if (!httpPut(request)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    playbackClock.seek(positionMs);
+    markChanged(CHANGED_PROGRESS);
+    return true;
 }
 
 bool SpotifyClient::setVolume(int volumePercent) {
@@ -130,35 +483,76 @@ bool SpotifyClient::setVolume(int volumePercent) {
     }
 
     volumePercent = constrain(volumePercent, 0, 100);
-    String endpoint = "/me/player/volume?volume_percent=" + String(volumePercent);
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/me/player/volume?volume_percent=%d", volumePercent);
 
-    bool success = httpPut(endpoint);
+    bool success = httpPut(request);
     if (success) {
-        currentDevice.volumePercent = volumePercent;
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (currentDevice.volumePercent != volumePercent) {
+            currentDevice.volumePercent = volumePercent;
+            markChanged(CHANGED_VOLUME);
+        }
     }
 
     return success;
 }
 
 bool SpotifyClient::adjustVolume(int delta) {
-    int newVolume = currentDevice.volumePercent + delta;
+    int newVolume;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        newVolume = currentDevice.volumePercent + delta;
+    }
     return setVolume(newVolume);
 }
 
-int SpotifyClient::getVolume() {
-    // Try to get current volume from device
-    if (!ensureValidToken()) {
-        return currentDevice.volumePercent;
+void SpotifyClient::queueVolume(int volumePercent) {
+    if (rejectWhileUnreachable()) {
+        return;
     }
 
-    StaticJsonDocument<2048> doc;
-    if (httpGet("/me/player", doc, 200)) {
-        if (doc.containsKey("device")) {
-            JsonObject device = doc["device"];
-            currentDevice.volumePercent = device["volume_percent"] | 50;
+    volumePercent = constrain(volumePercent, 0, 100);
+
+    // Polls keep this value while the command is active
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!volumeCommand.isActive()) {
+            volumeBeforeCommand = currentDevice.volumePercent;
         }
+        if (currentDevice.volumePercent != volumePercent) {
+            currentDevice.volumePercent = volumePercent;
+            markChanged(CHANGED_VOLUME);
+        }
+    }
+
+    volumeCommand.set(volumePercent);
+}
+
+void SpotifyClient::queueVolumeChange(int delta) {
+    int current;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        current = currentDevice.volumePercent;
+    }
+
+    // Step from the value still on its way, not the last confirmed one
+    queueVolume(volumeCommand.getLatest(current) + delta);
+}
+
+void SpotifyClient::queueSeek(int positionMs) {
+    if (rejectWhileUnreachable()) {
+        return;
     }
 
+    seekCommand.set(max(positionMs, 0));
+}
+
+int SpotifyClient::getVolume() {
+    // Volume comes with the rest of the player state, no request of its own
+    updateNowPlaying();
+
+    std::lock_guard<std::mutex> lock(stateMutex);
     return currentDevice.volumePercent;
 }
 
@@ -167,8 +561,15 @@ bool SpotifyClient::saveTrack(const String& trackId) {
         return false;
     }
 
-    String endpoint = "/me/tracks?ids=" + trackId;
-    return httpPut(endpoint);
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/me/tracks?ids=%s", trackId.c_str());
+    if (!httpPut(request, 200)) {
+        savedTracks.invalidate(trackId);
+        return false;
+    }
+
+    storeSavedState(trackId, true);
+    return true;
 }
 
 bool SpotifyClient::removeTrack(const String& trackId) {
@@ -176,26 +577,40 @@ bool SpotifyClient::removeTrack(const String& trackId) {
         return false;
     }
 
-    String endpoint = "/me/tracks?ids=" + trackId;
-    return httpDelete(endpoint);
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/me/tracks?ids=%s", trackId.c_str());
+    if (!httpDelete(request)) {
+        savedTracks.invalidate(trackId);
+        return false;
+    }
+
+    storeSavedState(trackId, false);
+    return true;
 }
 
 bool SpotifyClient::isTrackSaved(const String& trackId) {
-    if (!ensureValidToken()) {
-        return false;
+    SavedState state = savedTracks.get(trackId);
+    if (state == SavedState::UNKNOWN && savedTracks.request(trackId)) {
+        fetchSavedTracks();
+        state = savedTracks.get(trackId);
     }
 
-    String endpoint = "/me/tracks/contains?ids=" + trackId;
-    StaticJsonDocument<512> doc;
+    return state == SavedState::SAVED;
+}
 
-    if (httpGet(endpoint, doc, 200)) {
-        JsonArray arr = doc.as<JsonArray>();
-        if (arr.size() > 0) {
-            return arr[0].as<bool>();
-        }
+void SpotifyClient::fillSavedState(std::vector<TrackInfo>& tracks) {
+    bool fetch = false;
+    for (const TrackInfo& track : tracks) {
+        fetch |= savedTracks.request(track.id);
     }
 
-    return false;
+    if (fetch) {
+        fetchSavedTracks();
+    }
+
+    for (TrackInfo& track : tracks) {
+        track.saved = savedTracks.get(track.id) == SavedState::SAVED;
+    }
 }
 
 std::vector<SpotifyClient::DeviceInfo> SpotifyClient::getDevices() {
@@ -206,7 +621,7 @@ std::vector<SpotifyClient::DeviceInfo> SpotifyClient::getDevices() {
     }
 
     StaticJsonDocument<4096> doc;
-    if (httpGet("/me/player/devices", doc, 200)) {
+    if (httpGet(RequestBuilder(SPOTIFY_API_BASE, "/me/player/devices"), doc, 200)) {
         JsonArray arr = doc["devices"];
         for (JsonObject deviceJson : arr) {
             DeviceInfo info;
@@ -227,30 +642,59 @@ bool SpotifyClient::setDevice(const String& deviceId) {
         return false;
     }
 
-    String body = "{\"device_ids\":[\"" + deviceId + "\"]}";
-    return httpPut("/me/player", body);
+    RequestBuilder request(SPOTIFY_API_BASE, "/me/player");
+    request.body("{\"device_ids\":[\"%s\"]}", deviceId.c_str());
+    return httpPut(request);
+}
+
+SpotifyClient::PlaybackSnapshot SpotifyClient::getPlaybackSnapshot() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    PlaybackSnapshot snapshot;
+    snapshot.isPlaying = currentTrack.isPlaying;
+    snapshot.saved = currentTrack.saved;
+    snapshot.skipPending = skipPending;
+    snapshot.shuffle = shuffleState;
+    snapshot.repeat = repeatMode;
+    snapshot.progressMs = playbackClock.getProgressMs();
+    snapshot.durationMs = currentTrack.durationMs;
+    snapshot.volumePercent = currentDevice.volumePercent;
+    snapshot.generation = stateGeneration;
+    return snapshot;
 }
 
 SpotifyClient::DeviceInfo SpotifyClient::getCurrentDevice() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     return currentDevice;
 }
 
-std::vector<SpotifyClient::PlaylistInfo> SpotifyClient::getPlaylists() {
-    std::vector<PlaylistInfo> playlists;
+bool SpotifyClient::getPlaylists(PlaylistPage& page, int offset, int limit) {
+    page = PlaylistPage();
+    page.offset = offset;
 
     if (!ensureValidToken()) {
-        return playlists;
+        return false;
     }
 
-    StaticJsonDocument<8192> doc;
-    if (httpGet("/me/playlists?limit=50", doc, 200)) {
-        JsonArray arr = doc["items"];
-        for (JsonObject playlistJson : arr) {
-            playlists.push_back(parsePlaylist(playlistJson));
-        }
+    limit = constrain(limit, 1, SPOTIFY_PLAYLIST_LIMIT);
+
+    DynamicJsonDocument doc(SPOTIFY_PLAYLISTS_JSON_SIZE(limit));
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/me/playlists?limit=%d&offset=%d", limit, offset);
+    if (!httpGet(request, doc, 200, &playlistsFilter())) {
+        return false;
     }
 
-    return playlists;
+    JsonArray arr = doc["items"];
+    page.items.reserve(arr.size());
+    for (JsonObject playlistJson : arr) {
+        page.items.push_back(parsePlaylist(playlistJson));
+    }
+
+    page.offset = doc["offset"] | offset;
+    page.total = doc["total"] | 0;
+    page.hasNext = !doc["next"].isNull();
+    return true;
 }
 
 SpotifyClient::PlaylistInfo SpotifyClient::getPlaylist(const String& playlistId) {
@@ -260,11 +704,12 @@ SpotifyClient::PlaylistInfo SpotifyClient::getPlaylist(const String& playlistId)
         return info;
     }
 
-    String endpoint = "/playlists/" + playlistId;
-    StaticJsonDocument<8192> doc;
+    RequestBuilder request(SPOTIFY_API_BASE);
+    request.path("/playlists/%s", playlistId.c_str());
+    DynamicJsonDocument doc(SPOTIFY_PLAYLIST_JSON_SIZE);
 
-    if (httpGet(endpoint, doc, 200)) {
-        info = parsePlaylist(doc);
+    if (httpGet(request, doc, 200, &playlistFilter())) {
+        info = parsePlaylist(doc.as<JsonObject>());
     }
 
     return info;
@@ -275,13 +720,13 @@ bool SpotifyClient::playPlaylist(const String& playlistId, const String& deviceI
         return false;
     }
 
-    String body = "{\"context_uri\":\"spotify:playlist:" + playlistId + "\"}";
-
+    RequestBuilder request(SPOTIFY_API_BASE, "/me/player/play");
     if (!deviceId.isEmpty()) {
-        body = "{\"device_ids\":[\"" + deviceId + "\"],\"context_uri\":\"spotify:playlist:" + playlistId + "\"}";
+        request.path("?device_id=%s", deviceId.c_str());
     }
+    request.body("{\"context_uri\":\"spotify:playlist:%s\"}", playlistId.c_str());
 
-    return httpPut("/me/player/play", body);
+    return httpPut(request);
 }
 
 bool SpotifyClient::playTrack(const String& trackUri, const String& deviceId) {
@@ -289,183 +734,723 @@ bool SpotifyClient::playTrack(const String& trackUri, const String& deviceId) {
         return false;
     }
 
-    String body = "{\"uris\":[\"" + trackUri + "\"]}";
-
+    RequestBuilder request(SPOTIFY_API_BASE, "/me/player/play");
     if (!deviceId.isEmpty()) {
-        body = "{\"device_ids\":[\"" + deviceId + "\"],\"uris\":[\"" + trackUri + "\"]}";
+        request.path("?device_id=%s", deviceId.c_str());
     }
+    request.body("{\"uris\":[\"%s\"]}", trackUri.c_str());
 
-    return httpPut("/me/player/play", body);
+    return httpPut(request);
 }
 
-SpotifyClient::SearchResult SpotifyClient::search(const String& query, int limit) {
+SpotifyClient::SearchResult SpotifyClient::search(const String& query, int limit, int offset) {
     SearchResult result;
 
     if (!ensureValidToken()) {
         return result;
     }
 
-    String encodedQuery = query;
-    encodedQuery.replace(" ", "%20");
-
-    String endpoint = "/search?q=" + encodedQuery + "&type=track,playlist&limit=" + String(limit);
-    StaticJsonDocument<16384> doc;
+    RequestBuilder request(SPOTIFY_API_BASE, "/search?q=");
+    request.encoded(query.c_str());
+    request.path("&type=track,playlist&limit=%d&offset=%d", limit, offset);
+    DynamicJsonDocument doc(SPOTIFY_SEARCH_JSON_SIZE(limit));
 
-    if (httpGet(endpoint, doc, 200)) {
+    if (httpGet(request, doc, 200, &searchFilter())) {
         // Parse tracks
         if (doc.containsKey("tracks")) {
             JsonObject tracks = doc["tracks"];
             if (tracks.containsKey("items")) {
                 JsonArray items = tracks["items"];
                 for (JsonObject item : items) {
-                    result.tracks.push_back(parseTrack(item["track"]));
+                    result.tracks.push_back(parseTrack(item));
                 }
             }
+            result.hasMore |= !tracks["next"].isNull();
         }
 
+        fillSavedState(result.tracks);
+
         // Parse playlists
         if (doc.containsKey("playlists")) {
             JsonObject playlists = doc["playlists"];
             if (playlists.containsKey("items")) {
                 JsonArray items = playlists["items"];
                 for (JsonObject item : items) {
-                    result.playlists.push_back(parsePlaylist(item));
+                    // Spotify returns null for playlists it can't show
+                    if (!item.isNull()) {
+                        result.playlists.push_back(parsePlaylist(item));
+                    }
                 }
             }
+            result.hasMore |= !playlists["next"].isNull();
         }
     }
 
     return result;
 }
 
-bool SpotifyClient::downloadImage(const String& url, const String& path) {
-    // TODO: Implement image download
-    // This requires HTTP client and file system integration
-    return false;
+bool SpotifyClient::downloadImage(const char* url, const char* path,
+                                  const std::function<bool()>& cancelled) {
+    char tempPath[SPOTIFY_IMAGE_PATH_LENGTH + 5];
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", path) >= (int)sizeof(tempPath)) {
+        Serial.printf("⚠️  Image path too long: %s\n", path);
+        return false;
+    }
+
+    // The CDN is down, try again with the next cover after the backoff
+    if (breaker.isRejecting(url)) {
+        return false;
+    }
+
+    // The CDN doesn't need (and shouldn't see) the access token
+    HttpRequest httpRequest("GET", url);
+
+    unsigned long start = millis();
+    size_t written = 0;
+    bool complete = false;
+    bool wasCancelled = false;
+
+    // Passed by reference so std::function doesn't allocate a copy
+    auto onResponse = [&](HttpResponse& response) {
+        if (response.getCode() != 200) {
+            return;
+        }
+
+        int size = response.getSize();
+        if (size > SPOTIFY_IMAGE_MAX_BYTES) {
+            Serial.printf("⚠️  Image too large (%d bytes): %s\n", size, url);
+            response.abort();
+            return;
+        }
+
+        File file = LittleFS.open(tempPath, FILE_WRITE);
+        if (!file) {
+            Serial.printf("⚠️  Failed to create %s\n", tempPath);
+            response.abort();
+            return;
+        }
+
+        Stream& body = response.getBody();
+        uint8_t buffer[SPOTIFY_IMAGE_CHUNK_SIZE];
+
+        while (true) {
+            if (cancelled && cancelled()) {
+                wasCancelled = true;
+                response.abort();
+                break;
+            }
+
+            size_t length = body.readBytes(reinterpret_cast<char*>(buffer), sizeof(buffer));
+            if (length == 0) {
+                // A timeout or a dropped connection also ends the body early
+                complete = response.isComplete() &&
+                           (size < 0 || written == static_cast<size_t>(size));
+                break;
+            }
+
+            if (written + length > SPOTIFY_IMAGE_MAX_BYTES) {
+                Serial.printf("⚠️  Image too large (> %d bytes): %s\n", SPOTIFY_IMAGE_MAX_BYTES, url);
+                response.abort();
+                break;
+            }
+
+            if (file.write(buffer, length) != length) {
+                Serial.printf("⚠️  Failed to write %s (flash full?)\n", tempPath);
+                response.abort();
+                break;
+            }
+            written += length;
+        }
+
+        file.close();
+    };
+    int httpCode = transport->send(httpRequest, std::ref(onResponse));
+
+    if (!complete) {
+        LittleFS.remove(tempPath);
+        if (wasCancelled) {
+            Serial.printf("🚫 Image download cancelled after %u bytes\n", (unsigned)written);
+        } else {
+            Serial.printf("⚠️  Image download failed (%d, %u bytes)\n", httpCode, (unsigned)written);
+        }
+        return false;
+    }
+
+    LittleFS.remove(path);
+    if (!LittleFS.rename(tempPath, path)) {
+        Serial.printf("⚠️  Failed to rename %s\n", tempPath);
+        LittleFS.remove(tempPath);
+        return false;
+    }
+
+    Serial.printf("🖼️  Image downloaded: %u bytes in %lu ms\n", (unsigned)written, millis() - start);
+    return true;
 }
 
 // Private methods
 
-bool SpotifyClient::httpGet(const String& endpoint, JsonDocument& doc, int expectedCode) {
-    String url = String(SPOTIFY_API_BASE) + endpoint;
+bool SpotifyClient::httpGet(const RequestBuilder& request, JsonDocument& doc, int expectedCode,
+                            const JsonDocument* filter) {
+    if (!request.isValid()) {
+        Serial.printf("⚠️  Request too long: %s\n", request.getPath());
+        return false;
+    }
+
+    // Fail at once while the API is down, without using up a token
+    if (breaker.isRejecting(request.getUrl())) {
+        lastHttpCode = HTTPC_ERROR_CIRCUIT_OPEN;
+        return false;
+    }
+
+    if (!acquireRequestSlot()) {
+        return false;
+    }
+
+    HttpRequest httpRequest("GET", request.getUrl());
+    AuthorizationHeader authorization;
+    uint32_t generation;
+    addAuthorization(httpRequest, authorization, generation);
 
-    http.begin(client, url);
-    http.addHeader("Authorization", "Bearer " + accessToken);
-    http.addHeader("Content-Type", "application/json");
+    bool succeeded = false;
 
-    int httpCode = http.GET();
+    // Passed by reference so std::function doesn't allocate a copy
+    auto onResponse = [&](HttpResponse& response) {
+        int code = response.getCode();
+        lastResponseTime = millis();
+        lastRequestLatency = response.getRequestUs() / 1000;
 
-    if (httpCode == expectedCode || httpCode == 204) {
-        String payload = http.getString();
-        if (!payload.isEmpty() && payload.length() < 65536) {
-            DeserializationError error = deserializeJson(doc, payload);
+        if (code == 204 || (code == expectedCode && response.getSize() == 0)) {
+            succeeded = true;
+            return;
+        }
+
+        if (code == expectedCode) {
+            Stream& body = response.getBody();
+
+            unsigned long start = micros();
+            DeserializationError error = filter
+                ? deserializeJson(doc, body, DeserializationOption::Filter(*filter))
+                : deserializeJson(doc, body);
+            unsigned long parseUs = micros() - start;
+
+#if SPOTIFY_LOG_PARSE
+            Serial.printf("📦 %s: %u bytes, parsed in %lu.%lu ms, doc %u/%u bytes\n",
+                          request.getPath(), (unsigned)response.getBytesRead(),
+                          parseUs / 1000, (parseUs % 1000) / 100,
+                          (unsigned)doc.memoryUsage(), (unsigned)doc.capacity());
+#else
+            (void)parseUs;
+#endif
+
+            // A document that ran full lacks the rest of the fields, and
+            // parsing it would overwrite good state with defaults
+            if (error == DeserializationError::NoMemory) {
+                Serial.printf("⚠️  JSON doesn't fit in %u bytes: %s\n",
+                              (unsigned)doc.capacity(), request.getPath());
+                return;
+            }
             if (error) {
                 Serial.printf("⚠️  JSON parse error: %s\n", error.c_str());
-                http.end();
-                return false;
+                return;
             }
+            succeeded = true;
+            return;
+        }
+
+        if (code == 429) {
+            onRateLimited(response);
         }
-        http.end();
-        return true;
-    }
 
-    Serial.printf("⚠️  HTTP %d: %s\n", httpCode, http.getString().c_str());
-    http.end();
+        char text[SPOTIFY_ERROR_LOG_LENGTH + 1];
+        size_t length = response.getBody().readBytes(text, SPOTIFY_ERROR_LOG_LENGTH);
+        text[length] = '\0';
+        Serial.printf("⚠️  HTTP %d: %s\n", code, text);
+    };
+    int httpCode = transport->send(httpRequest, std::ref(onResponse));
+    lastHttpCode = httpCode;
+
+    if (httpCode <= 0) {
+        lastResponseTime = millis();
+        lastRequestLatency = 0;
+        // Logged once by the breaker when it opens, and by the pool
+        if (httpCode != HTTPC_ERROR_CIRCUIT_OPEN && httpCode != HTTPC_ERROR_NO_CONNECTION) {
+            Serial.printf("⚠️  HTTP error: %s\n", HTTPClient::errorToString(httpCode).c_str());
+        }
+    }
 
     // Token might be expired
     if (httpCode == 401) {
-        refreshTokenIfNeeded();
+        onUnauthorized(generation);
     }
 
-    return false;
+    return succeeded;
+}
+
+bool SpotifyClient::httpPut(const RequestBuilder& request, int expectedCode) {
+    return httpSend("PUT", request, expectedCode);
+}
+
+bool SpotifyClient::httpPost(const RequestBuilder& request, int expectedCode) {
+    return httpSend("POST", request, expectedCode);
+}
+
+bool SpotifyClient::httpDelete(const RequestBuilder& request, int expectedCode) {
+    return httpSend("DELETE", request, expectedCode);
 }
 
-bool SpotifyClient::httpPut(const String& endpoint, const String& body, int expectedCode) {
-    String url = String(SPOTIFY_API_BASE) + endpoint;
+bool SpotifyClient::httpSend(const char* method, const RequestBuilder& request, int expectedCode) {
+#if SPOTIFY_COUNT_ALLOCS
+    uint64_t allocsAtStart = native_heap_alloc_count();
+#endif
+
+    if (!request.isValid()) {
+        Serial.printf("⚠️  Request too long: %s\n", request.getPath());
+        return false;
+    }
+
+    // Fail at once while the API is down, without using up a token
+    if (breaker.isRejecting(request.getUrl())) {
+        lastHttpCode = HTTPC_ERROR_CIRCUIT_OPEN;
+        return false;
+    }
+
+    if (!acquireRequestSlot()) {
+        return false;
+    }
+
+    HttpRequest httpRequest(method, request.getUrl());
+    if (request.getBodyLength() > 0) {
+        httpRequest.contentType = "application/json";
+        httpRequest.body = request.getBody();
+        httpRequest.bodyLength = request.getBodyLength();
+    }
 
-    http.begin(client, url);
-    http.addHeader("Authorization", "Bearer " + accessToken);
-    http.addHeader("Content-Type", "application/json");
+    AuthorizationHeader authorization;
+    uint32_t generation;
+    addAuthorization(httpRequest, authorization, generation);
 
-    int httpCode = http.PUT(body);
+#if SPOTIFY_COUNT_ALLOCS
+    uint64_t clientAllocs = native_heap_alloc_count() - allocsAtStart;
+#endif
 
-    http.end();
+    // Passed by reference so std::function doesn't allocate a copy
+    auto onResponse = [this](HttpResponse& response) {
+        if (response.getCode() == 429) {
+            onRateLimited(response);
+        }
+    };
+    int httpCode = transport->send(httpRequest, std::ref(onResponse));
+    lastHttpCode = httpCode;
 
     if (httpCode == 401) {
-        refreshTokenIfNeeded();
+        onUnauthorized(generation);
+    }
+
+#if SPOTIFY_COUNT_ALLOCS
+    {
+        uint32_t total = static_cast<uint32_t>(native_heap_alloc_count() - allocsAtStart);
+        std::lock_guard<std::mutex> lock(stateMutex);
+        allocStats.requests++;
+        allocStats.lastClientAllocs = static_cast<uint32_t>(clientAllocs);
+        allocStats.lastTotalAllocs = total;
+        allocStats.clientAllocs += allocStats.lastClientAllocs;
+        allocStats.totalAllocs += total;
+        Serial.printf("🧮 %s %s: %u allocs building, %u in total\n", method, request.getPath(),
+                      allocStats.lastClientAllocs, total);
+    }
+#endif
+
+    if (httpCode == expectedCode) {
+        // Playback state changed, pick it up quickly
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pollScheduler.onUserCommand();
+        return true;
     }
 
-    return httpCode == expectedCode;
+    return false;
 }
 
-bool SpotifyClient::httpPost(const String& endpoint, const String& body, int expectedCode) {
-    String url = String(SPOTIFY_API_BASE) + endpoint;
+bool SpotifyClient::acquireRequestSlot() {
+    RequestPriority priority = RequestQueue::getInstance().getRunningPriority();
+    if (rateLimiter.acquire(priority)) {
+        return true;
+    }
 
-    http.begin(client, url);
-    http.addHeader("Authorization", "Bearer " + accessToken);
-    http.addHeader("Content-Type", "application/json");
+    lastHttpCode = priority == RequestPriority::BACKGROUND ? HTTPC_ERROR_DEFERRED : 429;
+    return false;
+}
 
-    int httpCode = http.POST(body);
+void SpotifyClient::onRateLimited(HttpResponse& response) {
+    // Retry-After is in seconds
+    long retryAfter = response.getHeader("Retry-After").toInt();
+    rateLimiter.onRateLimited(retryAfter > 0 ? retryAfter * 1000UL : 0);
+}
 
-    http.end();
+bool SpotifyClient::ensureValidToken() {
+    unsigned long expiry;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (accessToken.isEmpty()) {
+            return false;
+        }
+        expiry = tokenExpiryTime;
+    }
 
-    if (httpCode == 401) {
-        refreshTokenIfNeeded();
+    // Normally refreshed in the background long before this
+    if (static_cast<long>(millis() - expiry) >= 0) {
+        Serial.println("🔄 Token expired, refreshing...");
+        return refreshAccessToken();
     }
 
-    return httpCode == expectedCode;
+    return true;
 }
 
-bool SpotifyClient::httpDelete(const String& endpoint, int expectedCode) {
-    String url = String(SPOTIFY_API_BASE) + endpoint;
+bool SpotifyClient::refreshAccessToken() {
+    String refresh;
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (refreshing) {
+            refreshDone.wait(lock, [this]() { return !refreshing; });
+            return refreshSucceeded;
+        }
+
+        refresh = refreshToken;
+        if (refresh.isEmpty()) {
+            Serial.println("❌ No refresh token available");
+            return false;
+        }
+        refreshing = true;
+    }
 
-    http.begin(client, url);
-    http.addHeader("Authorization", "Bearer " + accessToken);
-    http.addHeader("Content-Type", "application/json");
+    // Use AuthManager to refresh token
+    String newAccess;
+    if (authManager) {
+        newAccess = authManager->refreshAccessToken(refresh);
+    }
 
-    int httpCode = http.sendRequest("DELETE");
+    std::lock_guard<std::mutex> lock(stateMutex);
+    unsigned long now = millis();
+    refreshSucceeded = !newAccess.isEmpty();
 
-    http.end();
+    if (refreshSucceeded) {
+        unsigned long lifetime = authManager->getTokenExpiryTime() - now;
+        if (lifetime == 0 || lifetime > SPOTIFY_TOKEN_DEFAULT_LIFETIME_MS * 24) {
+            lifetime = SPOTIFY_TOKEN_DEFAULT_LIFETIME_MS;
+        }
 
-    if (httpCode == 401) {
-        refreshTokenIfNeeded();
+        accessToken = newAccess;
+        authorizationHeader = "Bearer " + newAccess;
+        refreshToken = authManager->getRefreshToken();   // Spotify may rotate it
+        tokenGeneration++;
+        tokenExpiryTime = now + lifetime;
+        tokenRefreshTime = now + (lifetime > SPOTIFY_TOKEN_REFRESH_MARGIN_MS
+                                  ? lifetime - SPOTIFY_TOKEN_REFRESH_MARGIN_MS : 0);
+        Serial.printf("✅ Token refreshed, next refresh in %lu s\n",
+                      (tokenRefreshTime - now) / 1000);
+    } else {
+        tokenRefreshTime = now + SPOTIFY_TOKEN_RETRY_MS;
     }
 
-    return httpCode == expectedCode;
+    refreshing = false;
+    refreshDone.notify_all();
+    return refreshSucceeded;
 }
 
-bool SpotifyClient::ensureValidToken() {
-    if (accessToken.isEmpty()) {
-        return false;
+void SpotifyClient::addAuthorization(HttpRequest& request, AuthorizationHeader& header,
+                                     uint32_t& generation) const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    generation = tokenGeneration;
+    if (!header.assign(authorizationHeader.c_str(), authorizationHeader.length())) {
+        Serial.println("⚠️  Access token too long for SPOTIFY_AUTHORIZATION_LENGTH");
     }
+    request.authorization = header.c_str();
+}
 
-    // Check if token is expired
-    if (millis() >= tokenExpiryTime) {
-        Serial.println("🔄 Token expired, refreshing...");
-        return refreshTokenIfNeeded();
+void SpotifyClient::onUnauthorized(uint32_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (generation != tokenGeneration) {
+            return;     // Already replaced since the request was sent
+        }
+    }
+
+    refreshAccessToken();
+}
+
+void SpotifyClient::runCommand(std::function<bool()> request, std::function<void()> rollback) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        commandsInFlight++;
+        lastCommandTime = millis();
+    }
+
+    auto onComplete = [this, rollback](bool success) {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            commandsInFlight--;
+
+            if (success) {
+                lastCommandTime = millis();
+                return;
+            }
+        }
+
+        rollbackCommand(rollback);
+    };
+
+    if (!RequestQueue::getInstance().submit(request, onComplete)) {
+        onComplete(false);
+    }
+}
+
+void SpotifyClient::rollbackCommand(const std::function<void()>& rollback) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    // Next poll is authoritative
+    lastCommandTime = 0;
+
+    Serial.println("↩️  Command failed, rolling back");
+    rollback();
+    pollScheduler.pollNow();
+}
+
+void SpotifyClient::requestSkip(bool forward) {
+    if (rejectWhileUnreachable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        skipPending = true;
+        skipFromTrackId = currentTrack.id;
+        predictedFromTrackId.clear();
+
+        // Both a skip and "previous" (which restarts past 3 s) start at 0
+        currentTrack.progressMs = 0;
+        playbackClock.seek(0);
+        markChanged(CHANGED_SKIP | CHANGED_PROGRESS);
+    }
+
+    runCommand([this, forward]() { return forward ? nextTrack() : previousTrack(); },
+               [this]() {
+                   skipPending = false;
+                   markChanged(CHANGED_SKIP);
+               });
+}
+
+bool SpotifyClient::rejectWhileUnreachable() {
+    if (!breaker.isRejecting(SPOTIFY_API_BASE)) {
+        return false;
     }
 
+    // The request would fail without being sent, so nothing is changed.
+    // Published on every tap, the UI shows why nothing happened.
+    publish(Event(EventType::SPOTIFY_UNREACHABLE));
     return true;
 }
 
-bool SpotifyClient::refreshTokenIfNeeded() {
-    if (refreshToken.isEmpty()) {
-        Serial.println("❌ No refresh token available");
+bool SpotifyClient::isHoldingOptimisticState() const {
+    return commandsInFlight > 0 ||
+           (lastCommandTime != 0 && millis() - lastCommandTime < SPOTIFY_OPTIMISTIC_HOLD_MS);
+}
+
+void SpotifyClient::advanceAtTrackEnd() {
+    // Progress stops at the duration, so this stays true once the track is over.
+    // On repeat the track starts over instead, the poll shows that.
+    if (!playbackClock.isPlaying() || playbackClock.getDurationMs() <= 0 ||
+        playbackClock.getProgressMs() < playbackClock.getDurationMs() ||
+        skipPending || repeatMode == RepeatMode::TRACK ||
+        upcomingCount == 0 || upcomingAfterId != currentTrack.id) {
+        return;
+    }
+
+    // Spotify gets there too, the poll right after the end confirms it
+    predictedFromTrackId = currentTrack.id;
+    predictedTime = millis();
+
+    TrackInfo next = upcoming[0];
+    next.isPlaying = true;
+    next.progressMs = 0;
+    next.volumePercent = currentTrack.volumePercent;
+
+    uint32_t changes = diffTrack(currentTrack, next) | CHANGED_PROGRESS | CHANGED_QUEUE;
+    currentTrack = next;
+    playbackClock.sync(0, next.durationMs, true, predictedTime);
+
+    // The one after it is next now, the rest comes with the next fetch
+    for (size_t i = 1; i < upcomingCount; i++) {
+        upcoming[i - 1] = upcoming[i];
+    }
+    upcomingCount--;
+    upcomingAfterId = currentTrack.id;
+    queueStale = true;
+    queueDueTime = predictedTime + SPOTIFY_QUEUE_FETCH_DELAY_MS;
+
+    markChanged(changes);
+    Serial.printf("⏭️  Track ended, playing %s\n", currentTrack.title.c_str());
+}
+
+void SpotifyClient::scheduleQueueFetch() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        // Commands and the polls confirming them go first, and nothing is
+        // sent until Retry-After has passed anyway
+        if (!queueStale || queueInFlight || accessToken.isEmpty() ||
+            static_cast<long>(millis() - queueDueTime) < 0 || skipPending ||
+            isHoldingOptimisticState() || rateLimiter.getBlockedMs() > 0 ||
+            RequestQueue::getInstance().hasUserRequests()) {
+            return;
+        }
+        queueStale = false;
+        queueInFlight = true;
+    }
+
+    bool queued = RequestQueue::getInstance().submit(
+        [this]() { return updateQueue(); },
+        [this](bool success) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            queueInFlight = false;
+
+            // Try again later, unless a track change already asked for a new fetch
+            if (!success && !queueStale) {
+                queueStale = true;
+                queueDueTime = millis() + SPOTIFY_QUEUE_RETRY_MS;
+            }
+        },
+        RequestPriority::BACKGROUND);
+
+    if (!queued) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queueInFlight = false;
+        queueStale = true;
+        queueDueTime = millis() + SPOTIFY_QUEUE_RETRY_MS;
+    }
+}
+
+void SpotifyClient::publish(const Event& event) {
+    if (eventBus) {
+        eventBus->publish(event);
+    }
+}
+
+void SpotifyClient::markChanged(uint32_t changes) {
+    if (changes == 0) {
+        return;
+    }
+    pendingChanges |= changes;
+    stateGeneration++;
+}
+
+void SpotifyClient::publishChanges() {
+    // Runs every loop, don't take the lock while nothing changed
+    if (stateGeneration == publishedGeneration) {
+        return;
+    }
+
+    uint32_t changes;
+    int volumePercent;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        changes = pendingChanges;
+        pendingChanges = 0;
+        publishedGeneration = stateGeneration;
+        volumePercent = currentDevice.volumePercent;
+    }
+
+    if (changes & CHANGED_TRACK) {
+        publish(Event(EventType::TRACK_CHANGED, static_cast<int>(changes)));
+    }
+    if (changes & (CHANGED_PLAYING | CHANGED_PROGRESS | CHANGED_SAVED | CHANGED_SKIP |
+                   CHANGED_DEVICE | CHANGED_QUEUE | CHANGED_MODE | CHANGED_CONTEXT)) {
+        publish(Event(EventType::PLAYBACK_CHANGED, static_cast<int>(changes)));
+    }
+    if (changes & CHANGED_VOLUME) {
+        publish(Event(EventType::VOLUME_CHANGED, volumePercent));
+    }
+}
+
+uint32_t SpotifyClient::diffTrack(const TrackInfo& before, const TrackInfo& after) {
+    uint32_t changes = 0;
+
+    if (before.id != after.id || before.uri != after.uri || before.title != after.title ||
+        before.artist != after.artist || before.album != after.album ||
+        before.coverUrl != after.coverUrl || before.durationMs != after.durationMs ||
+        before.explicitContent != after.explicitContent) {
+        changes |= CHANGED_TRACK;
+    }
+    if (before.isPlaying != after.isPlaying) {
+        changes |= CHANGED_PLAYING;
+    }
+    if (before.saved != after.saved) {
+        changes |= CHANGED_SAVED;
+    }
+
+    return changes;
+}
+
+bool SpotifyClient::fetchSavedTracks() {
+    if (!ensureValidToken()) {
         return false;
     }
 
-    // Use AuthManager to refresh token
-    if (authManager) {
-        String newAccess = authManager->refreshAccessToken(refreshToken);
-        if (!newAccess.isEmpty()) {
-            accessToken = newAccess;
-            tokenExpiryTime = millis() + 3600000;
-            Serial.println("✅ Token refreshed");
-            return true;
+    bool ok = true;
+    std::vector<SpotifyId> batch;
+    while (!(batch = savedTracks.takeBatch()).empty()) {
+        RequestBuilder request(SPOTIFY_API_BASE, "/me/tracks/contains?ids=");
+        for (size_t i = 0; i < batch.size(); i++) {
+            request.path(i > 0 ? ",%s" : "%s", batch[i].c_str());
+        }
+
+        // Response is a bare array of booleans in request order
+        StaticJsonDocument<JSON_ARRAY_SIZE(SAVED_LOOKUP_BATCH_SIZE)> doc;
+        if (!httpGet(request, doc, 200)) {
+            ok = false;
+            continue;
+        }
+
+        JsonArray results = doc.as<JsonArray>();
+        for (size_t i = 0; i < batch.size() && i < results.size(); i++) {
+            savedTracks.set(batch[i], results[i].as<bool>());
         }
     }
 
-    return false;
+    return ok;
+}
+
+void SpotifyClient::storeSavedState(const SpotifyId& trackId, bool saved) {
+    savedTracks.set(trackId, saved);
+
+    // Runs on the worker, the UI picks the change up on its next update
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (currentTrack.id == trackId && currentTrack.saved != saved) {
+        currentTrack.saved = saved;
+        markChanged(CHANGED_SAVED);
+    }
+}
+
+unsigned long SpotifyClient::estimateSampleTime(int64_t timestamp) const {
+    // Without a synced clock assume the server sampled half way through the request
+    unsigned long sampledAt = lastResponseTime - lastRequestLatency / 2;
+
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    if (timestamp <= 0 || tv.tv_sec < SPOTIFY_CLOCK_VALID_EPOCH) {
+        return sampledAt;
+    }
+
+    // The timestamp is sometimes the time of the last state change rather
+    // than of the response, so only trust it inside the request window
+    int64_t nowEpochMs = static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+    int64_t ageMs = nowEpochMs - timestamp;
+    unsigned long now = millis();
+    unsigned long requestStart = lastResponseTime - lastRequestLatency;
+
+    if (ageMs >= 0 && ageMs <= static_cast<int64_t>(now - requestStart)) {
+        sampledAt = now - static_cast<unsigned long>(ageMs);
+    }
+
+    return sampledAt;
 }
 
 SpotifyClient::TrackInfo SpotifyClient::parseTrack(JsonObject trackJson) {
@@ -492,22 +1477,22 @@ SpotifyClient::TrackInfo SpotifyClient::parseTrack(JsonObject trackJson) {
         if (album.containsKey("images") && album["images"].size() > 0) {
             // Get largest image
             int maxSize = 0;
-            for (JsonObject img : album["images"]) {
+            for (JsonObject img : album["images"].as<JsonArray>()) {
                 int size = img["width"] | 0;
                 if (size > maxSize) {
                     maxSize = size;
-                    track.coverUrl = img["url"] | "";
-                    track.coverUrlLarge = img["url"] | "";
+                    assignUrl(track.coverUrl, img["url"] | "");
+                    assignUrl(track.coverUrlLarge, img["url"] | "");
                 }
             }
 
             // Get smallest image (for thumbnails)
             int minSize = 999999;
-            for (JsonObject img : album["images"]) {
+            for (JsonObject img : album["images"].as<JsonArray>()) {
                 int size = img["width"] | 0;
                 if (size > 0 && size < minSize) {
                     minSize = size;
-                    track.coverUrlSmall = img["url"] | "";
+                    assignUrl(track.coverUrlSmall, img["url"] | "");
                 }
             }
         }
@@ -532,8 +1517,105 @@ SpotifyClient::PlaylistInfo SpotifyClient::parsePlaylist(JsonObject playlistJson
 
     // Cover image
     if (playlistJson.containsKey("images") && playlistJson["images"].size() > 0) {
-        playlist.coverUrl = playlistJson["images"][0]["url"] | "";
+        assignUrl(playlist.coverUrl, playlistJson["images"][0]["url"] | "");
     }
 
     return playlist;
 }
+
+SpotifyClient::RepeatMode SpotifyClient::parseRepeatMode(const char* state) {
+    if (strcmp(state, "track") == 0) {
+        return RepeatMode::TRACK;
+    }
+    if (strcmp(state, "context") == 0) {
+        return RepeatMode::CONTEXT;
+    }
+    return RepeatMode::OFF;
+}
+
+void SpotifyClient::addTrackFilter(JsonObject filter) {
+    filter["id"] = true;
+    filter["uri"] = true;
+    filter["name"] = true;
+    filter["duration_ms"] = true;
+    filter["explicit"] = true;
+    filter["artists"][0]["name"] = true;
+
+    JsonObject album = filter.createNestedObject("album");
+    album["id"] = true;
+    album["name"] = true;
+    album["images"][0]["url"] = true;
+    album["images"][0]["width"] = true;
+}
+
+void SpotifyClient::addPlaylistFilter(JsonObject filter) {
+    filter["id"] = true;
+    filter["uri"] = true;
+    filter["name"] = true;
+    filter["collaborative"] = true;
+    filter["tracks"]["total"] = true;
+    filter["owner"]["id"] = true;
+    filter["images"][0]["url"] = true;
+}
+
+// Filters are static so they are built once instead of on every poll.
+// An array in a filter applies its first element to all elements.
+
+const JsonDocument& SpotifyClient::playerFilter() {
+    static StaticJsonDocument<1024> filter;
+    if (filter.isNull()) {
+        filter["is_playing"] = true;
+        filter["progress_ms"] = true;
+        filter["timestamp"] = true;
+        filter["shuffle_state"] = true;
+        filter["repeat_state"] = true;
+        filter["context"]["uri"] = true;
+        filter["context"]["type"] = true;
+        filter["device"]["id"] = true;
+        filter["device"]["name"] = true;
+        filter["device"]["type"] = true;
+        filter["device"]["is_active"] = true;
+        filter["device"]["volume_percent"] = true;
+        addTrackFilter(filter.createNestedObject("item"));
+    }
+    return filter;
+}
+
+const JsonDocument& SpotifyClient::playlistsFilter() {
+    static StaticJsonDocument<512> filter;
+    if (filter.isNull()) {
+        addPlaylistFilter(filter["items"].createNestedObject());
+        filter["offset"] = true;
+        filter["total"] = true;
+        filter["next"] = true;
+    }
+    return filter;
+}
+
+const JsonDocument& SpotifyClient::playlistFilter() {
+    static StaticJsonDocument<512> filter;
+    if (filter.isNull()) {
+        addPlaylistFilter(filter.to<JsonObject>());
+    }
+    return filter;
+}
+
+const JsonDocument& SpotifyClient::searchFilter() {
+    static StaticJsonDocument<1536> filter;
+    if (filter.isNull()) {
+        addTrackFilter(filter["tracks"]["items"].createNestedObject());
+        addPlaylistFilter(filter["playlists"]["items"].createNestedObject());
+        filter["tracks"]["next"] = true;
+        filter["playlists"]["next"] = true;
+    }
+    return filter;
+}
+
+const JsonDocument& SpotifyClient::queueFilter() {
+    static StaticJsonDocument<1024> filter;
+    if (filter.isNull()) {
+        filter["currently_playing"]["id"] = true;
+        addTrackFilter(filter["queue"].createNestedObject());
+    }
+    return filter;
+}
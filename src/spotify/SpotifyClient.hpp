@@ -11,13 +11,28 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include <WiFiClientSecure.h>
-#include <HTTPClient.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "AuthManager.hpp"
-
-// Spotify API endpoints
+#include "PollScheduler.hpp"
+#include "PlaybackClock.hpp"
+#include "CoalescedCommand.hpp"
+#include "SavedTrackCache.hpp"
+#include "SpotifyId.hpp"
+#include "../app/EventBus.hpp"
+#include "../network/HttpTransport.hpp"
+#include "../network/CircuitBreakerTransport.hpp"
+#include "../network/RateLimiter.hpp"
+#include "../network/RequestBuilder.hpp"
+
+// Spotify API endpoints (override with -D to point at a local stand-in server)
+#ifndef SPOTIFY_API_BASE
 #define SPOTIFY_API_BASE "https://api.spotify.com/v1"
+#endif
+#ifndef SPOTIFY_TOKEN_URL
 #define SPOTIFY_TOKEN_URL "https://accounts.spotify.com/api/token"
+#endif
 
 // OAuth scopes
 #define SPOTIFY_SCOPES \
@@ -30,11 +45,102 @@
     "playlist-read-private " \
     "playlist-read-collaborative"
 
-// Poll interval for now playing updates
-#define SPOTIFY_POLL_INTERVAL_MS 2000
+// Page size for playlist requests (Spotify maximum)
+#define SPOTIFY_PLAYLIST_LIMIT 50
+
+// Upcoming tracks (/me/player/queue)
+#define SPOTIFY_QUEUE_LENGTH 20                // Most items Spotify returns
+#define SPOTIFY_QUEUE_PREFETCH 2               // Kept for the next track changes
+#define SPOTIFY_QUEUE_FETCH_DELAY_MS 2000      // After a track change, polls and commands go first
+#define SPOTIFY_QUEUE_RETRY_MS 10000           // After a failed fetch
+
+// JSON document capacities for the filtered responses
+// (strings are copied from the stream, so they are included)
+#define SPOTIFY_TRACK_JSON_SIZE \
+    (JSON_OBJECT_SIZE(7) + JSON_ARRAY_SIZE(4) + 4 * JSON_OBJECT_SIZE(1) + \
+     JSON_OBJECT_SIZE(3) + JSON_ARRAY_SIZE(3) + 3 * JSON_OBJECT_SIZE(2) + 768)
+#define SPOTIFY_PLAYLIST_JSON_SIZE \
+    (JSON_OBJECT_SIZE(7) + 2 * JSON_OBJECT_SIZE(1) + \
+     JSON_ARRAY_SIZE(3) + 3 * JSON_OBJECT_SIZE(1) + 768)
+#define SPOTIFY_PLAYER_JSON_SIZE \
+    (JSON_OBJECT_SIZE(8) + JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(2) + 256 + \
+     SPOTIFY_TRACK_JSON_SIZE)
+#define SPOTIFY_PLAYLISTS_JSON_SIZE(limit) \
+    (JSON_OBJECT_SIZE(4) + JSON_ARRAY_SIZE(limit) + 256 + \
+     (limit) * SPOTIFY_PLAYLIST_JSON_SIZE)
+#define SPOTIFY_SEARCH_JSON_SIZE(limit) \
+    (JSON_OBJECT_SIZE(2) + 2 * JSON_OBJECT_SIZE(2) + 2 * JSON_ARRAY_SIZE(limit) + 512 + \
+     (limit) * (SPOTIFY_TRACK_JSON_SIZE + SPOTIFY_PLAYLIST_JSON_SIZE))
+#define SPOTIFY_QUEUE_JSON_SIZE \
+    (JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(1) + 64 + \
+     JSON_ARRAY_SIZE(SPOTIFY_QUEUE_LENGTH) + SPOTIFY_QUEUE_LENGTH * SPOTIFY_TRACK_JSON_SIZE)
+
+// Access token refresh (runs in the background before the token expires)
+#define SPOTIFY_TOKEN_REFRESH_MARGIN_MS 300000
+#define SPOTIFY_TOKEN_RETRY_MS 30000           // After a failed refresh
+#define SPOTIFY_TOKEN_DEFAULT_LIFETIME_MS 3600000
+
+// Inline string capacities of TrackInfo/PlaylistInfo/DeviceInfo (longer
+// text is cut off, longer URLs are dropped)
+#define SPOTIFY_URI_LENGTH 47
+#define SPOTIFY_NAME_LENGTH 127            // Track, album and playlist names
+#define SPOTIFY_ARTIST_LENGTH 95
+#define SPOTIFY_USER_ID_LENGTH 63
+#define SPOTIFY_IMAGE_URL_LENGTH 95        // https://i.scdn.co/image/<40 hex>
+#define SPOTIFY_MOSAIC_URL_LENGTH 191      // Playlist covers made of 4 album covers
+#define SPOTIFY_DEVICE_ID_LENGTH 47
+#define SPOTIFY_DEVICE_NAME_LENGTH 63
+#define SPOTIFY_DEVICE_TYPE_LENGTH 23
+#define SPOTIFY_CONTEXT_TYPE_LENGTH 15     // "playlist", "album", "artist", ...
+
+// getCurrentTrack() copies a TrackInfo on every loop, raise with care
+#define SPOTIFY_TRACK_INFO_MAX_SIZE 800
+
+// "Bearer <token>", copied onto the stack for every request
+#define SPOTIFY_AUTHORIZATION_LENGTH 511
+
+// A polled position this far from the predicted one counts as a seek
+#define SPOTIFY_PROGRESS_JUMP_MS 1500
+
+// Polls don't override optimistic state for this long after a command
+#define SPOTIFY_OPTIMISTIC_HOLD_MS 1500
+
+// Polls still reporting the old track don't undo a switch at the
+// predicted track end for this long
+#define SPOTIFY_TRACK_END_HOLD_MS 3000
+
+// Count heap allocations of command requests (needs the native heap counters)
+#ifndef SPOTIFY_COUNT_ALLOCS
+#ifdef NATIVE_BUILD
+#define SPOTIFY_COUNT_ALLOCS 1
+#else
+#define SPOTIFY_COUNT_ALLOCS 0
+#endif
+#endif
+
+// Wall clock is considered set (SNTP) after this epoch time
+#define SPOTIFY_CLOCK_VALID_EPOCH 1600000000
+
+// Log response size, parse time and document usage for every JSON response
+#ifndef SPOTIFY_LOG_PARSE
+#ifdef NATIVE_BUILD
+#define SPOTIFY_LOG_PARSE 1
+#else
+#define SPOTIFY_LOG_PARSE 0
+#endif
+#endif
+
+// Image downloads (640 px covers are 50-150 KB)
+#define SPOTIFY_IMAGE_MAX_BYTES 262144     // Larger images are refused
+#define SPOTIFY_IMAGE_CHUNK_SIZE 1024      // Read from the connection and written at a time
+#define SPOTIFY_IMAGE_PATH_LENGTH 63
 
 /**
  * @brief Spotify Client Class
+ *
+ * Methods that talk to the API block until the request completes, so
+ * they are run on the RequestQueue worker. Getters can be used from the
+ * loop task at any time.
  */
 class SpotifyClient {
 public:
@@ -42,15 +148,15 @@ public:
      * @brief Track information structure
      */
     struct TrackInfo {
-        String id;
-        String uri;
-        String title;
-        String artist;
-        String album;
-        String albumId;
-        String coverUrl;
-        String coverUrlSmall;
-        String coverUrlLarge;
+        SpotifyId id;
+        FixedString<SPOTIFY_URI_LENGTH> uri;
+        FixedString<SPOTIFY_NAME_LENGTH> title;
+        FixedString<SPOTIFY_ARTIST_LENGTH> artist;
+        FixedString<SPOTIFY_NAME_LENGTH> album;
+        SpotifyId albumId;
+        FixedString<SPOTIFY_IMAGE_URL_LENGTH> coverUrl;
+        FixedString<SPOTIFY_IMAGE_URL_LENGTH> coverUrlSmall;
+        FixedString<SPOTIFY_IMAGE_URL_LENGTH> coverUrlLarge;
 
         bool isPlaying;
         int progressMs;
@@ -71,31 +177,130 @@ public:
         }
     };
 
+    static_assert(sizeof(TrackInfo) <= SPOTIFY_TRACK_INFO_MAX_SIZE,
+                  "TrackInfo exceeds SPOTIFY_TRACK_INFO_MAX_SIZE");
+
     /**
      * @brief Playlist information structure
      */
     struct PlaylistInfo {
-        String id;
-        String uri;
-        String name;
-        String owner;
-        String coverUrl;
+        SpotifyId id;
+        FixedString<SPOTIFY_URI_LENGTH> uri;
+        FixedString<SPOTIFY_NAME_LENGTH> name;
+        FixedString<SPOTIFY_USER_ID_LENGTH> owner;
+        FixedString<SPOTIFY_MOSAIC_URL_LENGTH> coverUrl;
         int trackCount;
         bool isCollaborative;
     };
 
+    /**
+     * @brief One page of the user's playlists
+     */
+    struct PlaylistPage {
+        std::vector<PlaylistInfo> items;
+        int offset;
+        int total;
+        bool hasNext;   // Spotify returned a "next" page
+
+        PlaylistPage()
+            : offset(0)
+            , total(0)
+            , hasNext(false) {
+        }
+    };
+
     /**
      * @brief Device information structure
      */
     struct DeviceInfo {
-        String id;
-        String name;
-        String type;
+        FixedString<SPOTIFY_DEVICE_ID_LENGTH> id;
+        FixedString<SPOTIFY_DEVICE_NAME_LENGTH> name;
+        FixedString<SPOTIFY_DEVICE_TYPE_LENGTH> type;
         bool isActive;
         int volumePercent;
+
+        DeviceInfo()
+            : isActive(false)
+            , volumePercent(50) {
+        }
+    };
+
+    /**
+     * @brief What the current track is played from
+     */
+    struct ContextInfo {
+        FixedString<SPOTIFY_URI_LENGTH> uri;    // Empty if Spotify doesn't say (or too long)
+        FixedString<SPOTIFY_CONTEXT_TYPE_LENGTH> type;
+    };
+
+    /**
+     * @brief Repeat mode of the player
+     */
+    enum class RepeatMode : uint8_t {
+        OFF,
+        CONTEXT,    // Repeat the playlist/album
+        TRACK
     };
 
-    SpotifyClient(AuthManager* auth);
+    /**
+     * @brief Parts of the playback state that changed (bitmask)
+     *
+     * Passed as Event::intValue of TRACK_CHANGED and PLAYBACK_CHANGED.
+     */
+    enum StateChange : uint32_t {
+        CHANGED_TRACK = 1 << 0,      // Other track, or its metadata
+        CHANGED_PLAYING = 1 << 1,
+        CHANGED_PROGRESS = 1 << 2,   // Position jumped (seek), not regular playback
+        CHANGED_SAVED = 1 << 3,
+        CHANGED_SKIP = 1 << 4,       // Skip started or finished
+        CHANGED_VOLUME = 1 << 5,
+        CHANGED_DEVICE = 1 << 6,
+        CHANGED_QUEUE = 1 << 7,      // Upcoming tracks (getUpcomingTrack())
+        CHANGED_MODE = 1 << 8,       // Shuffle or repeat
+        CHANGED_CONTEXT = 1 << 9,
+        CHANGED_ALL = 0x3FF
+    };
+
+    /**
+     * @brief Playback state without the track strings
+     */
+    struct PlaybackSnapshot {
+        bool isPlaying;
+        bool saved;
+        bool skipPending;
+        bool shuffle;
+        RepeatMode repeat;
+        int progressMs;
+        int durationMs;
+        int volumePercent;
+        uint32_t generation;    // getStateGeneration() when taken
+    };
+
+    /**
+     * @brief Heap allocations of PUT/POST/DELETE requests (SPOTIFY_COUNT_ALLOCS)
+     */
+    struct AllocStats {
+        uint32_t requests;
+        uint32_t clientAllocs;      // Made by SpotifyClient building the request
+        uint32_t totalAllocs;       // Including HTTPClient and TLS
+        uint32_t lastClientAllocs;
+        uint32_t lastTotalAllocs;
+
+        AllocStats()
+            : requests(0)
+            , clientAllocs(0)
+            , totalAllocs(0)
+            , lastClientAllocs(0)
+            , lastTotalAllocs(0) {
+        }
+    };
+
+    /**
+     * @param auth Used to refresh the access token
+     * @param transport Where requests go, HttpsTransport if nullptr. Wrapped
+     *                  in a circuit breaker per host.
+     */
+    SpotifyClient(AuthManager* auth, HttpTransport* transport = nullptr);
     ~SpotifyClient();
 
     /**
@@ -103,28 +308,79 @@ public:
      */
     void init();
 
+    /**
+     * @brief Set the bus state changes are published on
+     */
+    void setEventBus(EventBus* bus) { eventBus = bus; }
+
     /**
      * @brief Set access and refresh tokens
+     * @param expiresInMs Access token lifetime, 0 if unknown (stored tokens),
+     *                    which refreshes it right away in the background
+     */
+    void setTokens(const String& accessToken, const String& refreshToken,
+                   unsigned long expiresInMs = 0);
+
+    /**
+     * @brief Publish state changes and queue background work that is due,
+     *        like the token refresh and the queue fetch (call from the loop)
+     *
+     * Also moves on to the next queued track once the current one has
+     * played to its end, without waiting for the poll, and publishes
+     * SPOTIFY_UNREACHABLE/SPOTIFY_REACHABLE when the API goes down or
+     * comes back.
+     */
+    void update();
+
+    /**
+     * @brief Check if the API answers (its circuit is closed)
+     *
+     * While it doesn't, requests fail without being sent and UI commands
+     * are dropped, publishing SPOTIFY_UNREACHABLE again.
      */
-    void setTokens(const String& accessToken, const String& refreshToken);
+    bool isApiReachable() const {
+        return breaker.getState(SPOTIFY_API_BASE) == CircuitState::CLOSED;
+    }
+
+    /**
+     * @brief Try all hosts again right away (e.g. after WiFi reconnected)
+     */
+    void resetCircuits() { breaker.reset(); }
+
+    /**
+     * @brief Get circuit breaker counters
+     */
+    CircuitBreakerTransport::Stats getCircuitStats() const { return breaker.getStats(); }
 
     /**
      * @brief Get access token
      */
-    String getAccessToken() const { return accessToken; }
+    String getAccessToken() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return accessToken;
+    }
 
     /**
      * @brief Get refresh token
      */
-    String getRefreshToken() const { return refreshToken; }
+    String getRefreshToken() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return refreshToken;
+    }
 
     /**
      * @brief Check if authenticated
      */
-    bool isAuthenticated() const { return !accessToken.isEmpty(); }
+    bool isAuthenticated() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return !accessToken.isEmpty();
+    }
 
     /**
-     * @brief Update now playing info
+     * @brief Fetch the player state
+     *
+     * One /me/player request fills in the track, device, volume,
+     * shuffle/repeat and context.
      * @return true if successful
      */
     bool updateNowPlaying();
@@ -132,7 +388,80 @@ public:
     /**
      * @brief Get current track info
      */
-    TrackInfo getCurrentTrack() const { return currentTrack; }
+    TrackInfo getCurrentTrack() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return currentTrack;
+    }
+
+    /**
+     * @brief Fetch the tracks after the current one (/me/player/queue)
+     *
+     * Queued by update() at background priority after every track change.
+     * @return true if successful
+     */
+    bool updateQueue();
+
+    /**
+     * @brief Get an upcoming track
+     * @param index 0 for the next track, up to SPOTIFY_QUEUE_PREFETCH - 1
+     * @return false if it isn't known (yet)
+     */
+    bool getUpcomingTrack(size_t index, TrackInfo& track) const;
+
+    /**
+     * @brief Get what the current track is played from
+     */
+    ContextInfo getContext() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return currentContext;
+    }
+
+    /**
+     * @brief Get the playback state (cheaper than getCurrentTrack())
+     */
+    PlaybackSnapshot getPlaybackSnapshot() const;
+
+    /**
+     * @brief Get the state generation
+     *
+     * Incremented whenever the playback state changes, so a caller can
+     * tell if it missed a change without comparing the state.
+     */
+    uint32_t getStateGeneration() const { return stateGeneration; }
+
+    /**
+     * @brief Get the playback position, advanced locally since the last poll
+     */
+    int getProgressMs() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return playbackClock.getProgressMs();
+    }
+
+    /**
+     * @brief Check if a skip was requested and the new track isn't known yet
+     */
+    bool isSkipPending() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return skipPending;
+    }
+
+    /**
+     * @brief Check if it's time to call updateNowPlaying()
+     * @param screenIdle Nobody is looking at the screen, poll less often
+     */
+    bool isPollDue(bool screenIdle);
+
+    /**
+     * @brief Playback commands from the UI
+     *
+     * The expected state is applied and published right away, the request
+     * runs in the background. A failed request rolls the state back.
+     * While the API is unreachable nothing is applied or sent.
+     * Call from the loop task.
+     */
+    void requestTogglePlay();
+    void requestNextTrack();
+    void requestPreviousTrack();
 
     // Playback controls
     bool play();
@@ -145,20 +474,79 @@ public:
     // Volume control
     bool setVolume(int volumePercent);
     bool adjustVolume(int delta);
+
+    /**
+     * @brief Fetch the player state and return the volume
+     *
+     * Costs the same single request as a poll. The poll keeps the volume
+     * current, use getPlaybackSnapshot() rather than calling this.
+     */
     int getVolume();
 
+    /**
+     * @brief Queue a volume/seek change from the UI
+     *
+     * Latest value wins: repeated calls while a request is pending only
+     * update the value it sends. Dropped while the API is unreachable.
+     * Call from the loop task.
+     */
+    void queueVolume(int volumePercent);
+    void queueVolumeChange(int delta);
+    void queueSeek(int positionMs);
+
+    /**
+     * @brief Get coalescing statistics
+     */
+    CoalescedCommand::Stats getVolumeStats() const { return volumeCommand.getStats(); }
+    CoalescedCommand::Stats getSeekStats() const { return seekCommand.getStats(); }
+
+    /**
+     * @brief Get throttled/deferred request counters
+     */
+    RateLimiter::Stats getRateLimitStats() const { return rateLimiter.getStats(); }
+
+    /**
+     * @brief Get request allocation counters
+     */
+    AllocStats getAllocStats() const {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return allocStats;
+    }
+
     // Track management
     bool saveTrack(const String& trackId);
     bool removeTrack(const String& trackId);
     bool isTrackSaved(const String& trackId);
 
+    /**
+     * @brief Fill in TrackInfo::saved for a list of tracks
+     *
+     * Tracks not in the cache are looked up 50 per request.
+     */
+    void fillSavedState(std::vector<TrackInfo>& tracks);
+
+    /**
+     * @brief Get the cached saved state without a request (safe from the loop task)
+     */
+    SavedState getSavedState(const String& trackId) const {
+        return savedTracks.get(trackId);
+    }
+
     // Device management
     std::vector<DeviceInfo> getDevices();
     bool setDevice(const String& deviceId);
     DeviceInfo getCurrentDevice();
 
     // Playlists
-    std::vector<PlaylistInfo> getPlaylists();
+
+    /**
+     * @brief Get one page of the user's playlists
+     *
+     * Use PlaylistCursor to browse the whole library.
+     * @return false if the request failed
+     */
+    bool getPlaylists(PlaylistPage& page, int offset = 0, int limit = SPOTIFY_PLAYLIST_LIMIT);
+
     PlaylistInfo getPlaylist(const String& playlistId);
     bool playPlaylist(const String& playlistId, const String& deviceId = "");
     bool playTrack(const String& trackUri, const String& deviceId = "");
@@ -167,38 +555,201 @@ public:
     struct SearchResult {
         std::vector<TrackInfo> tracks;
         std::vector<PlaylistInfo> playlists;
+        bool hasMore;   // Another page of tracks or playlists exists
+
+        SearchResult()
+            : hasMore(false) {
+        }
     };
-    SearchResult search(const String& query, int limit = 20);
 
-    // Image loading
-    bool downloadImage(const String& url, const String& path);
+    /**
+     * @brief Search tracks and playlists
+     *
+     * Use SearchEngine for type-ahead search from the UI.
+     * @param limit Results per type
+     * @param offset Index of the first result (for further pages)
+     */
+    SearchResult search(const String& query, int limit = 20, int offset = 0);
+
+    /**
+     * @brief Download an image into a LittleFS file
+     *
+     * The body is copied to flash in SPOTIFY_IMAGE_CHUNK_SIZE pieces, so
+     * the image is never held in RAM. It is written to "<path>.tmp" first
+     * and only renamed to path when complete. Doesn't use the API rate
+     * limit (images come from the CDN). Blocks, use from the request worker.
+     * @param cancelled Checked between chunks, the download is dropped
+     *                  when it returns true
+     * @return true if the complete image is at path
+     */
+    bool downloadImage(const char* url, const char* path,
+                       const std::function<bool()>& cancelled = nullptr);
 
 private:
+    using AuthorizationHeader = FixedString<SPOTIFY_AUTHORIZATION_LENGTH>;
+
     /**
      * @brief Make authenticated HTTP GET request
+     *
+     * The response is parsed straight from the connection. With a filter,
+     * only the fields present in the filter are stored in the document.
+     * Fails if the document is too small for the response.
      */
-    bool httpGet(const String& endpoint, JsonDocument& doc, int expectedCode = 200);
+    bool httpGet(const RequestBuilder& request, JsonDocument& doc, int expectedCode = 200,
+                 const JsonDocument* filter = nullptr);
 
     /**
      * @brief Make authenticated HTTP PUT request
      */
-    bool httpPut(const String& endpoint, const String& body = "", int expectedCode = 204);
+    bool httpPut(const RequestBuilder& request, int expectedCode = 204);
 
     /**
      * @brief Make authenticated HTTP POST request
      */
-    bool httpPost(const String& endpoint, const String& body = "", int expectedCode = 201);
+    bool httpPost(const RequestBuilder& request, int expectedCode = 201);
 
     /**
      * @brief Make authenticated HTTP DELETE request
      */
-    bool httpDelete(const String& endpoint, int expectedCode = 200);
+    bool httpDelete(const RequestBuilder& request, int expectedCode = 200);
+
+    /**
+     * @brief Make authenticated HTTP request without a JSON response
+     */
+    bool httpSend(const char* method, const RequestBuilder& request, int expectedCode);
+
+    /**
+     * @brief Set the cached Authorization header on a request
+     *
+     * The header is copied into the caller's buffer, a token refresh on
+     * another task can't replace it while the request is sent.
+     * @param header Holds the header until the request is sent
+     * @param generation Set to the token generation, for onUnauthorized()
+     */
+    void addAuthorization(HttpRequest& request, AuthorizationHeader& header,
+                          uint32_t& generation) const;
+
+    /**
+     * @brief Wait for the rate limiter before sending a request
+     *
+     * Uses the priority of the queued request this runs in.
+     * @return false with lastHttpCode HTTPC_ERROR_DEFERRED for a background
+     *         request that was held back, 429 for a user request
+     */
+    bool acquireRequestSlot();
+
+    /**
+     * @brief Pause requests for the Retry-After of a 429 response
+     */
+    void onRateLimited(HttpResponse& response);
 
     /**
-     * @brief Refresh access token if needed
+     * @brief Check that there is a token that hasn't expired
+     *
+     * Only refreshes (or waits for the running refresh) if the background
+     * refresh didn't get to it in time.
      */
     bool ensureValidToken();
 
+    /**
+     * @brief Refresh the access token using the refresh token
+     *
+     * Single flight: a caller arriving during a refresh waits for it and
+     * gets its result instead of starting another one.
+     */
+    bool refreshAccessToken();
+
+    /**
+     * @brief Handle a 401 response
+     *
+     * Refreshes only if the rejected token is still the current one, so a
+     * burst of 401s costs one refresh.
+     */
+    void onUnauthorized(uint32_t generation);
+
+    /**
+     * @brief Queue a command applied optimistically
+     * @param request Runs on the worker
+     * @param rollback Undoes the optimistic change if the request fails
+     *                 (called with stateMutex held)
+     */
+    void runCommand(std::function<bool()> request, std::function<void()> rollback);
+
+    /**
+     * @brief Roll back a failed command and let the next poll correct the rest
+     * @param rollback Undoes the optimistic change (called with stateMutex held)
+     */
+    void rollbackCommand(const std::function<void()>& rollback);
+
+    /**
+     * @brief Request skipping to the next or previous track
+     */
+    void requestSkip(bool forward);
+
+    /**
+     * @brief Drop a UI command while the API circuit is open
+     * @return true if the command must not be applied (loop task)
+     */
+    bool rejectWhileUnreachable();
+
+    /**
+     * @brief Check if polls should leave optimistic state alone
+     *        (stateMutex held)
+     */
+    bool isHoldingOptimisticState() const;
+
+    /**
+     * @brief Switch to the next queued track if the current one ended
+     *        (stateMutex held)
+     */
+    void advanceAtTrackEnd();
+
+    /**
+     * @brief Queue updateQueue() if the queue is stale and nothing more
+     *        urgent is going on (loop task)
+     */
+    void scheduleQueueFetch();
+
+    /**
+     * @brief Publish an event on the loop task (no-op without a bus)
+     */
+    void publish(const Event& event);
+
+    /**
+     * @brief Record changed state, published by the next update()
+     *        (stateMutex held)
+     */
+    void markChanged(uint32_t changes);
+
+    /**
+     * @brief Publish the events for the changes recorded since the last call
+     *        (loop task)
+     */
+    void publishChanges();
+
+    /**
+     * @brief Compare two tracks field by field
+     * @return StateChange bits of the fields that differ
+     */
+    static uint32_t diffTrack(const TrackInfo& before, const TrackInfo& after);
+
+    /**
+     * @brief Look up all queued ids in the saved track cache
+     * @return false if a request failed
+     */
+    bool fetchSavedTracks();
+
+    /**
+     * @brief Record a save/remove in the cache and the current track
+     */
+    void storeSavedState(const SpotifyId& trackId, bool saved);
+
+    /**
+     * @brief Estimate the millis() at which the last response was current
+     * @param timestamp Response timestamp (Unix ms), 0 if missing
+     */
+    unsigned long estimateSampleTime(int64_t timestamp) const;
+
     /**
      * @brief Parse track from JSON
      */
@@ -209,21 +760,97 @@ private:
      */
     PlaylistInfo parsePlaylist(JsonObject playlistJson);
 
+    /**
+     * @brief Parse repeat_state ("off", "context" or "track")
+     */
+    static RepeatMode parseRepeatMode(const char* state);
+
+    /**
+     * @brief Add the fields read by parseTrack() to a filter
+     */
+    static void addTrackFilter(JsonObject filter);
+
+    /**
+     * @brief Add the fields read by parsePlaylist() to a filter
+     */
+    static void addPlaylistFilter(JsonObject filter);
+
+    // Response filters (built once)
+    static const JsonDocument& playerFilter();
+    static const JsonDocument& playlistsFilter();
+    static const JsonDocument& playlistFilter();
+    static const JsonDocument& searchFilter();
+    static const JsonDocument& queueFilter();
+
     // Auth manager
     AuthManager* authManager;
 
     // Tokens
     String accessToken;
     String refreshToken;
+    String authorizationHeader;         // "Bearer <token>", rebuilt when the token changes
     unsigned long tokenExpiryTime;
-
-    // HTTP client
-    WiFiClientSecure client;
-    HTTPClient http;
+    unsigned long tokenRefreshTime;     // When the background refresh is due
+    uint32_t tokenGeneration;           // Incremented with every new access token
+    bool refreshing;
+    bool refreshSucceeded;              // Result of the last refresh, for waiting callers
+    bool refreshQueued;
+    std::condition_variable refreshDone;
+
+    // HTTP
+    CircuitBreakerTransport breaker;    // Around the transport passed in
+    HttpTransport* transport;           // The breaker
+    int lastHttpCode;
+    unsigned long lastResponseTime;     // millis() when the response headers arrived
+    unsigned long lastRequestLatency;   // Request sent until response headers (ms)
+    RateLimiter rateLimiter;
+    AllocStats allocStats;
+
+    // Guards tokens and current state, which the loop task reads while
+    // requests run on the worker
+    mutable std::mutex stateMutex;
 
     // Current state
     TrackInfo currentTrack;
     DeviceInfo currentDevice;
+    ContextInfo currentContext;
+    bool shuffleState;
+    RepeatMode repeatMode;
+
+    // Now playing polling
+    PollScheduler pollScheduler;
+    PlaybackClock playbackClock;
+
+    // Upcoming tracks
+    TrackInfo upcoming[SPOTIFY_QUEUE_PREFETCH];
+    size_t upcomingCount;
+    SpotifyId upcomingAfterId;          // Track the queue was fetched for
+    bool queueStale;
+    bool queueInFlight;
+    unsigned long queueDueTime;
+    SpotifyId predictedFromTrackId;     // Left at its predicted end, until a poll agrees
+    unsigned long predictedTime;
+
+    // Saved ("liked") state per track
+    SavedTrackCache savedTracks;
+
+    // Coalesced UI commands
+    CoalescedCommand volumeCommand;
+    CoalescedCommand seekCommand;
+    int volumeBeforeCommand;            // Confirmed volume when the interaction began
+
+    // Change tracking (written on either task, published on the loop)
+    EventBus* eventBus;
+    bool apiReachable;                  // Last published availability
+    uint32_t pendingChanges;
+    std::atomic<uint32_t> stateGeneration;
+    uint32_t publishedGeneration;
+
+    // Optimistic state
+    uint32_t commandsInFlight;
+    unsigned long lastCommandTime;
+    bool skipPending;
+    SpotifyId skipFromTrackId;
 
     // State tracking
     bool initialized;
@@ -0,0 +1,19 @@
+/**
+ * @file SpotifyId.hpp
+ * @brief Spotify ID Type
+ *
+ * Track, album and playlist ids held inline, for the caches and screens
+ * that key on them.
+ */
+
+#ifndef SPOTIFY_ID_HPP
+#define SPOTIFY_ID_HPP
+
+#include "../utils/FixedString.hpp"
+
+// Spotify ids are 22 base62 characters
+#define SPOTIFY_ID_LENGTH 22
+
+using SpotifyId = FixedString<SPOTIFY_ID_LENGTH>;
+
+#endif // SPOTIFY_ID_HPP
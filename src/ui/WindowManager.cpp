@@ -7,6 +7,7 @@
 #include "screens/NowPlaying.hpp"
 #include "screens/Auth.hpp"
 #include "screens/Settings.hpp"
+#include "../display/themes/SpotifyTheme.hpp"
 
 WindowManager::WindowManager(DisplayManager* dm)
     : displayManager(dm)
@@ -32,8 +33,7 @@ void WindowManager::init() {
     Serial.println("🖼  Initializing WindowManager...");
 
     // Apply theme
-    extern void spotify_theme_apply();
-    spotify_theme_apply();
+    SpotifyTheme::apply();
 
     // Create root object
     root = lv_obj_create(NULL);
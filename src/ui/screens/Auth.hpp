@@ -8,6 +8,7 @@
 #ifndef AUTH_SCREEN_HPP
 #define AUTH_SCREEN_HPP
 
+#include <Arduino.h>
 #include <lvgl.h>
 
 namespace ui {
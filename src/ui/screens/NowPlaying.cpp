@@ -4,14 +4,18 @@
  */
 
 #include "NowPlaying.hpp"
-#include "../display/themes/SpotifyTheme.hpp"
-#include "../spotify/SpotifyClient.hpp"
+#include "../../display/themes/SpotifyTheme.hpp"
+#include "../../spotify/SpotifyClient.hpp"
+#include "../../spotify/AlbumArtLoader.hpp"
+#include "../../app/App.hpp"
+
+namespace ui {
 
 // UI Layout constants (for 320x480 landscape)
 #define MARGIN 16
-#define ALBUM_ART_SIZE 220
 #define CONTROLS_Y 400
 #define PROGRESS_Y 360
+#define PROGRESS_BAR_RANGE 1000  // Bar steps, fine enough for smooth progress
 
 NowPlayingScreen::NowPlayingScreen(lv_obj_t* parent)
     : screen(nullptr)
@@ -27,8 +31,20 @@ NowPlayingScreen::NowPlayingScreen(lv_obj_t* parent)
     , saveBtn(nullptr)
     , volumeSlider(nullptr)
     , menuBtn(nullptr)
+    , statusLabel(nullptr)
     , isPlaying(false)
-    , currentVolume(50) {
+    , skipPending(false)
+    , isSaved(false)
+    , currentVolume(50)
+    , durationMs(0)
+    , shownPosition(-1)
+    , shownSecond(-1)
+    , shownDurationMs(-1)
+    , trackSubscription(-1)
+    , playbackSubscription(-1)
+    , volumeSubscription(-1)
+    , unreachableSubscription(-1)
+    , reachableSubscription(-1) {
 
     screen = lv_obj_create(parent);
     lv_obj_set_size(screen, LV_PCT(100), LV_PCT(100));
@@ -38,9 +54,32 @@ NowPlayingScreen::NowPlayingScreen(lv_obj_t* parent)
     lv_obj_set_style_pad_all(screen, 0, 0);
 
     createUI();
+    subscribe();
+
+    // Show the state from before the screen existed, if anything changed yet
+    auto* spotify = App::getInstance().getSpotifyClient();
+    if (spotify && spotify->getStateGeneration() > 0) {
+        onStateChanged(SpotifyClient::CHANGED_ALL);
+    }
+    if (spotify && !spotify->isApiReachable()) {
+        showUnreachable(true);
+    }
 }
 
 NowPlayingScreen::~NowPlayingScreen() {
+    EventBus& bus = App::getInstance().getEventBus();
+    bus.unsubscribe(trackSubscription);
+    bus.unsubscribe(playbackSubscription);
+    bus.unsubscribe(volumeSubscription);
+    bus.unsubscribe(unreachableSubscription);
+    bus.unsubscribe(reachableSubscription);
+
+    auto* loader = App::getInstance().getAlbumArtLoader();
+    if (loader) {
+        loader->setLoadedHandler(nullptr);
+        loader->cancel();
+    }
+
     if (screen) {
         lv_obj_del(screen);
     }
@@ -61,6 +100,9 @@ void NowPlayingScreen::createUI() {
 
     // Volume
     createVolumeControl();
+
+    // Outage notice
+    createStatusLabel();
 }
 
 void NowPlayingScreen::createAlbumArt() {
@@ -76,9 +118,9 @@ void NowPlayingScreen::createAlbumArt() {
     lv_obj_set_style_border_width(albumArt, 0, 0);
     lv_obj_set_style_shadow_width(albumArt, 0, 0);
 
-    // Placeholder gradient
-    static uint8_t gradient_map[] = {0x12, 0x12, 0x12, 0x28, 0x28, 0x28};
-    lv_image_set_src(albumArt, gradient_map);
+    // Placeholder background until the cover is loaded
+    lv_obj_set_style_bg_color(albumArt, lv_color_hex(0x282828), 0);
+    lv_obj_set_style_bg_opa(albumArt, LV_OPA_COVER, 0);
 }
 
 void NowPlayingScreen::createTrackInfo() {
@@ -106,6 +148,7 @@ void NowPlayingScreen::createProgressBar() {
     progressBar = lv_bar_create(screen);
     lv_obj_set_size(progressBar, LV_PCT(100) - (MARGIN * 2), 4);
     lv_obj_align(progressBar, LV_ALIGN_BOTTOM_LEFT, MARGIN, -60);
+    lv_bar_set_range(progressBar, 0, PROGRESS_BAR_RANGE);
 
     // Style
     lv_obj_set_style_bg_color(progressBar, lv_color_hex(0x282828), 0);
@@ -174,20 +217,20 @@ void NowPlayingScreen::createControls() {
     lv_obj_set_style_text_color(nextLabel, lv_color_white(), 0);
     lv_label_set_text_static(nextLabel, LV_SYMBOL_SKIP_FORWARD);
 
-    // Add event handlers
+    // Add event handlers (state changes right away, requests run in the background)
     lv_obj_add_event_cb(prevBtn, [](lv_event_t* e) {
         auto* spotify = App::getInstance().getSpotifyClient();
-        if (spotify) spotify->previousTrack();
+        if (spotify) spotify->requestPreviousTrack();
     }, LV_EVENT_CLICKED, NULL);
 
     lv_obj_add_event_cb(playPauseBtn, [](lv_event_t* e) {
         auto* spotify = App::getInstance().getSpotifyClient();
-        if (spotify) spotify->togglePlay();
+        if (spotify) spotify->requestTogglePlay();
     }, LV_EVENT_CLICKED, NULL);
 
     lv_obj_add_event_cb(nextBtn, [](lv_event_t* e) {
         auto* spotify = App::getInstance().getSpotifyClient();
-        if (spotify) spotify->nextTrack();
+        if (spotify) spotify->requestNextTrack();
     }, LV_EVENT_CLICKED, NULL);
 }
 
@@ -219,8 +262,17 @@ void NowPlayingScreen::createVolumeControl() {
     lv_label_set_text_static(menuLabel, LV_SYMBOL_LIST);
 }
 
+void NowPlayingScreen::createStatusLabel() {
+    statusLabel = lv_label_create(screen);
+    lv_obj_align(statusLabel, LV_ALIGN_TOP_MID, 0, 4);
+    lv_obj_set_style_text_font(statusLabel, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xF59B23), 0);
+    lv_label_set_text_static(statusLabel, LV_SYMBOL_WARNING " Spotify unreachable");
+    lv_obj_add_flag(statusLabel, LV_OBJ_FLAG_HIDDEN);
+}
+
 void NowPlayingScreen::updateTrackInfo(const SpotifyClient::TrackInfo& track) {
-    currentTrack = track;
+    durationMs = track.durationMs;
 
     // Update labels
     lv_label_set_text(trackTitleLabel, track.title.c_str());
@@ -228,16 +280,36 @@ void NowPlayingScreen::updateTrackInfo(const SpotifyClient::TrackInfo& track) {
 
     // Load album art
     if (!track.coverUrl.isEmpty()) {
-        loadAlbumArt(track.coverUrl);
+        loadAlbumArt(track.albumId, track.coverUrl.c_str());
+    } else {
+        auto* loader = App::getInstance().getAlbumArtLoader();
+        if (loader) {
+            loader->cancel();
+        }
+        // Back to the placeholder
+        lv_image_set_src(albumArt, nullptr);
+        shownCover.reset();
+        coverUrl.clear();
     }
 }
 
 void NowPlayingScreen::updateProgress(int progressMs, int durationMs) {
-    // Calculate percentage
-    int percentage = (progressMs * 100) / durationMs;
+    // Calculate bar position (duration is 0 while nothing is playing)
+    int position = durationMs > 0
+        ? static_cast<int>(static_cast<int64_t>(progressMs) * PROGRESS_BAR_RANGE / durationMs)
+        : 0;
+
+    // Progress is interpolated every loop, only redraw when something visible changed
+    int second = progressMs / 1000;
+    if (position == shownPosition && second == shownSecond && durationMs == shownDurationMs) {
+        return;
+    }
+    shownPosition = position;
+    shownSecond = second;
+    shownDurationMs = durationMs;
 
     // Update progress bar
-    lv_bar_set_value(progressBar, percentage, LV_ANIM_ON);
+    lv_bar_set_value(progressBar, position, LV_ANIM_OFF);
 
     // Format time labels
     char timeStr[16];
@@ -273,28 +345,119 @@ void NowPlayingScreen::updateVolume(int volumePercent) {
 }
 
 void NowPlayingScreen::update() {
-    // Called periodically to update UI
-    auto* app = &App::getInstance();
-    auto* spotify = app->getSpotifyClient();
+    // Everything else arrives as events, only the position moves by itself
+    if (!isPlaying) {
+        return;
+    }
 
+    auto* spotify = App::getInstance().getSpotifyClient();
     if (spotify) {
-        SpotifyClient::TrackInfo track = spotify->getCurrentTrack();
-        if (track.title != currentTrack.title) {
-            updateTrackInfo(track);
-        }
+        updateProgress(spotify->getProgressMs(), durationMs);
+    }
+}
 
-        if (track.isPlaying != isPlaying) {
-            updatePlaybackState(track.isPlaying);
-        }
+void NowPlayingScreen::subscribe() {
+    EventBus& bus = App::getInstance().getEventBus();
+
+    trackSubscription = bus.subscribe(EventType::TRACK_CHANGED,
+        [this](const Event& e) { onStateChanged(static_cast<uint32_t>(e.intValue)); });
+
+    // Published along with TRACK_CHANGED for the same changes, handled there
+    playbackSubscription = bus.subscribe(EventType::PLAYBACK_CHANGED,
+        [this](const Event& e) {
+            uint32_t changes = static_cast<uint32_t>(e.intValue);
+            if (!(changes & SpotifyClient::CHANGED_TRACK)) {
+                onStateChanged(changes);
+            }
+        });
+
+    volumeSubscription = bus.subscribe(EventType::VOLUME_CHANGED,
+        [this](const Event& e) { updateVolume(e.intValue); });
+
+    // Also published for every command dropped during an outage
+    unreachableSubscription = bus.subscribe(EventType::SPOTIFY_UNREACHABLE,
+        [this](const Event&) { showUnreachable(true); });
+    reachableSubscription = bus.subscribe(EventType::SPOTIFY_REACHABLE,
+        [this](const Event&) { showUnreachable(false); });
+
+    auto* loader = App::getInstance().getAlbumArtLoader();
+    if (loader) {
+        loader->setLoadedHandler([this](const char* url, const std::shared_ptr<CoverImage>& image) {
+            // A cover that arrives after the track changed mustn't replace the new one
+            if (coverUrl == url) {
+                showAlbumArt(image);
+            }
+        });
+    }
+}
+
+void NowPlayingScreen::onStateChanged(uint32_t changes) {
+    auto* spotify = App::getInstance().getSpotifyClient();
+    if (!spotify) {
+        return;
+    }
+
+    // Only a new track is worth copying the strings
+    if (changes & SpotifyClient::CHANGED_TRACK) {
+        updateTrackInfo(spotify->getCurrentTrack());
+    }
+
+    SpotifyClient::PlaybackSnapshot state = spotify->getPlaybackSnapshot();
+    durationMs = state.durationMs;
 
-        updateProgress(track.progressMs, track.durationMs);
+    if (state.isPlaying != isPlaying) {
+        updatePlaybackState(state.isPlaying);
+    }
+
+    // Dim the old track info until the skipped-to track is known
+    if (state.skipPending != skipPending) {
+        skipPending = state.skipPending;
+        lv_opa_t opa = skipPending ? LV_OPA_50 : LV_OPA_COVER;
+        lv_obj_set_style_opa(trackTitleLabel, opa, 0);
+        lv_obj_set_style_opa(artistLabel, opa, 0);
+    }
+
+    // Heart is green for tracks in Your Library
+    if (state.saved != isSaved) {
+        isSaved = state.saved;
+        lv_obj_t* saveLabel = lv_obj_get_child(saveBtn, 0);
+        lv_obj_set_style_text_color(saveLabel,
+                                    lv_color_hex(isSaved ? 0x1DB954 : 0xB3B3B3), 0);
+    }
+
+    if (state.volumePercent != currentVolume) {
+        updateVolume(state.volumePercent);
+    }
+
+    updateProgress(state.progressMs, state.durationMs);
+}
+
+void NowPlayingScreen::showUnreachable(bool unreachable) {
+    if (unreachable) {
+        lv_obj_clear_flag(statusLabel, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(statusLabel, LV_OBJ_FLAG_HIDDEN);
     }
 }
 
-void NowPlayingScreen::loadAlbumArt(const String& imageUrl) {
-    // TODO: Implement album art loading
-    // For now, use a placeholder
-    // In Phase 2, we'll download and cache images
+void NowPlayingScreen::loadAlbumArt(const SpotifyId& albumId, const char* imageUrl) {
+    // Read from flash or downloaded in the background, a download for
+    // the previous track is dropped
+    coverUrl = imageUrl;
+
+    auto* loader = App::getInstance().getAlbumArtLoader();
+    if (loader) {
+        loader->load(albumId, imageUrl);
+    }
+}
+
+void NowPlayingScreen::showAlbumArt(const std::shared_ptr<CoverImage>& image) {
+    // Already decoded at ALBUM_ART_SIZE, LVGL draws the pixels as they are.
+    // Holding on to it keeps the pixels if the cache evicts the cover.
+    if (image && image->isValid()) {
+        lv_image_set_src(albumArt, image->getDescriptor());
+        shownCover = image;
+    }
 }
 
 } // namespace ui
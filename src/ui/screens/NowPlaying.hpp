@@ -10,7 +10,11 @@
 #define NOW_PLAYING_HPP
 
 #include <lvgl.h>
-#include "../spotify/SpotifyClient.hpp"
+#include <memory>
+#include "../../spotify/SpotifyClient.hpp"
+#include "../../spotify/SpotifyId.hpp"
+
+class CoverImage;
 
 namespace ui {
 
@@ -50,7 +54,10 @@ public:
     void updateVolume(int volumePercent);
 
     /**
-     * @brief Update screen (called periodically)
+     * @brief Advance the progress bar while playing (called every loop)
+     *
+     * Track and playback state are updated from TRACK_CHANGED,
+     * PLAYBACK_CHANGED and VOLUME_CHANGED events.
      */
     void update();
 
@@ -85,10 +92,36 @@ private:
      */
     void createVolumeControl();
 
+    /**
+     * @brief Create the "Spotify unreachable" notice (hidden)
+     */
+    void createStatusLabel();
+
+    /**
+     * @brief Show or hide the "Spotify unreachable" notice
+     */
+    void showUnreachable(bool unreachable);
+
     /**
      * @brief Load album art image
      */
-    void loadAlbumArt(const String& imageUrl);
+    void loadAlbumArt(const SpotifyId& albumId, const char* imageUrl);
+
+    /**
+     * @brief Show a decoded cover
+     */
+    void showAlbumArt(const std::shared_ptr<CoverImage>& image);
+
+    /**
+     * @brief Subscribe to the playback events
+     */
+    void subscribe();
+
+    /**
+     * @brief Redraw what changed
+     * @param changes SpotifyClient::StateChange bits
+     */
+    void onStateChanged(uint32_t changes);
 
     // LVGL objects
     lv_obj_t* screen;
@@ -104,11 +137,30 @@ private:
     lv_obj_t* saveBtn;
     lv_obj_t* volumeSlider;
     lv_obj_t* menuBtn;
+    lv_obj_t* statusLabel;
+
+    // Cover the album art widget points at
+    std::shared_ptr<CoverImage> shownCover;
+    FixedString<SPOTIFY_IMAGE_URL_LENGTH> coverUrl;   // Cover of the current track
 
     // UI state
-    SpotifyClient::TrackInfo currentTrack;
     bool isPlaying;
+    bool skipPending;
+    bool isSaved;
     int currentVolume;
+    int durationMs;
+
+    // Last values drawn by updateProgress()
+    int shownPosition;
+    int shownSecond;
+    int shownDurationMs;
+
+    // Event subscriptions
+    int trackSubscription;
+    int playbackSubscription;
+    int volumeSubscription;
+    int unreachableSubscription;
+    int reachableSubscription;
 };
 
 } // namespace ui
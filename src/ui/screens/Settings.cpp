@@ -4,7 +4,9 @@
  */
 
 #include "Settings.hpp"
-#include "../display/themes/SpotifyTheme.hpp"
+#include "../../display/themes/SpotifyTheme.hpp"
+
+namespace ui {
 
 #define MARGIN 16
 
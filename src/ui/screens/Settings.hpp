@@ -8,6 +8,7 @@
 #ifndef SETTINGS_SCREEN_HPP
 #define SETTINGS_SCREEN_HPP
 
+#include <Arduino.h>
 #include <lvgl.h>
 
 namespace ui {
@@ -0,0 +1,117 @@
+/**
+ * @file FixedString.hpp
+ * @brief Fixed Capacity String
+ *
+ * A string stored inline in a char array, for structs that are copied
+ * around a lot (track, playlist and device info, events). Copying one is
+ * a memcpy and never touches the heap, unlike Arduino String.
+ *
+ * Text longer than the capacity is cut off at a UTF-8 character
+ * boundary; assign() reports when that happened.
+ */
+
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * @brief Fixed String Class
+ * @tparam N Maximum length in bytes (excluding the terminator)
+ */
+template <size_t N>
+class FixedString {
+    static_assert(N > 0 && N < 65535, "FixedString length must fit in 16 bits");
+
+public:
+    FixedString()
+        : len(0) {
+        data[0] = '\0';
+    }
+
+    FixedString(const char* text) {
+        assign(text);
+    }
+
+    FixedString(const String& text) {
+        assign(text.c_str(), text.length());
+    }
+
+    FixedString& operator=(const char* text) {
+        assign(text);
+        return *this;
+    }
+
+    FixedString& operator=(const String& text) {
+        assign(text.c_str(), text.length());
+        return *this;
+    }
+
+    /**
+     * @brief Replace the contents
+     * @return false if the text was cut off
+     */
+    bool assign(const char* text) {
+        return assign(text, text ? strlen(text) : 0);
+    }
+
+    /**
+     * @brief Replace the contents with length bytes of text
+     * @return false if the text was cut off
+     */
+    bool assign(const char* text, size_t length) {
+        bool fits = length <= N;
+        if (!fits) {
+            length = N;
+            // Don't leave half a UTF-8 sequence at the end
+            while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) {
+                length--;
+            }
+        }
+
+        if (length > 0) {
+            memcpy(data, text, length);
+        }
+        data[length] = '\0';
+        len = static_cast<uint16_t>(length);
+        return fits;
+    }
+
+    void clear() {
+        len = 0;
+        data[0] = '\0';
+    }
+
+    const char* c_str() const { return data; }
+    size_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    /**
+     * @brief Copy into an Arduino String (allocates)
+     */
+    String toString() const { return String(data); }
+
+    template <size_t M>
+    bool operator==(const FixedString<M>& other) const {
+        return len == other.length() && memcmp(data, other.c_str(), len) == 0;
+    }
+
+    template <size_t M>
+    bool operator!=(const FixedString<M>& other) const { return !(*this == other); }
+
+    bool operator==(const char* text) const { return strcmp(data, text ? text : "") == 0; }
+    bool operator!=(const char* text) const { return !(*this == text); }
+    bool operator==(const String& text) const { return *this == text.c_str(); }
+    bool operator!=(const String& text) const { return !(*this == text.c_str()); }
+
+    // Ordering for use as a std::map key
+    bool operator<(const FixedString& other) const { return strcmp(data, other.data) < 0; }
+
+private:
+    char data[N + 1];
+    uint16_t len;
+};
+
+#endif // FIXED_STRING_HPP
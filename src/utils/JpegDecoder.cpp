@@ -0,0 +1,748 @@
+/**
+ * @file JpegDecoder.cpp
+ * @brief Scaled Streaming JPEG Decoder Implementation
+ */
+
+#include "JpegDecoder.hpp"
+#include <math.h>
+#include <memory>
+
+// Natural (row major) index of each zigzag position
+static const uint8_t ZIGZAG[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+ * @brief Reduced IDCT tables for 8, 4, 2 and 1 output pixels per block edge
+ *
+ * An N point output samples the same cosines as the 8 point IDCT at the
+ * centres of N wider pixels, using only the N lowest frequencies.
+ * The 1/4 normalization of the 2-D IDCT is split between both passes.
+ */
+struct IdctTables {
+    float table[4][8][8];   // [log2 N][x][u]
+
+    IdctTables() {
+        for (int n = 0; n < 4; n++) {
+            int size = 1 << n;
+            for (int x = 0; x < size; x++) {
+                for (int u = 0; u < size; u++) {
+                    float c = u == 0 ? sqrtf(0.5f) : 1.0f;
+                    table[n][x][u] = c * cosf((2 * x + 1) * u * (float)M_PI / (2 * size)) / 2;
+                }
+            }
+        }
+    }
+};
+
+static const IdctTables& idctTables() {
+    static const IdctTables tables;
+    return tables;
+}
+
+static inline uint8_t clampPixel(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+JpegDecoder::JpegDecoder()
+    : input(nullptr)
+    , inputPos(0)
+    , inputLen(0)
+    , inputEnded(false)
+    , bitBuffer(0)
+    , bitCount(0)
+    , markerReached(false)
+    , marker(0)
+    , truncated(false)
+    , componentCount(0)
+    , maxH(1)
+    , maxV(1)
+    , restartInterval(0)
+    , nextRestart(0)
+    , blockSize(8)
+    , scaledWidth(0)
+    , scaledHeight(0)
+    , sourceRow(0)
+    , rowSums(nullptr)
+    , outputSums(nullptr)
+    , outputRow(0)
+    , outputBoundary(0)
+    , error(nullptr) {
+}
+
+bool JpegDecoder::decode(Stream& stream, uint16_t* output, int width, int height) {
+    unsigned long start = micros();
+
+    input = &stream;
+    inputPos = 0;
+    inputLen = 0;
+    inputEnded = false;
+    bitBuffer = 0;
+    bitCount = 0;
+    markerReached = false;
+    truncated = false;
+    componentCount = 0;
+    restartInterval = 0;
+    for (int i = 0; i < 4; i++) {
+        quantDefined[i] = false;
+        huffman[i].defined = false;
+    }
+    info = Info();
+    error = nullptr;
+
+    if (!output || width <= 0 || height <= 0) {
+        return fail("Invalid target size");
+    }
+
+    if (!readHeaders()) {
+        return false;
+    }
+
+    bool ok = decodeScan(output, width, height);
+    info.decodeUs = micros() - start;
+    return ok;
+}
+
+// Private methods
+
+bool JpegDecoder::readHeaders() {
+    if (readByte() != 0xFF || readByte() != 0xD8) {
+        return fail("Not a JPEG");
+    }
+
+    bool frameRead = false;
+
+    while (true) {
+        if (readByte() != 0xFF) {
+            return fail("Marker expected");
+        }
+        int code = readByte();
+        while (code == 0xFF) {
+            code = readByte();  // Fill bytes
+        }
+        if (code < 0) {
+            return fail("Truncated JPEG");
+        }
+
+        if (code == 0xD9) {
+            return fail("No image data");
+        }
+
+        int length = readWord() - 2;
+        if (length < 0) {
+            return fail("Bad segment length");
+        }
+
+        switch (code) {
+            case 0xC0:  // Baseline
+            case 0xC1:  // Extended sequential, Huffman
+                if (!readFrame(length)) {
+                    return false;
+                }
+                frameRead = true;
+                break;
+
+            case 0xC2:
+                return fail("Progressive JPEG not supported");
+
+            case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+            case 0xC9: case 0xCA: case 0xCB:
+            case 0xCD: case 0xCE: case 0xCF:
+                return fail("Unsupported JPEG coding");
+
+            case 0xC4:
+                if (!readHuffmanTables(length)) {
+                    return false;
+                }
+                break;
+
+            case 0xDB:
+                if (!readQuantTables(length)) {
+                    return false;
+                }
+                break;
+
+            case 0xDD:
+                if (length != 2) {
+                    return fail("Bad restart interval");
+                }
+                restartInterval = readWord();
+                break;
+
+            case 0xDA:
+                if (!frameRead) {
+                    return fail("Scan before frame");
+                }
+                return readScan(length);
+
+            default:
+                // APPn (JFIF, Exif, ICC), comments
+                skip(length);
+                break;
+        }
+
+        if (inputEnded) {
+            return fail("Truncated JPEG");
+        }
+    }
+}
+
+bool JpegDecoder::readQuantTables(int length) {
+    while (length > 0) {
+        int spec = readByte();
+        int precision = spec >> 4;
+        int id = spec & 0x0F;
+        if (id > 3 || precision > 1) {
+            return fail("Bad quantization table");
+        }
+
+        for (int k = 0; k < 64; k++) {
+            quant[id][k] = precision ? readWord() : readByte();
+        }
+        quantDefined[id] = true;
+        length -= 1 + (precision ? 128 : 64);
+    }
+    return length == 0 || fail("Bad quantization table length");
+}
+
+bool JpegDecoder::readHuffmanTables(int length) {
+    while (length > 0) {
+        int spec = readByte();
+        int tableClass = spec >> 4;
+        int id = spec & 0x0F;
+        if (tableClass > 1 || id > 1) {
+            return fail("Unsupported Huffman table");
+        }
+
+        HuffmanTable& table = huffman[tableClass * 2 + id];
+
+        uint8_t counts[16];
+        int total = 0;
+        for (int i = 0; i < 16; i++) {
+            counts[i] = readByte();
+            total += counts[i];
+        }
+        if (total > 256) {
+            return fail("Bad Huffman table");
+        }
+        for (int i = 0; i < total; i++) {
+            table.symbols[i] = readByte();
+        }
+        length -= 17 + total;
+
+        // Canonical codes: each length continues from the previous one
+        memset(table.fast, 0, sizeof(table.fast));
+        int32_t code = 0;
+        int index = 0;
+        for (int bits = 1; bits <= 16; bits++) {
+            table.valueOffset[bits] = index - code;
+            for (int i = 0; i < counts[bits - 1]; i++, code++, index++) {
+                if (bits <= JPEG_FAST_BITS) {
+                    int shift = JPEG_FAST_BITS - bits;
+                    uint16_t entry = static_cast<uint16_t>((bits << 8) | table.symbols[index]);
+                    for (int32_t fill = code << shift; fill < (code + 1) << shift; fill++) {
+                        table.fast[fill] = entry;
+                    }
+                }
+            }
+            if (code > (1 << bits)) {
+                return fail("Bad Huffman table");
+            }
+            table.maxCode[bits] = counts[bits - 1] ? code - 1 : -1;
+            code <<= 1;
+        }
+        table.maxCode[17] = INT32_MAX;  // Ends the slow search
+        table.defined = true;
+    }
+    return length == 0 || fail("Bad Huffman table length");
+}
+
+bool JpegDecoder::readFrame(int length) {
+    int precision = readByte();
+    info.height = readWord();
+    info.width = readWord();
+    componentCount = readByte();
+
+    if (precision != 8) {
+        return fail("Only 8 bit JPEGs are supported");
+    }
+    if (info.width <= 0 || info.height <= 0 ||
+        info.width > JPEG_MAX_DIMENSION || info.height > JPEG_MAX_DIMENSION) {
+        return fail("Unsupported image size");
+    }
+    if (componentCount != 1 && componentCount != 3) {
+        return fail("Unsupported colour format");
+    }
+    if (length != 6 + componentCount * 3) {
+        return fail("Bad frame header");
+    }
+
+    maxH = 1;
+    maxV = 1;
+    for (int i = 0; i < componentCount; i++) {
+        Component& component = components[i];
+        component.id = readByte();
+        int sampling = readByte();
+        component.h = sampling >> 4;
+        component.v = sampling & 0x0F;
+        component.quantTable = readByte();
+
+        if (component.h < 1 || component.h > 4 || component.v < 1 || component.v > 4 ||
+            component.quantTable > 3) {
+            return fail("Bad component");
+        }
+        maxH = max(maxH, (int)component.h);
+        maxV = max(maxV, (int)component.v);
+    }
+
+    // A single component isn't interleaved, its MCU is one block
+    if (componentCount == 1) {
+        components[0].h = components[0].v = 1;
+        maxH = maxV = 1;
+    }
+    return true;
+}
+
+bool JpegDecoder::readScan(int length) {
+    int count = readByte();
+    if (count != componentCount || length != 4 + count * 2) {
+        return fail("Only single scan JPEGs are supported");
+    }
+
+    for (int i = 0; i < count; i++) {
+        int id = readByte();
+        int tables = readByte();
+
+        Component* component = nullptr;
+        for (int c = 0; c < componentCount; c++) {
+            if (components[c].id == id) {
+                component = &components[c];
+            }
+        }
+        if (!component) {
+            return fail("Bad scan component");
+        }
+
+        component->dcTable = tables >> 4;
+        component->acTable = tables & 0x0F;
+        if (component->dcTable > 1 || component->acTable > 1 ||
+            !huffman[component->dcTable].defined || !huffman[2 + component->acTable].defined ||
+            !quantDefined[component->quantTable]) {
+            return fail("Missing table");
+        }
+    }
+
+    // Spectral selection and successive approximation, fixed for baseline
+    int spectralStart = readByte();
+    int spectralEnd = readByte();
+    int approximation = readByte();
+    if (spectralStart != 0 || spectralEnd != 63 || approximation != 0) {
+        return fail("Unsupported scan");
+    }
+    return true;
+}
+
+bool JpegDecoder::decodeScan(uint16_t* output, int width, int height) {
+    // Largest DCT scaling that still leaves at least the target size
+    info.scale = 1;
+    for (int scale = 8; scale > 1; scale /= 2) {
+        if ((info.width + scale - 1) / scale >= width && (info.height + scale - 1) / scale >= height) {
+            info.scale = scale;
+            break;
+        }
+    }
+    blockSize = 8 / info.scale;
+    scaledWidth = (info.width + info.scale - 1) / info.scale;
+    scaledHeight = (info.height + info.scale - 1) / info.scale;
+
+    int mcuWidth = 8 * maxH;
+    int mcuHeight = 8 * maxV;
+    int mcusX = (info.width + mcuWidth - 1) / mcuWidth;
+    int mcusY = (info.height + mcuHeight - 1) / mcuHeight;
+
+    // One buffer for the MCU row planes and the resampler sums
+    size_t planeBytes[JPEG_MAX_COMPONENTS];
+    size_t total = 0;
+    for (int c = 0; c < componentCount; c++) {
+        components[c].planeWidth = mcusX * components[c].h * blockSize;
+        planeBytes[c] = components[c].planeWidth * components[c].v * blockSize;
+        total += planeBytes[c];
+    }
+    total = (total + 3) & ~static_cast<size_t>(3);
+    size_t sumBytes = width * 3 * sizeof(int32_t);
+
+    std::unique_ptr<uint8_t[]> work(new (std::nothrow) uint8_t[total + 2 * sumBytes]);
+    if (!work) {
+        return fail("Out of memory");
+    }
+    info.workBytes = total + 2 * sumBytes;
+
+    uint8_t* next = work.get();
+    for (int c = 0; c < componentCount; c++) {
+        components[c].plane = next;
+        components[c].dcPredictor = 0;
+        next += planeBytes[c];
+    }
+    rowSums = reinterpret_cast<int32_t*>(work.get() + total);
+    outputSums = rowSums + width * 3;
+    memset(outputSums, 0, sumBytes);
+
+    sourceRow = 0;
+    outputRow = 0;
+    outputBoundary = scaledHeight;
+    nextRestart = 0;
+
+    int rowsPerMcu = maxV * blockSize;
+    int mcusLeft = restartInterval;
+
+    for (int mcuY = 0; mcuY < mcusY; mcuY++) {
+        for (int mcuX = 0; mcuX < mcusX; mcuX++) {
+            if (restartInterval) {
+                if (mcusLeft == 0) {
+                    if (!restart()) {
+                        return false;
+                    }
+                    mcusLeft = restartInterval;
+                }
+                mcusLeft--;
+            }
+
+            for (int c = 0; c < componentCount; c++) {
+                Component& component = components[c];
+                for (int v = 0; v < component.v; v++) {
+                    for (int h = 0; h < component.h; h++) {
+                        uint8_t* out = component.plane
+                            + v * blockSize * component.planeWidth
+                            + (mcuX * component.h + h) * blockSize;
+                        if (!decodeBlock(component, out, component.planeWidth)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        int rows = min(rowsPerMcu, scaledHeight - sourceRow);
+        for (int row = 0; row < rows; row++) {
+            resampleRow(row, output, width, height);
+        }
+
+        if (truncated) {
+            return fail("Truncated JPEG");
+        }
+    }
+
+    rowSums = nullptr;
+    outputSums = nullptr;
+    return true;
+}
+
+bool JpegDecoder::decodeBlock(Component& component, uint8_t* out, int stride) {
+    float block[64];
+    for (int y = 0; y < blockSize; y++) {
+        for (int x = 0; x < blockSize; x++) {
+            block[y * 8 + x] = 0;
+        }
+    }
+
+    const float* table = quant[component.quantTable];
+
+    int length = decodeHuffman(huffman[component.dcTable]);
+    if (length < 0) {
+        return fail("Bad Huffman code");
+    }
+    component.dcPredictor += receiveExtend(length);
+    block[0] = component.dcPredictor * table[0];
+
+    // All coefficients have to be decoded, only the low frequencies are kept
+    const HuffmanTable& ac = huffman[2 + component.acTable];
+    for (int k = 1; k < 64;) {
+        int symbol = decodeHuffman(ac);
+        if (symbol < 0) {
+            return fail("Bad Huffman code");
+        }
+
+        int run = symbol >> 4;
+        int size = symbol & 0x0F;
+        if (size == 0) {
+            if (run != 15) {
+                break;      // End of block
+            }
+            k += 16;
+            continue;
+        }
+
+        k += run;
+        if (k > 63) {
+            return fail("Bad coefficient run");
+        }
+
+        int value = receiveExtend(size);
+        int index = ZIGZAG[k];
+        if ((index & 7) < blockSize && (index >> 3) < blockSize) {
+            block[index] = value * table[k];
+        }
+        k++;
+    }
+
+    inverseDct(block, out, stride);
+    return true;
+}
+
+void JpegDecoder::inverseDct(const float* coefficients, uint8_t* out, int stride) const {
+    int size = blockSize;
+    if (size == 1) {
+        out[0] = clampPixel(static_cast<int>(lrintf(coefficients[0] / 8)) + 128);
+        return;
+    }
+
+    const float (*table)[8] = idctTables().table[size == 8 ? 3 : size / 2];
+    float rows[64];
+
+    for (int v = 0; v < size; v++) {
+        const float* in = coefficients + v * 8;
+        for (int x = 0; x < size; x++) {
+            float sum = 0;
+            for (int u = 0; u < size; u++) {
+                sum += table[x][u] * in[u];
+            }
+            rows[v * 8 + x] = sum;
+        }
+    }
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float sum = 128.5f;
+            for (int v = 0; v < size; v++) {
+                sum += table[y][v] * rows[v * 8 + x];
+            }
+            out[y * stride + x] = clampPixel(static_cast<int>(sum));
+        }
+    }
+}
+
+bool JpegDecoder::restart() {
+    bitBuffer = 0;
+    bitCount = 0;
+
+    // Skip the padding up to the marker unless the bit reader already hit it
+    while (!markerReached) {
+        int byte = readByte();
+        if (byte < 0) {
+            return fail("Truncated JPEG");
+        }
+        if (byte == 0xFF) {
+            int code = readByte();
+            while (code == 0xFF) {
+                code = readByte();
+            }
+            if (code > 0) {
+                marker = code;
+                markerReached = true;
+            }
+        }
+    }
+
+    if (marker < 0xD0 || marker > 0xD7) {
+        return fail("Restart marker expected");
+    }
+
+    markerReached = false;
+    nextRestart = (nextRestart + 1) & 7;
+    for (int c = 0; c < componentCount; c++) {
+        components[c].dcPredictor = 0;
+    }
+    return true;
+}
+
+void JpegDecoder::resampleRow(int row, uint16_t* output, int width, int height) {
+    // Area averaging in integer units: a source pixel is `width` units
+    // wide, a target pixel `scaledWidth`, so the weights of each target
+    // pixel add up to scaledWidth (and scaledHeight vertically)
+    memset(rowSums, 0, width * 3 * sizeof(int32_t));
+
+    const Component& luma = components[0];
+    const uint8_t* y = luma.plane + row * luma.planeWidth;
+    const uint8_t* cb = nullptr;
+    const uint8_t* cr = nullptr;
+    if (componentCount == 3) {
+        cb = components[1].plane + (row * components[1].v / maxV) * components[1].planeWidth;
+        cr = components[2].plane + (row * components[2].v / maxV) * components[2].planeWidth;
+    }
+
+    int target = 0;
+    int32_t boundary = scaledWidth;
+    int32_t position = 0;
+
+    for (int x = 0; x < scaledWidth; x++) {
+        int r, g, b;
+        if (cb) {
+            // JFIF YCbCr to RGB, 16 bit fixed point
+            int luminance = y[x];
+            int blue = cb[x * components[1].h / maxH] - 128;
+            int red = cr[x * components[2].h / maxH] - 128;
+            r = clampPixel(luminance + ((91881 * red + 32768) >> 16));
+            g = clampPixel(luminance - ((22554 * blue + 46802 * red - 32768) >> 16));
+            b = clampPixel(luminance + ((116130 * blue + 32768) >> 16));
+        } else {
+            r = g = b = y[x];
+        }
+
+        int32_t end = position + width;
+        while (position < end) {
+            int32_t segment = min(end, boundary);
+            int32_t weight = segment - position;
+            int32_t* sum = rowSums + target * 3;
+            sum[0] += weight * r;
+            sum[1] += weight * g;
+            sum[2] += weight * b;
+
+            position = segment;
+            if (position == boundary) {
+                target++;
+                boundary += scaledWidth;
+            }
+        }
+    }
+
+    int32_t position2 = sourceRow * height;
+    int32_t end = position2 + height;
+    int32_t divisor = scaledWidth * scaledHeight;
+
+    while (position2 < end) {
+        int32_t segment = min(end, outputBoundary);
+        int32_t weight = segment - position2;
+        for (int i = 0; i < width * 3; i++) {
+            outputSums[i] += weight * rowSums[i];
+        }
+
+        position2 = segment;
+        if (position2 == outputBoundary) {
+            // Target row complete
+            uint16_t* out = output + outputRow * width;
+            for (int i = 0; i < width; i++) {
+                int32_t* sum = outputSums + i * 3;
+                int red = (sum[0] + divisor / 2) / divisor;
+                int green = (sum[1] + divisor / 2) / divisor;
+                int blue = (sum[2] + divisor / 2) / divisor;
+                out[i] = static_cast<uint16_t>(((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3));
+            }
+            memset(outputSums, 0, width * 3 * sizeof(int32_t));
+            outputRow++;
+            outputBoundary += scaledHeight;
+        }
+    }
+
+    sourceRow++;
+}
+
+int JpegDecoder::readByte() {
+    if (inputPos >= inputLen) {
+        inputLen = input->readBytes(reinterpret_cast<char*>(inputBuffer), sizeof(inputBuffer));
+        inputPos = 0;
+        if (inputLen == 0) {
+            inputEnded = true;
+            return -1;
+        }
+    }
+    return inputBuffer[inputPos++];
+}
+
+int JpegDecoder::readWord() {
+    int high = readByte();
+    int low = readByte();
+    return (high << 8) | low;
+}
+
+void JpegDecoder::skip(int length) {
+    while (length > 0 && !inputEnded) {
+        if (inputPos >= inputLen && readByte() >= 0) {
+            length--;
+            continue;
+        }
+        size_t n = min(static_cast<size_t>(length), inputLen - inputPos);
+        inputPos += n;
+        length -= n;
+    }
+}
+
+void JpegDecoder::fillBits() {
+    while (bitCount <= 24) {
+        int byte = 0;
+        if (!markerReached) {
+            byte = readByte();
+            if (byte < 0) {
+                truncated = true;
+                markerReached = true;
+                byte = 0;
+            } else if (byte == 0xFF) {
+                int code = readByte();
+                while (code == 0xFF) {
+                    code = readByte();
+                }
+                if (code != 0) {
+                    // A marker ends the data, feed zeros from here on
+                    marker = code;
+                    markerReached = true;
+                    truncated |= code < 0;
+                    byte = 0;
+                }
+            }
+        }
+        bitBuffer |= static_cast<uint32_t>(byte) << (24 - bitCount);
+        bitCount += 8;
+    }
+}
+
+int JpegDecoder::decodeHuffman(const HuffmanTable& table) {
+    if (bitCount < 16) {
+        fillBits();
+    }
+
+    uint16_t entry = table.fast[bitBuffer >> (32 - JPEG_FAST_BITS)];
+    if (entry) {
+        int bits = entry >> 8;
+        bitBuffer <<= bits;
+        bitCount -= bits;
+        return entry & 0xFF;
+    }
+
+    // Longer code
+    int32_t code16 = bitBuffer >> 16;
+    for (int bits = JPEG_FAST_BITS + 1; bits <= 16; bits++) {
+        int32_t code = code16 >> (16 - bits);
+        if (code <= table.maxCode[bits]) {
+            bitBuffer <<= bits;
+            bitCount -= bits;
+            return table.symbols[(table.valueOffset[bits] + code) & 0xFF];
+        }
+    }
+    return -1;
+}
+
+int JpegDecoder::receiveExtend(int length) {
+    if (length == 0) {
+        return 0;
+    }
+    if (bitCount < length) {
+        fillBits();
+    }
+
+    int value = static_cast<int>(bitBuffer >> (32 - length));
+    bitBuffer <<= length;
+    bitCount -= length;
+
+    // Values with a leading 0 bit are negative
+    if (value < (1 << (length - 1))) {
+        value -= (1 << length) - 1;
+    }
+    return value;
+}
+
+bool JpegDecoder::fail(const char* message) {
+    error = message;
+    return false;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file JpegDecoder.hpp
+ * @brief Scaled Streaming JPEG Decoder
+ *
+ * Decodes a baseline JPEG straight to an RGB565 bitmap of a given size,
+ * for album art: a 640x640 cover is shown at 220x220.
+ *
+ * - Reads the file through a small buffer, the JPEG is never in RAM
+ * - Scales down by 1/2, 1/4 or 1/8 in the DCT domain (a reduced IDCT
+ *   only computes the pixels that are needed), then area-averages to
+ *   the exact target size
+ * - Works one MCU row at a time, the full resolution bitmap is never
+ *   built; working memory is about 10 KB for a 640x640 cover
+ *
+ * Progressive and arithmetic coded JPEGs are not supported.
+ */
+
+#ifndef JPEG_DECODER_HPP
+#define JPEG_DECODER_HPP
+
+#include <Arduino.h>
+
+// Decoder limits
+#define JPEG_MAX_DIMENSION 2048        // Larger images are refused
+#define JPEG_MAX_COMPONENTS 3
+#define JPEG_INPUT_BUFFER_SIZE 512     // Bytes read from the stream at a time
+#define JPEG_FAST_BITS 9               // Huffman codes up to this length take one lookup
+
+/**
+ * @brief JPEG Decoder Class
+ *
+ * Not thread safe, use one decoder per task. Usage:
+ *
+ *     File file = LittleFS.open(path);
+ *     JpegDecoder decoder;
+ *     if (decoder.decode(file, pixels, 220, 220)) { ... }
+ */
+class JpegDecoder {
+public:
+    /**
+     * @brief Result of the last decode
+     */
+    struct Info {
+        int width;              // Source image
+        int height;
+        int scale;              // DCT scale denominator (1, 2, 4 or 8)
+        unsigned long decodeUs;
+        size_t workBytes;       // Buffers allocated for the decode (besides the decoder itself)
+
+        Info()
+            : width(0)
+            , height(0)
+            , scale(1)
+            , decodeUs(0)
+            , workBytes(0) {
+        }
+    };
+
+    JpegDecoder();
+
+    // Large tables, don't copy
+    JpegDecoder(const JpegDecoder&) = delete;
+    JpegDecoder& operator=(const JpegDecoder&) = delete;
+
+    /**
+     * @brief Decode a JPEG, scaled to width x height
+     *
+     * The image is stretched to the target size; album art is square.
+     * @param input Stream positioned at the start of the JPEG
+     * @param output width * height RGB565 pixels, row after row
+     * @return false if the JPEG is invalid or unsupported (see getError())
+     */
+    bool decode(Stream& input, uint16_t* output, int width, int height);
+
+    /**
+     * @brief Get details of the last decode
+     */
+    const Info& getInfo() const { return info; }
+
+    /**
+     * @brief Get why the last decode failed
+     */
+    const char* getError() const { return error; }
+
+private:
+    struct HuffmanTable {
+        uint16_t fast[1 << JPEG_FAST_BITS];  // (length << 8) | symbol, 0 = longer code
+        int32_t maxCode[18];                 // Largest code of each length, -1 if none
+        int32_t valueOffset[17];             // Index of the first symbol of a length minus its code
+        uint8_t symbols[256];
+        bool defined;
+    };
+
+    struct Component {
+        uint8_t id;
+        uint8_t h;              // Sampling factors
+        uint8_t v;
+        uint8_t quantTable;
+        uint8_t dcTable;
+        uint8_t acTable;
+        int dcPredictor;
+
+        uint8_t* plane;         // Scaled pixels of one MCU row
+        int planeWidth;
+    };
+
+    /**
+     * @brief Read markers up to the start of the scan
+     */
+    bool readHeaders();
+
+    bool readQuantTables(int length);
+    bool readHuffmanTables(int length);
+    bool readFrame(int length);
+    bool readScan(int length);
+
+    /**
+     * @brief Decode the scan into output
+     */
+    bool decodeScan(uint16_t* output, int width, int height);
+
+    /**
+     * @brief Decode one 8x8 block and write its scaled pixels into the plane
+     */
+    bool decodeBlock(Component& component, uint8_t* out, int stride);
+
+    /**
+     * @brief Inverse DCT of the top left scaled x scaled coefficients
+     */
+    void inverseDct(const float* coefficients, uint8_t* out, int stride) const;
+
+    /**
+     * @brief Skip to the next restart marker and reset the predictors
+     */
+    bool restart();
+
+    /**
+     * @brief Colour convert one row of the MCU row and add it to the resampler
+     * @param row Row within the MCU row (scaled pixels)
+     */
+    void resampleRow(int row, uint16_t* output, int width, int height);
+
+    // Input
+    int readByte();
+    int readWord();
+    void skip(int length);
+
+    // Entropy decoding
+    void fillBits();
+    int decodeHuffman(const HuffmanTable& table);
+    int receiveExtend(int length);
+
+    bool fail(const char* message);
+
+    Stream* input;
+    uint8_t inputBuffer[JPEG_INPUT_BUFFER_SIZE];
+    size_t inputPos;
+    size_t inputLen;
+    bool inputEnded;
+
+    uint32_t bitBuffer;
+    int bitCount;
+    bool markerReached;         // Stop filling bits, the entropy coded data ended
+    int marker;                 // The marker that ended it
+    bool truncated;             // Input ended inside the entropy coded data
+
+    float quant[4][64];         // Zigzag order
+    bool quantDefined[4];
+    HuffmanTable huffman[4];    // DC 0, 1 then AC 0, 1
+
+    Component components[JPEG_MAX_COMPONENTS];
+    int componentCount;
+    int maxH;
+    int maxV;
+    int restartInterval;
+    int nextRestart;            // Expected RSTn marker (0-7)
+
+    // Scaled image and the resampler state
+    int blockSize;              // Pixels per block edge after DCT scaling (8 / scale)
+    int scaledWidth;
+    int scaledHeight;
+    int sourceRow;              // Next scaled row to resample
+    int32_t* rowSums;           // Current source row, horizontally resampled
+    int32_t* outputSums;        // Target row being accumulated
+    int outputRow;
+    int32_t outputBoundary;     // Where outputRow ends, in source rows * target height
+
+    Info info;
+    const char* error;
+};
+
+#endif // JPEG_DECODER_HPP
@@ -0,0 +1,40 @@
+/**
+ * @file UrlEncode.cpp
+ * @brief URL Encoding Implementation
+ */
+
+#include "UrlEncode.hpp"
+
+static bool isUnreserved(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+int urlEncode(const char* value, char* out, size_t size) {
+    static const char hex[] = "0123456789ABCDEF";
+
+    if (size == 0) {
+        return -1;
+    }
+
+    size_t length = 0;
+    for (const char* p = value; *p; p++) {
+        size_t needed = isUnreserved(*p) ? 1 : 3;
+        if (length + needed >= size) {
+            out[length] = '\0';
+            return -1;
+        }
+
+        if (needed == 1) {
+            out[length++] = *p;
+        } else {
+            uint8_t byte = static_cast<uint8_t>(*p);
+            out[length++] = '%';
+            out[length++] = hex[byte >> 4];
+            out[length++] = hex[byte & 0x0F];
+        }
+    }
+
+    out[length] = '\0';
+    return static_cast<int>(length);
+}
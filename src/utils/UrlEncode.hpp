@@ -0,0 +1,26 @@
+/**
+ * @file UrlEncode.hpp
+ * @brief URL Encoding Utility
+ *
+ * Percent-encoding of query parameter values (RFC 3986).
+ */
+
+#ifndef URL_ENCODE_HPP
+#define URL_ENCODE_HPP
+
+#include <Arduino.h>
+
+/**
+ * @brief Percent-encode a string for use in a URL query
+ *
+ * Everything except the unreserved characters (A-Z a-z 0-9 - . _ ~) is
+ * encoded byte by byte, so UTF-8 text is encoded correctly.
+ * @param value Text to encode
+ * @param out Output buffer, always NUL-terminated
+ * @param size Size of the output buffer
+ * @return Length written, or -1 if the result didn't fit (out is cut off
+ *         at a character boundary)
+ */
+int urlEncode(const char* value, char* out, size_t size);
+
+#endif // URL_ENCODE_HPP
@@ -0,0 +1,916 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Spotify Web API and accounts service.
+
+Implements the endpoints SpotifyClient and AuthManager use, backed by the
+recorded payloads in fixtures/ and a simulated playback session whose
+position advances in real time. Latency, jitter, errors, 429s and dropped
+connections can be injected to measure the client on the native build
+without touching the real service.
+
+    python3 tools/spotify-stub/spotify_stub.py --port 8443 --latency-ms 80 --jitter-ms 30
+
+Then build the client with
+    -DSPOTIFY_API_BASE=\\"https://127.0.0.1:8443/v1\\"
+    -DSPOTIFY_TOKEN_URL=\\"https://127.0.0.1:8443/api/token\\"
+
+Only the Python standard library is needed (plus the openssl command to
+generate a self-signed certificate when --cert is not given).
+"""
+
+import argparse
+import copy
+import hashlib
+import json
+import os
+import random
+import re
+import shutil
+import ssl
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, quote, urlsplit
+
+FIXTURES_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures")
+IMAGES_DIR = os.path.join(FIXTURES_DIR, "images")
+API_ROOT = "https://api.spotify.com/v1"
+
+# Real responses list every market a track is available in, which is most
+# of their size. Added to the fixtures unless --no-markets is given.
+MARKETS = (
+    "AD AE AG AL AM AO AR AT AU AZ BA BB BD BE BF BG BH BI BJ BN BO BR BS BT BW "
+    "BY BZ CA CD CG CH CI CL CM CO CR CV CW CY CZ DE DJ DK DM DO DZ EC EE EG ES "
+    "ET FI FJ FM FR GA GB GD GE GH GM GN GQ GR GT GW GY HK HN HR HT HU ID IE IL "
+    "IN IQ IS IT JM JO JP KE KG KH KI KM KN KR KW KZ LA LB LC LI LK LR LS LT LU "
+    "LV LY MA MC MD ME MG MH MK ML MN MO MR MT MU MV MW MX MY MZ NA NE NG NI NL "
+    "NO NP NR NZ OM PA PE PG PH PK PL PR PS PT PW PY QA RO RS RW SA SB SC SE SG "
+    "SI SK SL SM SN SR ST SV SZ TD TG TH TJ TL TN TO TR TT TV TW TZ UA UG US UY "
+    "UZ VC VE VN VU WS XK ZA ZM ZW"
+).split()
+
+BASE62 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+
+
+def load_fixture(name):
+    with open(os.path.join(FIXTURES_DIR, name), encoding="utf-8") as f:
+        return json.load(f)
+
+
+def make_id(*parts):
+    """Deterministic 22 character base62 id, like Spotify's."""
+    digest = int.from_bytes(hashlib.sha256("/".join(map(str, parts)).encode()).digest(), "big")
+    chars = []
+    for _ in range(22):
+        digest, rem = divmod(digest, 62)
+        chars.append(BASE62[rem])
+    return "".join(chars)
+
+
+def now_ms():
+    return int(time.time() * 1000)
+
+
+def spotify_error(status, message):
+    return {"error": {"status": status, "message": message}}
+
+
+class Faults:
+    """Injected latency and failures, changeable at runtime via /stub/config."""
+
+    FIELDS = ("latency_ms", "jitter_ms", "error_rate", "rate_limit_rate", "retry_after",
+              "drop_rate", "chunked")
+
+    def __init__(self, args):
+        self.lock = threading.Lock()
+        self.latency_ms = args.latency_ms
+        self.jitter_ms = args.jitter_ms
+        self.error_rate = args.error_rate
+        self.rate_limit_rate = args.rate_limit_rate
+        self.retry_after = args.retry_after
+        self.drop_rate = args.drop_rate
+        self.chunked = args.chunked
+        self.route_latency = []
+        for spec in args.route_latency:
+            pattern, _, ms = spec.rpartition("=")
+            self.route_latency.append((re.compile(pattern), float(ms)))
+
+    def update(self, values):
+        with self.lock:
+            for key, value in values.items():
+                if key not in self.FIELDS:
+                    raise KeyError(key)
+                setattr(self, key, type(getattr(self, key))(value))
+
+    def as_dict(self):
+        with self.lock:
+            return {key: getattr(self, key) for key in self.FIELDS}
+
+    def delay_s(self, path):
+        with self.lock:
+            latency = self.latency_ms
+            for pattern, ms in self.route_latency:
+                if pattern.search(path):
+                    latency = ms
+                    break
+            jitter = random.uniform(-self.jitter_ms, self.jitter_ms) if self.jitter_ms else 0
+        return max(0.0, latency + jitter) / 1000.0
+
+    def pick(self):
+        """None, "drop", "rate_limit" or "error"."""
+        with self.lock:
+            roll = random.random()
+            for kind, rate in (("drop", self.drop_rate), ("rate_limit", self.rate_limit_rate),
+                               ("error", self.error_rate)):
+                if roll < rate:
+                    return kind
+                roll -= rate
+        return None
+
+
+class Stats:
+    """Request counters, served at /stub/stats."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        with self.lock:
+            self.started = time.time()
+            self.requests = 0
+            self.connections = 0
+            self.bytes_sent = 0
+            self.by_route = {}
+            self.by_status = {}
+
+    def record(self, route, status, size, elapsed_ms):
+        with self.lock:
+            self.requests += 1
+            self.bytes_sent += size
+            self.by_status[str(status)] = self.by_status.get(str(status), 0) + 1
+            entry = self.by_route.setdefault(route, {"count": 0, "total_ms": 0.0, "max_ms": 0.0})
+            entry["count"] += 1
+            entry["total_ms"] += elapsed_ms
+            entry["max_ms"] = max(entry["max_ms"], elapsed_ms)
+
+    def connected(self):
+        with self.lock:
+            self.connections += 1
+
+    def as_dict(self):
+        with self.lock:
+            routes = {
+                route: {"count": e["count"], "avg_ms": round(e["total_ms"] / e["count"], 2),
+                        "max_ms": round(e["max_ms"], 2)}
+                for route, e in self.by_route.items()
+            }
+            return {"uptime_s": round(time.time() - self.started, 1), "requests": self.requests,
+                    "connections": self.connections, "bytes_sent": self.bytes_sent,
+                    "by_status": dict(self.by_status), "by_route": routes}
+
+
+class Tokens:
+    """Issued access tokens and their expiry."""
+
+    def __init__(self, lifetime_s, strict, rotate):
+        self.lock = threading.Lock()
+        self.lifetime_s = lifetime_s
+        self.strict = strict
+        self.rotate = rotate
+        self.issued = {}
+        self.counter = 0
+
+    def issue(self, refresh_token=None):
+        with self.lock:
+            self.counter += 1
+            access = "stub-access-%d-%s" % (self.counter, make_id("access", self.counter, time.time()))
+            self.issued[access] = time.time() + self.lifetime_s
+            body = {"access_token": access, "token_type": "Bearer", "expires_in": self.lifetime_s,
+                    "scope": "user-read-playback-state user-modify-playback-state "
+                             "user-read-currently-playing user-library-read user-library-modify "
+                             "playlist-read-private playlist-read-collaborative"}
+            if refresh_token is None or self.rotate:
+                body["refresh_token"] = "stub-refresh-%s" % make_id("refresh", self.counter)
+            return body
+
+    def check(self, header):
+        """None if the Authorization header is acceptable, else the error message."""
+        if not header or not header.startswith("Bearer "):
+            return "No token provided"
+        token = header[len("Bearer "):]
+        with self.lock:
+            expiry = self.issued.get(token)
+        if expiry is None:
+            return "Invalid access token" if self.strict else None
+        if time.time() >= expiry:
+            return "The access token expired"
+        return None
+
+
+class Library:
+    """Tracks, playlists and devices served by the stub."""
+
+    def __init__(self, args):
+        self.tracks = load_fixture("tracks.json")
+        if not args.no_markets:
+            for track in self.tracks:
+                track.setdefault("available_markets", MARKETS)
+                track["album"].setdefault("available_markets", MARKETS)
+        self.by_uri = {t["uri"]: t for t in self.tracks}
+
+        recorded = load_fixture("playlists.json")
+        self.playlists = recorded[:args.playlists]
+        for i in range(len(self.playlists), args.playlists):
+            self.playlists.append(self._synthetic_playlist(recorded[i % len(recorded)], i))
+        self.playlists_by_id = {p["id"]: p for p in self.playlists}
+
+        self.devices = load_fixture("devices.json")
+        self.search_results = args.search_results
+
+    @staticmethod
+    def _synthetic_playlist(template, index):
+        playlist = copy.deepcopy(template)
+        pid = make_id("playlist", index)
+        playlist.update({
+            "id": pid,
+            "name": "Mix #%d" % (index + 1),
+            "description": "",
+            "href": "%s/playlists/%s" % (API_ROOT, pid),
+            "uri": "spotify:playlist:" + pid,
+            "external_urls": {"spotify": "https://open.spotify.com/playlist/" + pid},
+        })
+        playlist["tracks"] = {"href": "%s/playlists/%s/tracks" % (API_ROOT, pid),
+                              "total": 10 + (index * 7) % 190}
+        return playlist
+
+    def search_tracks(self, query):
+        """Matching fixtures first, then variants to fill --search-results."""
+        q = query.lower()
+        matches = [t for t in self.tracks
+                   if q in t["name"].lower() or q in t["artists"][0]["name"].lower()
+                   or q in t["album"]["name"].lower()]
+        results = list(matches)
+        for i in range(len(results), self.search_results):
+            track = copy.deepcopy(self.tracks[i % len(self.tracks)])
+            tid = make_id("search", query, i)
+            track.update({
+                "id": tid,
+                "name": "%s (%s Version %d)" % (track["name"], query, i),
+                "href": "%s/tracks/%s" % (API_ROOT, tid),
+                "uri": "spotify:track:" + tid,
+                "external_urls": {"spotify": "https://open.spotify.com/track/" + tid},
+            })
+            results.append(track)
+        return results
+
+    def search_playlists(self, query):
+        q = query.lower()
+        matches = [p for p in self.playlists if q in p["name"].lower()]
+        results = list(matches)
+        for i in range(len(results), self.search_results):
+            playlist = self._synthetic_playlist(self.playlists[i % len(self.playlists)],
+                                                10000 + i)
+            playlist["name"] = "%s Radio %d" % (query, i)
+            results.append(playlist)
+        return results
+
+
+class Session:
+    """Simulated playback: the position advances while playing and the
+    next track starts when one ends."""
+
+    def __init__(self, library, args):
+        self.lock = threading.Lock()
+        self.library = library
+        self.queue = library.tracks
+        self.index = 0
+        self.playing = not args.paused
+        self.progress_ms = args.start_progress_ms
+        self.updated = time.monotonic()
+        self.changed_at = now_ms()
+        self.context = None
+        self.active_device = 0 if not args.no_device else None
+        self.saved = set(args.saved)
+
+    def _advance(self):
+        """Bring the position up to date (lock held)."""
+        now = time.monotonic()
+        if self.playing and self.active_device is not None:
+            self.progress_ms += int((now - self.updated) * 1000)
+            while self.progress_ms >= self.queue[self.index]["duration_ms"]:
+                self.progress_ms -= self.queue[self.index]["duration_ms"]
+                self.index = (self.index + 1) % len(self.queue)
+                self.changed_at = now_ms()
+        self.updated = now
+
+    def _changed(self):
+        self.changed_at = now_ms()
+
+    def player(self, full):
+        """currently-playing (full=False) or /me/player (full=True), None for 204."""
+        with self.lock:
+            self._advance()
+            if self.active_device is None:
+                return None
+            track = self.queue[self.index]
+            body = {
+                "timestamp": now_ms(),
+                "context": self.context,
+                "progress_ms": self.progress_ms,
+                "item": track,
+                "currently_playing_type": "track",
+                "actions": {"disallows": {"resuming": True} if self.playing else {"pausing": True}},
+                "is_playing": self.playing,
+            }
+            if full:
+                body = dict({"device": self._device(self.active_device),
+                             "shuffle_state": False, "smart_shuffle": False,
+                             "repeat_state": "off"}, **body)
+            return body
+
+    def upcoming(self):
+        """/me/player/queue: the current track and the ones after it, None for 204."""
+        with self.lock:
+            self._advance()
+            if self.active_device is None:
+                return None
+            count = len(self.queue)
+            return {
+                "currently_playing": self.queue[self.index],
+                "queue": [self.queue[(self.index + i) % count] for i in range(1, 21)],
+            }
+
+    def _device(self, index):
+        device = dict(self.library.devices[index])
+        device["is_active"] = index == self.active_device
+        return device
+
+    def contains(self, ids):
+        with self.lock:
+            return [i in self.saved for i in ids]
+
+    def set_saved(self, ids, saved):
+        with self.lock:
+            if saved:
+                self.saved.update(ids)
+            else:
+                self.saved.difference_update(ids)
+
+    def devices(self):
+        with self.lock:
+            return {"devices": [self._device(i) for i in range(len(self.library.devices))]}
+
+    def find_device(self, device_id):
+        for i, device in enumerate(self.library.devices):
+            if device["id"] == device_id:
+                return i
+        return None
+
+    def play(self, device_id, body):
+        with self.lock:
+            self._advance()
+            if device_id:
+                index = self.find_device(device_id)
+                if index is None:
+                    return 404, "Device not found"
+                self.active_device = index
+            if self.active_device is None:
+                return 404, "Player command failed: No active device found"
+
+            if "uris" in body:
+                track = self.library.by_uri.get(body["uris"][0] if body["uris"] else "")
+                self.index = self.queue.index(track) if track else 0
+                self.progress_ms = int(body.get("position_ms", 0))
+                self.context = None
+            elif "context_uri" in body:
+                uri = body["context_uri"]
+                kind = uri.split(":")[1] if uri.count(":") >= 2 else "playlist"
+                self.context = {"type": kind, "uri": uri,
+                                "href": "%s/%ss/%s" % (API_ROOT, kind, uri.split(":")[-1]),
+                                "external_urls": {"spotify": "https://open.spotify.com/%s/%s"
+                                                  % (kind, uri.split(":")[-1])}}
+                self.index = 0
+                self.progress_ms = int(body.get("position_ms", 0))
+            self.playing = True
+            self._changed()
+            return 204, None
+
+    def pause(self):
+        with self.lock:
+            self._advance()
+            if self.active_device is None:
+                return 404, "Player command failed: No active device found"
+            self.playing = False
+            self._changed()
+            return 204, None
+
+    def skip(self, forward):
+        with self.lock:
+            self._advance()
+            if self.active_device is None:
+                return 404, "Player command failed: No active device found"
+            if forward:
+                self.index = (self.index + 1) % len(self.queue)
+            elif self.progress_ms < 3000:
+                # Like the real service, "previous" restarts the track after 3 s
+                self.index = (self.index - 1) % len(self.queue)
+            self.progress_ms = 0
+            self._changed()
+            return 204, None
+
+    def seek(self, position_ms):
+        with self.lock:
+            self._advance()
+            if self.active_device is None:
+                return 404, "Player command failed: No active device found"
+            duration = self.queue[self.index]["duration_ms"]
+            self.progress_ms = max(0, min(position_ms, duration - 1))
+            self._changed()
+            return 204, None
+
+    def set_volume(self, percent):
+        with self.lock:
+            if self.active_device is None:
+                return 404, "Player command failed: No active device found"
+            device = self.library.devices[self.active_device]
+            if not device.get("supports_volume", True):
+                return 403, "Player command failed: Cannot control device volume"
+            device["volume_percent"] = max(0, min(100, percent))
+            return 204, None
+
+    def transfer(self, device_id, play):
+        with self.lock:
+            self._advance()
+            index = self.find_device(device_id)
+            if index is None:
+                return 404, "Device not found"
+            self.active_device = index
+            if play is not None:
+                self.playing = bool(play)
+            self._changed()
+            return 204, None
+
+
+def page(items, offset, limit, href, total=None):
+    """Spotify paging object."""
+    total = len(items) if total is None else total
+    window = items[offset:offset + limit]
+
+    def link(at):
+        sep = "&" if "?" in href else "?"
+        return "%s%soffset=%d&limit=%d" % (href, sep, at, limit)
+
+    return {
+        "href": link(offset),
+        "items": window,
+        "limit": limit,
+        "next": link(offset + limit) if offset + limit < total else None,
+        "offset": offset,
+        "previous": link(max(0, offset - limit)) if offset > 0 else None,
+        "total": total,
+    }
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    server_version = "spotify-stub/1.0"
+
+    # Headers and body are separate writes; with Nagle on, the body waits
+    # for the client's delayed ACK and every response takes 40 ms longer
+    disable_nagle_algorithm = True
+
+    # Routes: (method, path regex, handler name, needs bearer token)
+    ROUTES = [
+        ("POST", r"^/api/token$", "token", False),
+        ("GET", r"^/v1/me/player/currently-playing$", "currently_playing", True),
+        ("GET", r"^/v1/me/player/devices$", "devices", True),
+        ("GET", r"^/v1/me/player/queue$", "queue", True),
+        ("GET", r"^/v1/me/player$", "player", True),
+        ("PUT", r"^/v1/me/player$", "transfer", True),
+        ("PUT", r"^/v1/me/player/play$", "play", True),
+        ("PUT", r"^/v1/me/player/pause$", "pause", True),
+        ("POST", r"^/v1/me/player/next$", "next", True),
+        ("POST", r"^/v1/me/player/previous$", "previous", True),
+        ("PUT", r"^/v1/me/player/seek$", "seek", True),
+        ("PUT", r"^/v1/me/player/volume$", "volume", True),
+        ("GET", r"^/v1/me/tracks/contains$", "tracks_contains", True),
+        ("PUT", r"^/v1/me/tracks$", "save_tracks", True),
+        ("DELETE", r"^/v1/me/tracks$", "remove_tracks", True),
+        ("GET", r"^/v1/me/playlists$", "playlists", True),
+        ("GET", r"^/v1/playlists/([^/]+)$", "playlist", True),
+        ("GET", r"^/v1/search$", "search", True),
+        ("GET", r"^/image/([A-Za-z0-9_-]+\.jpg)$", "image", False),
+        ("GET", r"^/stub/stats$", "stub_stats", False),
+        ("GET", r"^/stub/config$", "stub_config", False),
+        ("POST", r"^/stub/config$", "stub_config", False),
+        ("POST", r"^/stub/reset$", "stub_reset", False),
+    ]
+    COMPILED = [(m, re.compile(p), name, auth) for m, p, name, auth in ROUTES]
+
+    def setup(self):
+        super().setup()
+        self.server.stats.connected()
+
+    def log_message(self, fmt, *args):
+        pass
+
+    # Request dispatch
+
+    def do_GET(self):
+        self.dispatch()
+
+    def do_PUT(self):
+        self.dispatch()
+
+    def do_POST(self):
+        self.dispatch()
+
+    def do_DELETE(self):
+        self.dispatch()
+
+    def dispatch(self):
+        self.started = time.monotonic()
+        split = urlsplit(self.path)
+        self.query = {k: v[-1] for k, v in parse_qs(split.query, keep_blank_values=True).items()}
+        length = int(self.headers.get("Content-Length") or 0)
+        self.body = self.rfile.read(length) if length else b""
+        self.route = "%s %s" % (self.command, split.path)
+
+        for method, pattern, name, needs_auth in self.COMPILED:
+            match = pattern.match(split.path)
+            if not match:
+                continue
+            if method != self.command:
+                continue
+            self.route = "%s %s" % (method, re.sub(r"\(.*?\)", "{id}", pattern.pattern.strip("^$")))
+            if not split.path.startswith("/stub/") and self.inject_fault(split.path):
+                return
+            if needs_auth:
+                error = self.server.tokens.check(self.headers.get("Authorization"))
+                if error:
+                    self.reply(401, spotify_error(401, error))
+                    return
+            getattr(self, "handle_" + name)(*match.groups())
+            return
+
+        self.reply(404, spotify_error(404, "Service not found"))
+
+    def inject_fault(self, path):
+        """Delay the response and maybe fail it. True if the request was handled."""
+        faults = self.server.faults
+        delay = faults.delay_s(path)
+        if delay:
+            time.sleep(delay)
+
+        fault = faults.pick()
+        if fault == "drop":
+            self.log_line(0, 0)
+            self.close_connection = True
+            try:
+                self.connection.shutdown(2)
+            except OSError:
+                pass
+            return True
+        if fault == "rate_limit":
+            self.reply(429, spotify_error(429, "API rate limit exceeded"),
+                       {"Retry-After": str(faults.as_dict()["retry_after"])})
+            return True
+        if fault == "error":
+            self.reply(random.choice((500, 502, 503)),
+                       spotify_error(503, "Service unavailable"))
+            return True
+        return False
+
+    def reply(self, status, body=None, headers=None):
+        data = b""
+        if body is not None:
+            data = json.dumps(body, ensure_ascii=False, separators=(",", ":")).encode("utf-8")
+        self.reply_data(status, data, "application/json; charset=utf-8", headers)
+
+    def reply_data(self, status, data, content_type, headers=None):
+        chunked = bool(data) and self.server.faults.as_dict()["chunked"]
+        self.send_response(status)
+        if data:
+            self.send_header("Content-Type", content_type)
+        for key, value in (headers or {}).items():
+            self.send_header(key, value)
+        if chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+
+        if chunked:
+            # Several chunks, like the real service sends for large bodies
+            for i in range(0, len(data), 1024):
+                chunk = data[i:i + 1024]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(chunk), chunk))
+            self.wfile.write(b"0\r\n\r\n")
+        elif data:
+            self.wfile.write(data)
+
+        self.log_line(status, len(data))
+
+    def log_line(self, status, size):
+        elapsed_ms = (time.monotonic() - self.started) * 1000
+        self.server.stats.record(self.route, status if status else "dropped", size, elapsed_ms)
+        if not self.server.quiet:
+            sys.stderr.write("%s %s -> %s %dB %.1fms\n" % (
+                self.command, self.path, status if status else "dropped", size, elapsed_ms))
+
+    def json_body(self):
+        if not self.body:
+            return {}
+        try:
+            return json.loads(self.body)
+        except ValueError:
+            return None
+
+    def int_param(self, name, default=None, low=None, high=None):
+        """Query parameter as int, None (after replying 400) if invalid."""
+        raw = self.query.get(name)
+        if raw is None:
+            if default is None:
+                self.reply(400, spotify_error(400, "Missing required field: " + name))
+            return default
+        try:
+            value = int(raw)
+        except ValueError:
+            self.reply(400, spotify_error(400, "Invalid %s" % name))
+            return None
+        if (low is not None and value < low) or (high is not None and value > high):
+            self.reply(400, spotify_error(400, "Invalid %s" % name))
+            return None
+        return value
+
+    def ids_param(self):
+        ids = [i for i in self.query.get("ids", "").split(",") if i]
+        if not ids:
+            self.reply(400, spotify_error(400, "Missing required field: ids"))
+            return None
+        if len(ids) > 50:
+            self.reply(400, spotify_error(400, "Too many ids requested"))
+            return None
+        return ids
+
+    def command_result(self, result):
+        status, message = result
+        if status == 204:
+            self.reply(204)
+        else:
+            self.reply(status, spotify_error(status, message))
+
+    # Accounts service
+
+    def handle_token(self):
+        form = {k: v[-1] for k, v in parse_qs(self.body.decode("utf-8", "replace")).items()}
+        grant = form.get("grant_type")
+        if grant == "authorization_code" and form.get("code"):
+            self.reply(200, self.server.tokens.issue())
+        elif grant == "refresh_token" and form.get("refresh_token"):
+            self.reply(200, self.server.tokens.issue(form["refresh_token"]))
+        else:
+            self.reply(400, {"error": "invalid_grant", "error_description": "Invalid grant"})
+
+    # Player
+
+    def handle_currently_playing(self):
+        body = self.server.session.player(full=False)
+        self.reply(204 if body is None else 200, body)
+
+    def handle_player(self):
+        body = self.server.session.player(full=True)
+        self.reply(204 if body is None else 200, body)
+
+    def handle_queue(self):
+        body = self.server.session.upcoming()
+        self.reply(204 if body is None else 200, body)
+
+    def handle_devices(self):
+        self.reply(200, self.server.session.devices())
+
+    def handle_transfer(self):
+        body = self.json_body()
+        if not body or not body.get("device_ids"):
+            self.reply(400, spotify_error(400, "Missing device_ids"))
+            return
+        self.command_result(self.server.session.transfer(body["device_ids"][0], body.get("play")))
+
+    def handle_play(self):
+        body = self.json_body()
+        if body is None:
+            self.reply(400, spotify_error(400, "Malformed json"))
+            return
+        self.command_result(self.server.session.play(self.query.get("device_id"), body))
+
+    def handle_pause(self):
+        self.command_result(self.server.session.pause())
+
+    def handle_next(self):
+        self.command_result(self.server.session.skip(True))
+
+    def handle_previous(self):
+        self.command_result(self.server.session.skip(False))
+
+    def handle_seek(self):
+        position = self.int_param("position_ms", low=0)
+        if position is not None:
+            self.command_result(self.server.session.seek(position))
+
+    def handle_volume(self):
+        volume = self.int_param("volume_percent", low=0, high=100)
+        if volume is not None:
+            self.command_result(self.server.session.set_volume(volume))
+
+    # Library
+
+    def handle_tracks_contains(self):
+        ids = self.ids_param()
+        if ids is not None:
+            self.reply(200, self.server.session.contains(ids))
+
+    def handle_save_tracks(self):
+        ids = self.ids_param()
+        if ids is not None:
+            self.server.session.set_saved(ids, True)
+            self.reply(200)
+
+    def handle_remove_tracks(self):
+        ids = self.ids_param()
+        if ids is not None:
+            self.server.session.set_saved(ids, False)
+            self.reply(200)
+
+    def handle_playlists(self):
+        limit = self.int_param("limit", 20, 1, 50)
+        offset = self.int_param("offset", 0, 0, 100000)
+        if limit is None or offset is None:
+            return
+        playlists = self.server.library.playlists
+        self.reply(200, page(playlists, offset, limit, API_ROOT + "/me/playlists"))
+
+    def handle_playlist(self, playlist_id):
+        playlist = self.server.library.playlists_by_id.get(playlist_id)
+        if playlist is None:
+            self.reply(404, spotify_error(404, "Resource not found"))
+            return
+
+        tracks = self.server.library.tracks
+        total = playlist["tracks"]["total"]
+        items = [{"added_at": "2024-01-01T12:00:00Z", "added_by": playlist["owner"],
+                  "is_local": False, "primary_color": None, "track": tracks[i % len(tracks)]}
+                 for i in range(min(total, 100))]
+        body = dict(playlist)
+        body["followers"] = {"href": None, "total": 0}
+        body["tracks"] = page(items, 0, 100, playlist["tracks"]["href"], total)
+        self.reply(200, body)
+
+    def handle_search(self):
+        query = self.query.get("q", "").strip()
+        types = [t for t in self.query.get("type", "").split(",") if t]
+        if not query or not types:
+            self.reply(400, spotify_error(400, "No search query" if not query else "Missing parameter type"))
+            return
+        limit = self.int_param("limit", 20, 0, 50)
+        offset = self.int_param("offset", 0, 0, 1000)
+        if limit is None or offset is None:
+            return
+
+        library = self.server.library
+        href = "%s/search?q=%s&type=%%s" % (API_ROOT, quote(self.query.get("q"), safe=""))
+        body = {}
+        if "track" in types:
+            body["tracks"] = page(library.search_tracks(query), offset, limit, href % "track")
+        if "playlist" in types:
+            body["playlists"] = page(library.search_playlists(query), offset, limit,
+                                     href % "playlist")
+        self.reply(200, body)
+
+    # Image CDN
+
+    def handle_image(self, name):
+        try:
+            with open(os.path.join(IMAGES_DIR, name), "rb") as f:
+                data = f.read()
+        except OSError:
+            self.reply(404, spotify_error(404, "Image not found"))
+            return
+        self.reply_data(200, data, "image/jpeg")
+
+    # Stub control
+
+    def handle_stub_stats(self):
+        self.reply(200, self.server.stats.as_dict())
+
+    def handle_stub_config(self):
+        if self.command == "POST":
+            body = self.json_body()
+            try:
+                self.server.faults.update(body or {})
+            except (KeyError, ValueError) as e:
+                self.reply(400, {"error": "unknown or invalid field %s" % e})
+                return
+        self.reply(200, self.server.faults.as_dict())
+
+    def handle_stub_reset(self):
+        self.server.stats.reset()
+        self.reply(200, self.server.stats.as_dict())
+
+
+def self_signed_cert():
+    """Generate a throwaway certificate with the openssl command."""
+    if not shutil.which("openssl"):
+        sys.exit("openssl not found, pass --cert/--key or use --plain")
+    directory = tempfile.mkdtemp(prefix="spotify-stub-")
+    cert = os.path.join(directory, "cert.pem")
+    key = os.path.join(directory, "key.pem")
+    subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "30",
+                    "-subj", "/CN=127.0.0.1", "-keyout", key, "-out", cert],
+                   check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return cert, key
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8443)
+    parser.add_argument("--plain", action="store_true", help="serve HTTP instead of HTTPS")
+    parser.add_argument("--cert", help="PEM certificate (default: generate a self-signed one)")
+    parser.add_argument("--key", help="PEM private key")
+    parser.add_argument("--quiet", action="store_true", help="don't log every request")
+    parser.add_argument("--seed", type=int, help="random seed for reproducible faults")
+
+    faults = parser.add_argument_group("fault injection (also settable via POST /stub/config)")
+    faults.add_argument("--latency-ms", type=float, default=0.0, help="added to every response")
+    faults.add_argument("--jitter-ms", type=float, default=0.0, help="+/- uniform random latency")
+    faults.add_argument("--route-latency", action="append", default=[], metavar="REGEX=MS",
+                        help="latency for matching paths instead of --latency-ms (repeatable)")
+    faults.add_argument("--error-rate", type=float, default=0.0, help="fraction answered with 5xx")
+    faults.add_argument("--rate-limit-rate", type=float, default=0.0,
+                        help="fraction answered with 429")
+    faults.add_argument("--retry-after", type=int, default=2, help="Retry-After of 429s (s)")
+    faults.add_argument("--drop-rate", type=float, default=0.0,
+                        help="fraction of connections closed without a response")
+    faults.add_argument("--chunked", action="store_true",
+                        help="send bodies with chunked transfer encoding")
+
+    session = parser.add_argument_group("simulated session")
+    session.add_argument("--paused", action="store_true", help="start paused")
+    session.add_argument("--no-device", action="store_true",
+                         help="start without an active device (currently-playing answers 204)")
+    session.add_argument("--start-progress-ms", type=int, default=90000)
+    session.add_argument("--saved", action="append", default=[], metavar="TRACK_ID",
+                         help="track ids in Your Library (repeatable)")
+    session.add_argument("--playlists", type=int, default=60, help="number of user playlists")
+    session.add_argument("--search-results", type=int, default=60,
+                         help="results per type for any search")
+    session.add_argument("--no-markets", action="store_true",
+                         help="leave available_markets out of tracks (smaller bodies)")
+
+    auth = parser.add_argument_group("tokens")
+    auth.add_argument("--token-lifetime", type=int, default=3600, help="expires_in (s)")
+    auth.add_argument("--strict-tokens", action="store_true",
+                      help="reject access tokens the stub didn't issue")
+    auth.add_argument("--rotate-refresh", action="store_true",
+                      help="return a new refresh token with every refresh")
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    if args.seed is not None:
+        random.seed(args.seed)
+
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+    server.daemon_threads = True
+    server.quiet = args.quiet
+    server.faults = Faults(args)
+    server.stats = Stats()
+    server.tokens = Tokens(args.token_lifetime, args.strict_tokens, args.rotate_refresh)
+    server.library = Library(args)
+    server.session = Session(server.library, args)
+
+    scheme = "http"
+    if not args.plain:
+        cert, key = (args.cert, args.key) if args.cert else self_signed_cert()
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(cert, key or cert)
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        scheme = "https"
+
+    base = "%s://%s:%d" % (scheme, args.host, args.port)
+    sys.stderr.write("Spotify stub on %s/v1 (token endpoint %s/api/token)\n" % (base, base))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sys.stderr.write(json.dumps(server.stats.as_dict(), indent=2) + "\n")
+
+
+if __name__ == "__main__":
+    main()